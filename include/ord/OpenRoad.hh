@@ -234,10 +234,13 @@ class OpenRoad
   // to notify the tools (eg dbSta, gui).
   void designCreated();
 
-  void readDb(std::istream& stream);
-  void readDb(const char* filename);
-  void writeDb(std::ostream& stream);
-  void writeDb(const char* filename);
+  void readDb(std::istream& stream, bool lazy = false);
+  void readDb(const char* filename, bool lazy = false);
+  void writeDb(std::ostream& stream, bool compress = false);
+  void writeDb(const char* filename, bool compress = false);
+  // Writes only the edits since the previous checkpoint, or the full
+  // database if checkpointing has not started yet.
+  void writeCheckpoint(const char* filename, bool compress = false);
 
   void diffDbs(const char* filename1, const char* filename2, const char* diffs);
 
@@ -437,19 +437,30 @@ void OpenRoad::writeCdl(const char* outFilename,
   }
 }
 
-void OpenRoad::readDb(const char* filename)
+void OpenRoad::readDb(const char* filename, bool lazy)
 {
   std::ifstream stream;
   stream.open(filename, std::ios::binary);
   try {
-    readDb(stream);
+    readDb(stream, lazy);
   } catch (const std::ios_base::failure& f) {
     logger_->error(ORD, 54, "odb file {} is invalid: {}", filename, f.what());
   }
 }
 
-void OpenRoad::readDb(std::istream& stream)
+void OpenRoad::readDb(std::istream& stream, bool lazy)
 {
+  if (odb::dbDatabase::isCheckpoint(stream)) {
+    if (!db_->getChip() || !db_->getChip()->getBlock()) {
+      logger_->error(
+          ORD, 106, "A checkpoint can only be read after its database.");
+    }
+    stream.exceptions(std::ifstream::failbit | std::ifstream::badbit
+                      | std::ios::eofbit);
+    odb::dbDatabase::readCheckpoint(db_->getChip()->getBlock(), stream);
+    return;
+  }
+
   if (db_->getChip() && db_->getChip()->getBlock()) {
     logger_->error(
         ORD, 47, "You can't load a new db file as the db is already populated");
@@ -458,6 +469,7 @@ void OpenRoad::readDb(std::istream& stream)
   stream.exceptions(std::ifstream::failbit | std::ifstream::badbit
                     | std::ios::eofbit);
 
+  db_->setLazyLoading(lazy);
   db_->read(stream);
 
   for (OpenRoadObserver* observer : observers_) {
@@ -465,17 +477,46 @@ void OpenRoad::readDb(std::istream& stream)
   }
 }
 
-void OpenRoad::writeDb(std::ostream& stream)
+void OpenRoad::writeDb(std::ostream& stream, bool compress)
 {
   stream.exceptions(std::ofstream::failbit | std::ofstream::badbit);
-  db_->write(stream);
+  db_->write(stream, compress);
 }
 
-void OpenRoad::writeDb(const char* filename)
+void OpenRoad::writeDb(const char* filename, bool compress)
 {
   utl::StreamHandler stream_handler(filename, true);
 
-  db_->write(stream_handler.getStream());
+  db_->write(stream_handler.getStream(), compress);
+}
+
+void OpenRoad::writeCheckpoint(const char* filename, bool compress)
+{
+  if (!db_->getChip() || !db_->getChip()->getBlock()) {
+    logger_->error(ORD, 107, "No design is loaded.");
+  }
+  odb::dbBlock* block = db_->getChip()->getBlock();
+
+  if (compress) {
+    logger_->error(ORD, 109, "Incremental checkpoints can not be compressed.");
+  }
+
+  // The journal does not hold wires, pins, rows etc, so after such edits
+  // the checkpoint starts over from a full database.
+  if (odb::dbDatabase::checkpointMissesEdits(block)) {
+    logger_->warn(ORD,
+                  108,
+                  "The design changed in ways a checkpoint can not hold, "
+                  "writing a full database to {}.",
+                  filename);
+  } else if (odb::dbDatabase::inCheckpoint(block)) {
+    utl::StreamHandler stream_handler(filename, true);
+    odb::dbDatabase::writeCheckpoint(block, stream_handler.getStream());
+    return;
+  }
+
+  writeDb(filename, false);
+  odb::dbDatabase::beginCheckpoint(block);
 }
 
 void OpenRoad::diffDbs(const char* filename1,
@@ -581,6 +622,7 @@ void OpenRoad::setThreadCount(int threads, bool printInfo)
 
   // place limits on tools with threads
   sta_->setThreadCount(threads_);
+  db_->setThreadCount(threads_);
 }
 
 void OpenRoad::setThreadCount(const char* threads, bool printInfo)
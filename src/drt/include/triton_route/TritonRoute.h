@@ -37,6 +37,7 @@
 #include <optional>
 #include <queue>
 #include <string>
+#include <unordered_set>
 #include <vector>
 
 #include "odb/geom.h"
@@ -99,6 +100,9 @@ struct ParamStruct
   int minAccessPoints = -1;
   bool saveGuideUpdates = false;
   std::string repairPDNLayerName;
+  std::string pinAccessCacheFile;
+  bool incremental = false;
+  bool radixWavefront = false;
 };
 
 class TritonRoute
@@ -166,6 +170,12 @@ class TritonRoute
   // for debugging and not general usage.
   std::string runDRWorker(const std::string& workerStr, FlexDRViaData* viaData);
   void debugSingleWorker(const std::string& dumpDir, const std::string& drcRpt);
+  // Runs the workers dumped in dumpDir (all of them if workerDirs is empty)
+  // repeat times each and reports the time spent per phase.  Warns if a run
+  // does not reproduce the result of the first one.
+  void benchmarkWorkers(const std::string& dumpDir,
+                        const std::string& workerDirs,
+                        int repeat);
   void updateGlobals(const char* file_name);
   void resetDb(const char* file_name);
   void clearDesign();
@@ -183,12 +193,22 @@ class TritonRoute
   void reportDRC(const std::string& file_name,
                  const std::list<std::unique_ptr<frMarker>>& markers,
                  odb::Rect drcBox = odb::Rect(0, 0, 0, 0));
-  void checkDRC(const char* filename, int x1, int y1, int x2, int y2);
+  void checkDRC(const char* filename,
+                int x1,
+                int y1,
+                int x2,
+                int y2,
+                int tileSize = 7);
   bool initGuide();
   void prep();
   void processBTermsAboveTopLayer(bool has_routing = false);
   odb::dbDatabase* getDb() const { return db_; }
   void fixMaxSpacing();
+  // Changes to the block since the last routing, used by incremental
+  // detailed routing.  Regions are in design coordinates.
+  void addDirtyNet(odb::dbNet* net);
+  void removeDirtyNet(odb::dbNet* net);
+  void addDirtyRegion(const odb::Rect& region);
 
  private:
   std::unique_ptr<frDesign> design_;
@@ -210,14 +230,20 @@ class TritonRoute
   int results_sz_{0};
   unsigned int cloud_sz_{0};
   boost::asio::thread_pool dist_pool_{1};
+  std::unordered_set<odb::dbNet*> dirty_nets_;
+  std::vector<odb::Rect> dirty_regions_;
 
   void initDesign();
+  void initDesignFromDb();
   void gr();
   void ta();
   void dr();
   void applyUpdates(const std::vector<std::vector<drUpdate>>& updates);
+  // Checks the tiles of tileSize x tileSize gcells overlapping
+  // requiredDrcBox in parallel.
   void getDRCMarkers(std::list<std::unique_ptr<frMarker>>& markers,
-                     const odb::Rect& requiredDrcBox);
+                     const odb::Rect& requiredDrcBox,
+                     int tileSize = 7);
   void stackVias(odb::dbBTerm* bterm,
                  int top_layer_idx,
                  int bterm_bottom_layer_idx,
@@ -225,6 +251,7 @@ class TritonRoute
   int countNetBTermsAboveMaxLayer(odb::dbNet* net);
   bool netHasStackedVias(odb::dbNet* net);
   void repairPDNVias();
+  std::vector<odb::Rect> getIncrementalRegions() const;
   friend class FlexDR;
 };
 
@@ -39,8 +39,27 @@ static inline int defdist(odb::dbBlock* block, int x)
          / (double) block->getDbUnitsPerMicron();
 }
 
+void DesignCallBack::addDirtyInst(odb::dbInst* db_inst)
+{
+  for (auto iterm : db_inst->getITerms()) {
+    router_->addDirtyNet(iterm->getNet());
+  }
+  auto block = db_inst->getBlock();
+  const odb::Rect box = db_inst->getBBox()->getBox();
+  router_->addDirtyRegion(odb::Rect(defdist(block, box.xMin()),
+                                    defdist(block, box.yMin()),
+                                    defdist(block, box.xMax()),
+                                    defdist(block, box.yMax())));
+}
+
+void DesignCallBack::inDbPreMoveInst(odb::dbInst* db_inst)
+{
+  addDirtyInst(db_inst);
+}
+
 void DesignCallBack::inDbPostMoveInst(odb::dbInst* db_inst)
 {
+  addDirtyInst(db_inst);
   auto design = router_->getDesign();
   if (design != nullptr && design->getTopBlock() != nullptr) {
     auto inst = design->getTopBlock()->getInst(db_inst->getName());
@@ -63,7 +82,7 @@ void DesignCallBack::inDbPostMoveInst(odb::dbInst* db_inst)
   }
 }
 
-void DesignCallBack::inDbInstDestroy(odb::dbInst* db_inst)
+void DesignCallBack::removeInst(odb::dbInst* db_inst)
 {
   auto design = router_->getDesign();
   if (design != nullptr && design->getTopBlock() != nullptr) {
@@ -78,4 +97,58 @@ void DesignCallBack::inDbInstDestroy(odb::dbInst* db_inst)
   }
 }
 
+void DesignCallBack::inDbInstDestroy(odb::dbInst* db_inst)
+{
+  addDirtyInst(db_inst);
+  removeInst(db_inst);
+}
+
+void DesignCallBack::inDbInstSwapMasterBefore(odb::dbInst* db_inst,
+                                              odb::dbMaster* master)
+{
+  addDirtyInst(db_inst);
+}
+
+void DesignCallBack::inDbInstSwapMasterAfter(odb::dbInst* db_inst)
+{
+  addDirtyInst(db_inst);
+  // updateDesign creates the instance again with its new master.
+  removeInst(db_inst);
+}
+
+void DesignCallBack::inDbNetDestroy(odb::dbNet* db_net)
+{
+  router_->removeDirtyNet(db_net);
+}
+
+void DesignCallBack::inDbITermPreDisconnect(odb::dbITerm* iterm)
+{
+  router_->addDirtyNet(iterm->getNet());
+}
+
+void DesignCallBack::inDbITermPostConnect(odb::dbITerm* iterm)
+{
+  router_->addDirtyNet(iterm->getNet());
+}
+
+void DesignCallBack::inDbBTermPreDisconnect(odb::dbBTerm* bterm)
+{
+  router_->addDirtyNet(bterm->getNet());
+}
+
+void DesignCallBack::inDbBTermPostConnect(odb::dbBTerm* bterm)
+{
+  router_->addDirtyNet(bterm->getNet());
+}
+
+void DesignCallBack::inDbWirePostModify(odb::dbWire* wire)
+{
+  router_->addDirtyNet(wire->getNet());
+}
+
+void DesignCallBack::inDbWireDestroy(odb::dbWire* wire)
+{
+  router_->addDirtyNet(wire->getNet());
+}
+
 }  // namespace drt
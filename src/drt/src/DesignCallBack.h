@@ -36,10 +36,25 @@ class DesignCallBack : public odb::dbBlockCallBackObj
 {
  public:
   DesignCallBack(TritonRoute* router) : router_(router) {}
+  void inDbPreMoveInst(odb::dbInst* inst) override;
   void inDbPostMoveInst(odb::dbInst* inst) override;
   void inDbInstDestroy(odb::dbInst* inst) override;
+  void inDbInstSwapMasterBefore(odb::dbInst* inst,
+                                odb::dbMaster* master) override;
+  void inDbInstSwapMasterAfter(odb::dbInst* inst) override;
+  void inDbNetDestroy(odb::dbNet* net) override;
+  void inDbITermPreDisconnect(odb::dbITerm* iterm) override;
+  void inDbITermPostConnect(odb::dbITerm* iterm) override;
+  void inDbBTermPreDisconnect(odb::dbBTerm* bterm) override;
+  void inDbBTermPostConnect(odb::dbBTerm* bterm) override;
+  void inDbWirePostModify(odb::dbWire* wire) override;
+  void inDbWireDestroy(odb::dbWire* wire) override;
 
  private:
+  // Records the nets and area of the instance for incremental routing.
+  void addDirtyInst(odb::dbInst* inst);
+  void removeInst(odb::dbInst* inst);
+
   TritonRoute* router_;
 };
 }  // namespace drt
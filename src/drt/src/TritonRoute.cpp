@@ -30,8 +30,13 @@
 
 #include <boost/asio/post.hpp>
 #include <boost/bind/bind.hpp>
+#include <algorithm>
+#include <boost/functional/hash.hpp>
+#include <chrono>
+#include <filesystem>
 #include <fstream>
 #include <iostream>
+#include <sstream>
 
 #include "DesignCallBack.h"
 #include "db/tech/frTechObject.h"
@@ -58,6 +63,7 @@
 #include "sta/StaMain.hh"
 #include "stt/SteinerTreeBuilder.h"
 #include "ta/FlexTA.h"
+#include "utl/exception.h"
 
 namespace sta {
 // Tcl files encoded into strings.
@@ -307,10 +313,140 @@ void TritonRoute::updateGlobals(const char* file_name)
   file.close();
 }
 
+void TritonRoute::benchmarkWorkers(const std::string& dumpDir,
+                                   const std::string& workerDirs,
+                                   int repeat)
+{
+  std::vector<std::string> dirs;
+  if (workerDirs.empty()) {
+    for (const auto& entry : std::filesystem::directory_iterator(dumpDir)) {
+      if (std::filesystem::exists(entry.path() / "worker.bin")) {
+        dirs.push_back(entry.path().filename().string());
+      }
+    }
+    std::sort(dirs.begin(), dirs.end());
+  } else {
+    std::istringstream names(workerDirs);
+    std::string name;
+    while (names >> name) {
+      dirs.push_back(name);
+    }
+  }
+  if (dirs.empty()) {
+    logger_->error(DRT, 623, "No dumped workers found in {}.", dumpDir);
+  }
+
+  updateGlobals(fmt::format("{}/init_globals.bin", dumpDir).c_str());
+  if (db_->getChip() == nullptr || db_->getChip()->getBlock() == nullptr) {
+    ord::OpenRoad::openRoad()->readDb(
+        fmt::format("{}/design.odb", dumpDir).c_str());
+  }
+
+  using Clock = std::chrono::steady_clock;
+  double totalInit = 0;
+  double totalMaze = 0;
+  double totalGC = 0;
+  double totalEnd = 0;
+  int numMismatches = 0;
+  logger_->report("{:<24} {:>9} {:>9} {:>9} {:>9} {:>7}",
+                  "Worker",
+                  "Init(s)",
+                  "Maze(s)",
+                  "GC(s)",
+                  "End(s)",
+                  "Markers");
+  for (const auto& dir : dirs) {
+    const std::string workerDir = fmt::format("{}/{}", dumpDir, dir);
+    std::ifstream workerFile(fmt::format("{}/worker.bin", workerDir),
+                             std::ios::binary);
+    if (!workerFile.good()) {
+      logger_->error(DRT, 624, "Cannot read worker from {}.", workerDir);
+    }
+    const std::string workerStr((std::istreambuf_iterator<char>(workerFile)),
+                                std::istreambuf_iterator<char>());
+    workerFile.close();
+
+    double initTime = 0;
+    double mazeTime = 0;
+    double gcTime = 0;
+    double endTime = 0;
+    int numMarkers = 0;
+    std::size_t firstSignature = 0;
+    for (int run = 0; run < repeat; ++run) {
+      // end() writes back into the design so it is rebuilt for every run.
+      updateGlobals(fmt::format("{}/init_globals.bin", dumpDir).c_str());
+      clearDesign();
+      initDesignFromDb();
+      updateDesign(fmt::format("{}/updates.bin", workerDir));
+      updateGlobals(fmt::format("{}/worker_globals.bin", workerDir).c_str());
+
+      FlexDRViaData viaData;
+      std::ifstream viaDataFile(fmt::format("{}/viadata.bin", workerDir),
+                                std::ios::binary);
+      frIArchive ar(viaDataFile);
+      ar >> viaData;
+
+      auto worker
+          = FlexDRWorker::load(workerStr, logger_, design_.get(), nullptr);
+      worker->setDebugSettings(debug_.get());
+      worker->setViaData(&viaData);
+      const std::string result = worker->reloadedMain();
+      const auto endStart = Clock::now();
+      worker->end(design_.get());
+      endTime += std::chrono::duration<double>(Clock::now() - endStart).count();
+      initTime += worker->getInitTime();
+      mazeTime += worker->getRouteTime() - worker->getGCTime();
+      gcTime += worker->getGCTime();
+      numMarkers = worker->getBestNumMarkers();
+
+      std::size_t signature = std::hash<std::string>{}(result);
+      boost::hash_combine(signature, numMarkers);
+      if (run == 0) {
+        firstSignature = signature;
+      } else if (signature != firstSignature) {
+        logger_->warn(DRT,
+                      625,
+                      "Run {} of worker {} differs from the first run.",
+                      run + 1,
+                      dir);
+        ++numMismatches;
+      }
+    }
+    logger_->report("{:<24} {:>9.4f} {:>9.4f} {:>9.4f} {:>9.4f} {:>7}",
+                    dir,
+                    initTime / repeat,
+                    mazeTime / repeat,
+                    gcTime / repeat,
+                    endTime / repeat,
+                    numMarkers);
+    totalInit += initTime / repeat;
+    totalMaze += mazeTime / repeat;
+    totalGC += gcTime / repeat;
+    totalEnd += endTime / repeat;
+  }
+  logger_->report("{:<24} {:>9.4f} {:>9.4f} {:>9.4f} {:>9.4f}",
+                  "Total",
+                  totalInit,
+                  totalMaze,
+                  totalGC,
+                  totalEnd);
+  if (numMismatches > 0) {
+    logger_->warn(DRT,
+                  626,
+                  "{} worker runs were not deterministic.",
+                  numMismatches);
+  }
+}
+
 void TritonRoute::resetDb(const char* file_name)
 {
   design_ = std::make_unique<frDesign>(logger_);
   ord::OpenRoad::openRoad()->readDb(file_name);
+  initDesignFromDb();
+}
+
+void TritonRoute::initDesignFromDb()
+{
   initDesign();
   if (!db_->getChip()->getBlock()->getAccessPoints().empty()) {
     initGuide();
@@ -558,7 +694,8 @@ void TritonRoute::initDesign()
   }
   io::Parser parser(db_, getDesign(), logger_);
   if (getDesign()->getTopBlock() != nullptr) {
-    parser.updateDesign();
+    parser.updateDesign(INCREMENTAL_DR ? dirty_nets_
+                                       : std::unordered_set<odb::dbNet*>());
     return;
   }
   parser.readTechAndLibs(db_);
@@ -630,6 +767,9 @@ void TritonRoute::dr()
   if (distributed_) {
     dr_->setDistributed(dist_, dist_ip_, dist_port_, shared_volume_);
   }
+  if (INCREMENTAL_DR) {
+    dr_->setIncrementalRegions(getIncrementalRegions());
+  }
   if (SINGLE_STEP_DR) {
     dr_->init();
   } else {
@@ -673,9 +813,66 @@ void TritonRoute::endFR()
 
   num_drvs_ = design_->getTopBlock()->getNumMarkers();
 
+  // the routing written above is the new baseline
+  dirty_nets_.clear();
+  dirty_regions_.clear();
+
   repairPDNVias();
 }
 
+void TritonRoute::addDirtyNet(odb::dbNet* net)
+{
+  if (net != nullptr && !net->isSpecial()) {
+    dirty_nets_.insert(net);
+  }
+}
+
+void TritonRoute::removeDirtyNet(odb::dbNet* net)
+{
+  dirty_nets_.erase(net);
+}
+
+void TritonRoute::addDirtyRegion(const odb::Rect& region)
+{
+  dirty_regions_.push_back(region);
+}
+
+// The areas to route in incremental mode: the guides (or pins) of every
+// net without routing, which includes the dirty nets, and the recorded
+// regions such as the old and new locations of moved instances.
+std::vector<odb::Rect> TritonRoute::getIncrementalRegions() const
+{
+  std::vector<odb::Rect> regions = dirty_regions_;
+  int numNets = 0;
+  for (const auto& net : getDesign()->getTopBlock()->getNets()) {
+    if (net->hasInitialRouting()
+        || net->getInstTerms().size() + net->getBTerms().size() < 2) {
+      continue;
+    }
+    numNets++;
+    for (const auto& guide : net->getGuides()) {
+      regions.push_back(guide->getBBox());
+    }
+    if (!net->getGuides().empty()) {
+      continue;
+    }
+    for (auto instTerm : net->getInstTerms()) {
+      regions.push_back(instTerm->getBBox(true));
+    }
+    for (auto bterm : net->getBTerms()) {
+      regions.push_back(bterm->getBBox());
+    }
+  }
+  if (VERBOSE > 0) {
+    logger_->info(DRT,
+                  622,
+                  "Incremental routing of {} nets in {} regions.",
+                  numNets,
+                  regions.size());
+  }
+  return regions;
+}
+
 void TritonRoute::repairPDNVias()
 {
   if (REPAIR_PDN_LAYER_NAME.empty()) {
@@ -1052,72 +1249,95 @@ void TritonRoute::fixMaxSpacing()
 }
 
 void TritonRoute::getDRCMarkers(frList<std::unique_ptr<frMarker>>& markers,
-                                const Rect& requiredDrcBox)
+                                const Rect& requiredDrcBox,
+                                int tileSize)
 {
   MAX_THREADS = ord::OpenRoad::openRoad()->getThreadCount();
-  std::vector<std::vector<std::unique_ptr<FlexGCWorker>>> workersBatches(1);
-  auto size = 7;
-  auto offset = 0;
+  // Tiles of tileSize x tileSize gcells.  Each tile is checked by its own
+  // FlexGCWorker that sees the shapes within MTSAFEDIST of the tile and
+  // reports the violations within DRCSAFEDIST of it, so a violation across
+  // a tile boundary is found by both tiles and deduplicated below.
+  std::vector<Rect> routeBoxes;
   auto gCellPatterns = design_->getTopBlock()->getGCellPatterns();
   auto& xgp = gCellPatterns.at(0);
   auto& ygp = gCellPatterns.at(1);
-  for (int i = offset; i < (int) xgp.getCount(); i += size) {
-    for (int j = offset; j < (int) ygp.getCount(); j += size) {
+  for (int i = 0; i < (int) xgp.getCount(); i += tileSize) {
+    for (int j = 0; j < (int) ygp.getCount(); j += tileSize) {
       Rect routeBox1 = design_->getTopBlock()->getGCellBox(Point(i, j));
-      const int max_i = std::min((int) xgp.getCount() - 1, i + size - 1);
-      const int max_j = std::min((int) ygp.getCount(), j + size - 1);
+      const int max_i = std::min((int) xgp.getCount() - 1, i + tileSize - 1);
+      const int max_j = std::min((int) ygp.getCount() - 1, j + tileSize - 1);
       Rect routeBox2 = design_->getTopBlock()->getGCellBox(Point(max_i, max_j));
       Rect routeBox(routeBox1.xMin(),
                     routeBox1.yMin(),
                     routeBox2.xMax(),
                     routeBox2.yMax());
-      Rect extBox;
       Rect drcBox;
       routeBox.bloat(DRCSAFEDIST, drcBox);
-      routeBox.bloat(MTSAFEDIST, extBox);
       if (!drcBox.intersects(requiredDrcBox)) {
         continue;
       }
-      auto gcWorker
-          = std::make_unique<FlexGCWorker>(design_->getTech(), logger_);
-      gcWorker->setDrcBox(drcBox);
-      gcWorker->setExtBox(extBox);
-      if (workersBatches.back().size() >= BATCHSIZE) {
-        workersBatches.emplace_back();
-      }
-      workersBatches.back().push_back(std::move(gcWorker));
+      routeBoxes.push_back(routeBox);
     }
   }
-  std::map<MarkerId, frMarker*> mapMarkers;
+  if (VERBOSE > 1) {
+    logger_->info(DRT, 628, "Checking DRC in {} tiles.", routeBoxes.size());
+  }
+
+  // Workers are created, run and released by the thread that picks up the
+  // tile, so at most MAX_THREADS of them are alive at a time and there is
+  // no barrier between groups of tiles.  The markers of each tile are kept
+  // apart so the merged result does not depend on the scheduling.
+  const int numTiles = routeBoxes.size();
+  std::vector<std::vector<std::unique_ptr<frMarker>>> tileMarkers(numTiles);
+  utl::ThreadException exception;
   omp_set_num_threads(MAX_THREADS);
-  for (auto& workers : workersBatches) {
 #pragma omp parallel for schedule(dynamic)
-    for (int i = 0; i < workers.size(); i++) {  // NOLINT
-      workers[i]->init(design_.get());
-      workers[i]->main();
-    }
-    for (const auto& worker : workers) {
-      for (auto& marker : worker->getMarkers()) {
-        Rect bbox = marker->getBBox();
-        if (!bbox.intersects(requiredDrcBox)) {
-          continue;
-        }
-        auto layerNum = marker->getLayerNum();
-        auto con = marker->getConstraint();
-        if (mapMarkers.find({bbox, layerNum, con, marker->getSrcs()})
-            != mapMarkers.end()) {
-          continue;
+  for (int i = 0; i < numTiles; i++) {  // NOLINT
+    try {
+      Rect drcBox;
+      Rect extBox;
+      routeBoxes[i].bloat(DRCSAFEDIST, drcBox);
+      routeBoxes[i].bloat(MTSAFEDIST, extBox);
+      FlexGCWorker gcWorker(design_->getTech(), logger_);
+      gcWorker.setDrcBox(drcBox);
+      gcWorker.setExtBox(extBox);
+      gcWorker.init(design_.get());
+      gcWorker.main();
+      for (auto& marker : gcWorker.getMarkers()) {
+        if (marker->getBBox().intersects(requiredDrcBox)) {
+          tileMarkers[i].push_back(std::make_unique<frMarker>(*marker));
         }
-        markers.push_back(std::make_unique<frMarker>(*marker));
-        mapMarkers[{bbox, layerNum, con, marker->getSrcs()}]
-            = markers.back().get();
+      }
+    } catch (...) {
+      exception.capture();
+    }
+  }
+  exception.rethrow();
+
+  std::set<MarkerId> seen;
+  for (auto& tile : tileMarkers) {
+    for (auto& marker : tile) {
+      MarkerId id{marker->getBBox(),
+                  marker->getLayerNum(),
+                  marker->getConstraint(),
+                  marker->getSrcs()};
+      if (seen.insert(std::move(id)).second) {
+        markers.push_back(std::move(marker));
       }
     }
-    workers.clear();
+    tile.clear();
+  }
+  if (VERBOSE > 1) {
+    logger_->info(DRT, 629, "Found {} DRC violations.", markers.size());
   }
 }
 
-void TritonRoute::checkDRC(const char* filename, int x1, int y1, int x2, int y2)
+void TritonRoute::checkDRC(const char* filename,
+                           int x1,
+                           int y1,
+                           int x2,
+                           int y2,
+                           int tileSize)
 {
   GC_IGNORE_PDN_LAYER_NUM = -1;
   REPAIR_PDN_LAYER_NUM = -1;
@@ -1136,7 +1356,7 @@ void TritonRoute::checkDRC(const char* filename, int x1, int y1, int x2, int y2)
     requiredDrcBox = design_->getTopBlock()->getBBox();
   }
   frList<std::unique_ptr<frMarker>> markers;
-  getDRCMarkers(markers, requiredDrcBox);
+  getDRCMarkers(markers, requiredDrcBox, tileSize);
   reportDRC(filename, markers, requiredDrcBox);
 }
 
@@ -1327,12 +1547,15 @@ void TritonRoute::setParams(const ParamStruct& params)
   DRC_RPT_ITER_STEP = params.drcReportIterStep;
   CMAP_FILE = params.outputCmapFile;
   GUIDE_REPORT_FILE = params.outputGuideCoverageFile;
+  PA_CACHE_FILE = params.pinAccessCacheFile;
   VERBOSE = params.verbose;
   ENABLE_VIA_GEN = params.enableViaGen;
   DBPROCESSNODE = params.dbProcessNode;
   CLEAN_PATCHES = params.cleanPatches;
   DO_PA = params.doPa;
   SINGLE_STEP_DR = params.singleStepDR;
+  INCREMENTAL_DR = params.incremental;
+  RADIX_WAVEFRONT = params.radixWavefront;
   if (!params.viaInPinBottomLayer.empty()) {
     VIAINPIN_BOTTOMLAYER_NAME = params.viaInPinBottomLayer;
   }
@@ -95,7 +95,10 @@ void detailed_route_cmd(const char* outputMazeFile,
                         int minAccessPoints,
                         bool saveGuideUpdates,
                         const char* repairPDNLayerName,
-                        int drcReportIterStep)
+                        int drcReportIterStep,
+                        const char* pinAccessCacheFile,
+                        bool incremental,
+                        bool radixWavefront)
 {
   auto* router = ord::OpenRoad::openRoad()->getTritonRoute();
   std::optional<int> drcReportIterStepOpt;
@@ -122,7 +125,10 @@ void detailed_route_cmd(const char* outputMazeFile,
                     singleStepDR,
                     minAccessPoints,
                     saveGuideUpdates,
-                    repairPDNLayerName});
+                    repairPDNLayerName,
+                    pinAccessCacheFile,
+                    incremental,
+                    radixWavefront});
   router->main();
   router->setDistributed(false);
 }
@@ -131,7 +137,8 @@ void pin_access_cmd(const char* dbProcessNode,
                     const char* bottomRoutingLayer,
                     const char* topRoutingLayer,
                     int verbose,
-                    int minAccessPoints)
+                    int minAccessPoints,
+                    const char* pinAccessCacheFile)
 {
   auto* router = ord::OpenRoad::openRoad()->getTritonRoute();
   drt::ParamStruct params;
@@ -140,6 +147,7 @@ void pin_access_cmd(const char* dbProcessNode,
   params.topRoutingLayer = topRoutingLayer;
   params.verbose = verbose;
   params.minAccessPoints = minAccessPoints;
+  params.pinAccessCacheFile = pinAccessCacheFile;
   router->setParams(params);
   router->pinAccess();
   router->setDistributed(false);
@@ -212,6 +220,13 @@ run_worker_cmd(const char* dump_dir, const char* worker_dir, const char* drc_rpt
   router->debugSingleWorker(fmt::format("{}/{}", dump_dir, worker_dir), drc_rpt);
 }
 
+void
+benchmark_workers_cmd(const char* dump_dir, const char* worker_dirs, int repeat)
+{
+  auto* router = ord::OpenRoad::openRoad()->getTritonRoute();
+  router->benchmarkWorkers(dump_dir, worker_dirs, repeat);
+}
+
 void detailed_route_step_drt(int size,
                              int offset,
                              int mazeEndIter,
@@ -238,9 +253,14 @@ void step_end()
   router->endFR();
 }
 
-void check_drc_cmd(const char* drc_file, int x1, int y1, int x2, int y2)
+void check_drc_cmd(const char* drc_file,
+                   int x1,
+                   int y1,
+                   int x2,
+                   int y2,
+                   int tile_size)
 {
   auto* router = ord::OpenRoad::openRoad()->getTritonRoute();
-  router->checkDRC(drc_file, x1, y1, x2, y2);
+  router->checkDRC(drc_file, x1, y1, x2, y2, tile_size);
 }
 %} // inline
@@ -60,6 +60,9 @@ sta::define_cmd_args "detailed_route" {
     [-save_guide_updates]
     [-repair_pdn_vias layer]
     [-single_step_dr]
+    [-pin_access_cache filename]
+    [-incremental]
+    [-radix_wavefront]
 }
 
 proc detailed_route { args } {
@@ -68,9 +71,10 @@ proc detailed_route { args } {
       -db_process_node -droute_end_iter -via_in_pin_bottom_layer \
       -via_in_pin_top_layer -or_seed -or_k -bottom_routing_layer \
       -top_routing_layer -verbose -remote_host -remote_port -shared_volume \
-      -cloud_size -min_access_points -repair_pdn_vias -drc_report_iter_step} \
+      -cloud_size -min_access_points -repair_pdn_vias -drc_report_iter_step \
+      -pin_access_cache} \
     flags {-disable_via_gen -distributed -clean_patches -no_pin_access \
-           -single_step_dr -save_guide_updates}
+           -single_step_dr -save_guide_updates -incremental -radix_wavefront}
   sta::check_argc_eq0 "detailed_route" $args
 
   set enable_via_gen [expr ![info exists flags(-disable_via_gen)]]
@@ -80,6 +84,8 @@ proc detailed_route { args } {
   # development.  It is not listed in the help string intentionally.
   set single_step_dr [expr [info exists flags(-single_step_dr)]]
   set save_guide_updates [expr [info exists flags(-save_guide_updates)]]
+  set incremental [expr [info exists flags(-incremental)]]
+  set radix_wavefront [expr [info exists flags(-radix_wavefront)]]
 
   if { [info exists keys(-repair_pdn_vias)] } {
     set repair_pdn_vias $keys(-repair_pdn_vias)
@@ -192,12 +198,18 @@ proc detailed_route { args } {
   } else {
     set min_access_points -1
   }
+  if { [info exists keys(-pin_access_cache)] } {
+    set pin_access_cache $keys(-pin_access_cache)
+  } else {
+    set pin_access_cache ""
+  }
   drt::detailed_route_cmd $output_maze $output_drc $output_cmap \
     $output_guide_coverage $db_process_node $enable_via_gen $droute_end_iter \
     $via_in_pin_bottom_layer $via_in_pin_top_layer \
     $or_seed $or_k $bottom_routing_layer $top_routing_layer $verbose \
     $clean_patches $no_pin_access $single_step_dr $min_access_points \
-    $save_guide_updates $repair_pdn_vias $drc_report_iter_step
+    $save_guide_updates $repair_pdn_vias $drc_report_iter_step \
+    $pin_access_cache $incremental $radix_wavefront
 }
 
 proc detailed_route_num_drvs { args } {
@@ -298,11 +310,13 @@ sta::define_cmd_args "pin_access" {
     [-remote_port rport]
     [-shared_volume vol]
     [-cloud_size sz]
+    [-pin_access_cache filename]
 }
 proc pin_access { args } {
   sta::parse_key_args "pin_access" args \
     keys {-db_process_node -bottom_routing_layer -top_routing_layer -verbose \
-          -min_access_points -remote_host -remote_port -shared_volume -cloud_size } \
+          -min_access_points -remote_host -remote_port -shared_volume -cloud_size \
+          -pin_access_cache } \
     flags {-distributed}
   sta::check_argc_eq0 "detailed_route_debug" $args
   if {[info exists keys(-db_process_node)]} {
@@ -355,8 +369,13 @@ proc pin_access { args } {
     }
     drt::detailed_route_distributed $rhost $rport $vol $cloudsz
   }
+  if { [info exists keys(-pin_access_cache)] } {
+    set pin_access_cache $keys(-pin_access_cache)
+  } else {
+    set pin_access_cache ""
+  }
   drt::pin_access_cmd $db_process_node $bottom_routing_layer \
-    $top_routing_layer $verbose $min_access_points
+    $top_routing_layer $verbose $min_access_points $pin_access_cache
 }
 
 sta::define_cmd_args "detailed_route_run_worker" {
@@ -390,6 +409,36 @@ proc detailed_route_run_worker { args } {
   drt::run_worker_cmd $dump_dir $worker_dir $drc_rpt
 }
 
+sta::define_cmd_args "detailed_route_benchmark_workers" {
+    [-dump_dir dir]
+    [-worker_dirs dirs]
+    [-repeat count]
+};# checker off
+
+proc detailed_route_benchmark_workers { args } {
+  sta::parse_key_args "detailed_route_benchmark_workers" args \
+    keys {-dump_dir -worker_dirs -repeat} \
+    flags {};# checker off
+  sta::check_argc_eq0 "detailed_route_benchmark_workers" $args
+  if { [info exists keys(-dump_dir)] } {
+    set dump_dir $keys(-dump_dir)
+  } else {
+    utl::error DRT 627 "-dump_dir is required for detailed_route_benchmark_workers command"
+  }
+  if { [info exists keys(-worker_dirs)] } {
+    set worker_dirs $keys(-worker_dirs)
+  } else {
+    set worker_dirs ""
+  }
+  if { [info exists keys(-repeat)] } {
+    sta::check_positive_integer "-repeat" $keys(-repeat)
+    set repeat $keys(-repeat)
+  } else {
+    set repeat 3
+  }
+  drt::benchmark_workers_cmd $dump_dir $worker_dirs $repeat
+}
+
 sta::define_cmd_args "detailed_route_worker_debug" {
     [-maze_end_iter iter]
     [-drc_cost d_cost]
@@ -474,10 +523,11 @@ proc step_dr { args } {
 sta::define_cmd_args "check_drc" {
     [-box box]
     [-output_file filename]
+    [-tile_size gcells]
 };# checker off
 proc check_drc { args } {
   sta::parse_key_args "check_drc" args \
-    keys { -box -output_file } \
+    keys { -box -output_file -tile_size } \
     flags {};# checker off
   sta::check_argc_eq0 "check_drc" $args
   set box { 0 0 0 0 }
@@ -493,7 +543,13 @@ proc check_drc { args } {
   } else {
     utl::error DRT 613 "-output_file is required for check_drc command"
   }
-  drt::check_drc_cmd $output_file $x1 $y1 $x2 $y2
+  if { [info exists keys(-tile_size)] } {
+    set tile_size $keys(-tile_size)
+    sta::check_positive_integer "-tile_size" $tile_size
+  } else {
+    set tile_size 7
+  }
+  drt::check_drc_cmd $output_file $x1 $y1 $x2 $y2 $tile_size
 }
 
 proc fix_max_spacing { args } {
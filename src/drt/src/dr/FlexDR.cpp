@@ -34,11 +34,15 @@
 #include <boost/archive/text_iarchive.hpp>
 #include <boost/archive/text_oarchive.hpp>
 #include <boost/io/ios_state.hpp>
+#include <algorithm>
 #include <chrono>
+#include <condition_variable>
 #include <cstdio>
 #include <fstream>
 #include <iomanip>
+#include <mutex>
 #include <numeric>
+#include <queue>
 #include <sstream>
 
 #include "db/infra/KDTree.hpp"
@@ -132,7 +136,11 @@ void FlexDR::setDebug(frDebugSettings* settings)
 
 std::string FlexDRWorker::reloadedMain()
 {
+  using Clock = std::chrono::steady_clock;
+  const auto t0 = Clock::now();
+  gcTime_ = 0;
   init(design_);
+  const auto t1 = Clock::now();
   debugPrint(logger_,
              utl::DRT,
              "autotuner",
@@ -142,6 +150,8 @@ std::string FlexDRWorker::reloadedMain()
   if (!skipRouting_) {
     route_queue();
   }
+  initTime_ = std::chrono::duration<double>(t1 - t0).count();
+  routeTime_ = std::chrono::duration<double>(Clock::now() - t1).count();
   setGCWorker(nullptr);
   cleanup();
   std::string workerStr;
@@ -214,6 +224,11 @@ int FlexDRWorker::main(frDesign* design)
                     routeBox_.xMax() * micronPerDBU,
                     routeBox_.yMax() * micronPerDBU);
   }
+  // Other workers may be writing back their results in end().
+  std::shared_lock<std::shared_mutex> design_lock;
+  if (design_mutex_) {
+    design_lock = std::shared_lock<std::shared_mutex>(*design_mutex_);
+  }
   initMarkers(design);
   if (getDRIter() && getInitNumMarkers() == 0 && !needRecheck_) {
     skipRouting_ = true;
@@ -269,9 +284,14 @@ int FlexDRWorker::main(frDesign* design)
     init(design);
   }
   high_resolution_clock::time_point t1 = high_resolution_clock::now();
+  // The maze search still reads the design's region query (see
+  // hasAccessPoint), so the lock is held until routing is done.
   if (!skipRouting_) {
     route_queue();
   }
+  if (design_lock.owns_lock()) {
+    design_lock.unlock();
+  }
   high_resolution_clock::time_point t2 = high_resolution_clock::now();
   const int num_markers = getNumMarkers();
   cleanup();
@@ -559,6 +579,318 @@ void FlexDR::getBatchInfo(int& batchStepX, int& batchStepY)
   batchStepY = 2;
 }
 
+std::vector<bool> FlexDR::getWorkersTouching(const std::vector<Rect>& boxes,
+                                            const int size,
+                                            const int offset,
+                                            const int numX,
+                                            const int numY)
+{
+  // Bins the boxes by the route boxes whose drc box they touch.  This is
+  // proportional to the number of boxes rather than the die area.
+  std::vector<bool> touched(numX * numY, false);
+  auto topBlock = getDesign()->getTopBlock();
+  auto toWorker = [=](int gcellIdx, int num) {
+    return std::clamp((gcellIdx - offset) / size, 0, num - 1);
+  };
+  for (const Rect& rect : boxes) {
+    Rect box;
+    rect.bloat(DRCSAFEDIST + 1, box);
+    const Point ll = topBlock->getGCellIdx(box.ll());
+    const Point ur = topBlock->getGCellIdx(box.ur());
+    for (int x = toWorker(ll.x(), numX); x <= toWorker(ur.x(), numX); x++) {
+      for (int y = toWorker(ll.y(), numY); y <= toWorker(ur.y(), numY); y++) {
+        touched[x * numY + y] = true;
+      }
+    }
+  }
+  return touched;
+}
+
+std::vector<bool> FlexDR::getWorkersWithMarkers(const int size,
+                                                const int offset,
+                                                const int numX,
+                                                const int numY,
+                                                const bool addRegions)
+{
+  std::vector<Rect> boxes;
+  for (const auto& marker : getDesign()->getTopBlock()->getMarkers()) {
+    boxes.push_back(marker->getBBox());
+  }
+  if (addRegions) {
+    boxes.insert(boxes.end(),
+                 incrementalRegions_.begin(),
+                 incrementalRegions_.end());
+  }
+  return getWorkersTouching(boxes, size, offset, numX, numY);
+}
+
+void FlexDR::searchRepairBatches(
+    std::vector<std::unique_ptr<FlexDRWorker>>& uworkers,
+    const int numY,
+    const std::function<void()>& workerDone,
+    frTime& t)
+{
+  int batchStepX, batchStepY;
+
+  getBatchInfo(batchStepX, batchStepY);
+
+  std::vector<std::vector<std::vector<std::unique_ptr<FlexDRWorker>>>> workers(
+      batchStepX * batchStepY);
+  for (int idx = 0; idx < (int) uworkers.size(); idx++) {
+    if (!uworkers[idx]) {
+      continue;
+    }
+    const int xIdx = idx / numY;
+    const int yIdx = idx % numY;
+    int batchIdx = (xIdx % batchStepX) * batchStepY + yIdx % batchStepY;
+    if (workers[batchIdx].empty()) {
+      workers[batchIdx].push_back(
+          std::vector<std::unique_ptr<FlexDRWorker>>());
+    }
+    workers[batchIdx].back().push_back(std::move(uworkers[idx]));
+  }
+
+  int version = 0;
+  // parallel execution
+  for (auto& workerBatch : workers) {
+    ProfileTask profile("DR:checkerboard");
+    for (auto& workersInBatch : workerBatch) {
+      {
+        const std::string batch_name = std::string("DR:batch<")
+                                       + std::to_string(workersInBatch.size())
+                                       + ">";
+        ProfileTask profile(batch_name.c_str());
+        router_->dist_pool_.join();
+        if (version++ == 0 && !design_->hasUpdates()) {
+          std::string serializedViaData;
+          serializeViaData(via_data_, serializedViaData);
+          router_->sendGlobalsUpdates(globals_path_, serializedViaData);
+        } else {
+          router_->sendDesignUpdates(globals_path_);
+        }
+        {
+          ProfileTask task("DIST: PROCESS_BATCH");
+          // multi thread
+          ThreadException exception;
+#pragma omp parallel for schedule(dynamic)
+          for (int i = 0; i < (int) workersInBatch.size(); i++) {  // NOLINT
+            try {
+              workersInBatch[i]->distributedMain(getDesign());
+#pragma omp critical
+              workerDone();
+            } catch (...) {
+              exception.capture();
+            }
+          }
+          exception.rethrow();
+          int j = 0;
+          std::vector<std::vector<std::pair<int, FlexDRWorker*>>>
+              distWorkerBatches(router_->getCloudSize());
+          for (int i = 0; i < workersInBatch.size(); i++) {
+            auto worker = workersInBatch.at(i).get();
+            if (!worker->isSkipRouting()) {
+              distWorkerBatches[j].push_back({i, worker});
+              j = (j + 1) % router_->getCloudSize();
+            }
+          }
+          {
+            ProfileTask task("DIST: SERIALIZE+SEND");
+#pragma omp parallel for schedule(dynamic)
+            for (int i = 0; i < distWorkerBatches.size(); i++)  // NOLINT
+              sendWorkers(distWorkerBatches.at(i), workersInBatch);
+          }
+          logger_->report("    Received Batches:{}.", t);
+          std::vector<std::pair<int, std::string>> workers;
+          router_->getWorkerResults(workers);
+          {
+            ProfileTask task("DIST: DESERIALIZING_BATCH");
+#pragma omp parallel for schedule(dynamic)
+            for (int i = 0; i < workers.size(); i++) {  // NOLINT
+              deserializeWorker(workersInBatch.at(workers.at(i).first).get(),
+                                design_,
+                                workers.at(i).second);
+            }
+          }
+          logger_->report("    Deserialized Batches:{}.", t);
+        }
+      }
+      {
+        ProfileTask profile("DR:end_batch");
+        // single thread
+        for (auto& worker : workersInBatch) {
+          if (worker->end(getDesign())) {
+            numWorkUnits_ += 1;
+          }
+          if (worker->isCongested()) {
+            increaseClipsize_ = true;
+          }
+        }
+        workersInBatch.clear();
+      }
+    }
+  }
+}
+
+// Instead of running the checkerboard batches one after the other with a
+// barrier in between, each worker is started as soon as the neighbors it
+// overlaps that come earlier in the checkerboard order have ended.  Ready
+// workers are taken in checkerboard order so a single thread routes in the
+// same order as the batches did.  Workers read the design, routing
+// included, under a shared lock and end() writes it back under the
+// exclusive lock.  end() is applied in checkerboard order whatever order
+// the workers finish in, so the result does not depend on thread timing.
+void FlexDR::searchRepairScheduled(
+    std::vector<std::unique_ptr<FlexDRWorker>>& uworkers,
+    const int numX,
+    const int numY,
+    const std::function<void()>& workerDone)
+{
+  ProfileTask profile("DR:schedule");
+  int batchStepX, batchStepY;
+  getBatchInfo(batchStepX, batchStepY);
+
+  const int numWorkers = uworkers.size();
+  auto batchIdx = [=](int idx) {
+    return (idx / numY % batchStepX) * batchStepY + idx % numY % batchStepY;
+  };
+  auto later = [&](int a, int b) {
+    return std::make_pair(batchIdx(a), a) > std::make_pair(batchIdx(b), b);
+  };
+
+  std::vector<int> numPending(numWorkers, 0);
+  std::vector<std::vector<int>> dependents(numWorkers);
+  int numRemaining = 0;
+  for (int idx = 0; idx < numWorkers; idx++) {
+    if (!uworkers[idx]) {
+      continue;
+    }
+    numRemaining++;
+    const int xIdx = idx / numY;
+    const int yIdx = idx % numY;
+    for (int x = std::max(0, xIdx - 1); x <= std::min(numX - 1, xIdx + 1);
+         x++) {
+      for (int y = std::max(0, yIdx - 1); y <= std::min(numY - 1, yIdx + 1);
+           y++) {
+        const int neighbor = x * numY + y;
+        if (uworkers[neighbor] && later(idx, neighbor)
+            && batchIdx(idx) != batchIdx(neighbor)) {
+          numPending[idx]++;
+          dependents[neighbor].push_back(idx);
+        }
+      }
+    }
+  }
+  std::priority_queue<int, std::vector<int>, decltype(later)> ready(later);
+  for (int idx = 0; idx < numWorkers; idx++) {
+    if (uworkers[idx] && numPending[idx] == 0) {
+      ready.push(idx);
+    }
+  }
+
+  // Every worker's dependencies come before it in this order, so the next
+  // worker to end has always been started or is ready.
+  std::vector<int> endOrder;
+  for (int idx = 0; idx < numWorkers; idx++) {
+    if (uworkers[idx]) {
+      endOrder.push_back(idx);
+    }
+  }
+  std::sort(endOrder.begin(), endOrder.end(), [&](int a, int b) {
+    return later(b, a);
+  });
+  std::vector<bool> routed(numWorkers, false);
+  size_t nextEnd = 0;
+  bool ending = false;
+
+  std::mutex readyMutex;
+  std::condition_variable readyCond;
+  bool failed = false;
+  std::shared_mutex designMutex;
+  ThreadException exception;
+  // Ends the routed workers that are next in endOrder.  Only one thread
+  // ends workers at a time; it keeps going while the next one is routed.
+  auto endWorkers = [&]() {
+    while (true) {
+      int idx;
+      {
+        std::unique_lock<std::mutex> lock(readyMutex);
+        if (ending || failed || nextEnd == endOrder.size()
+            || !routed[endOrder[nextEnd]]) {
+          return;
+        }
+        ending = true;
+        idx = endOrder[nextEnd];
+      }
+      bool ok = true;
+      try {
+        auto& worker = uworkers[idx];
+        std::unique_lock<std::shared_mutex> lock(designMutex);
+        if (worker->end(getDesign())) {
+          numWorkUnits_ += 1;
+        }
+        if (worker->isCongested()) {
+          increaseClipsize_ = true;
+        }
+        workerDone();
+        worker.reset();
+      } catch (...) {
+        exception.capture();
+        ok = false;
+      }
+      {
+        std::unique_lock<std::mutex> lock(readyMutex);
+        ending = false;
+        failed |= !ok;
+        nextEnd++;
+        numRemaining--;
+        for (int dependent : dependents[idx]) {
+          if (--numPending[dependent] == 0) {
+            ready.push(dependent);
+          }
+        }
+      }
+      readyCond.notify_all();
+    }
+  };
+#pragma omp parallel
+  {
+    while (true) {
+      int idx;
+      {
+        std::unique_lock<std::mutex> lock(readyMutex);
+        readyCond.wait(lock, [&]() {
+          return !ready.empty() || numRemaining == 0 || failed;
+        });
+        if (ready.empty() || failed) {
+          break;
+        }
+        idx = ready.top();
+        ready.pop();
+      }
+      bool ok = true;
+      try {
+        auto& worker = uworkers[idx];
+        worker->setDesignMutex(&designMutex);
+        worker->main(getDesign());
+      } catch (...) {
+        exception.capture();
+        ok = false;
+      }
+      {
+        std::unique_lock<std::mutex> lock(readyMutex);
+        failed |= !ok;
+        routed[idx] = true;
+      }
+      if (!ok) {
+        readyCond.notify_all();
+        break;
+      }
+      endWorkers();
+    }
+  }
+  exception.rethrow();
+}
+
 void FlexDR::searchRepair(const SearchRepairArgs& args)
 {
   const int iter = iter_++;
@@ -605,23 +937,30 @@ void FlexDR::searchRepair(const SearchRepairArgs& args)
   auto gCellPatterns = getDesign()->getTopBlock()->getGCellPatterns();
   auto& xgp = gCellPatterns.at(0);
   auto& ygp = gCellPatterns.at(1);
+  const int numX = ((int) xgp.getCount() - 1 - offset) / size + 1;
+  const int numY = ((int) ygp.getCount() - 1 - offset) / size + 1;
   int cnt = 0;
-  int tot = (((int) xgp.getCount() - 1 - offset) / size + 1)
-            * (((int) ygp.getCount() - 1 - offset) / size + 1);
+  int tot = numX * numY;
   int prev_perc = 0;
   bool isExceed = false;
 
-  std::vector<std::unique_ptr<FlexDRWorker>> uworkers;
-  int batchStepX, batchStepY;
-
-  getBatchInfo(batchStepX, batchStepY);
-
-  std::vector<std::vector<std::vector<std::unique_ptr<FlexDRWorker>>>> workers(
-      batchStepX * batchStepY);
+  // From the second iteration on a worker without markers in its drc box
+  // skips routing (see FlexDRWorker::main) so it is not created at all.  In
+  // incremental mode the first iterations only route around the changes.
+  std::vector<bool> hasMarkers;
+  if (iter >= 2 || incremental_) {
+    hasMarkers = getWorkersWithMarkers(
+        size, offset, numX, numY, incremental_ && iter < 2);
+    tot = std::count(hasMarkers.begin(), hasMarkers.end(), true);
+  }
 
-  int xIdx = 0, yIdx = 0;
+  std::vector<std::unique_ptr<FlexDRWorker>> uworkers;
   for (int i = offset; i < (int) xgp.getCount(); i += size) {
     for (int j = offset; j < (int) ygp.getCount(); j += size) {
+      if (!hasMarkers.empty() && !hasMarkers[uworkers.size()]) {
+        uworkers.push_back(nullptr);
+        continue;
+      }
       auto worker
           = std::make_unique<FlexDRWorker>(&via_data_, design_, logger_);
       Rect routeBox1 = getDesign()->getTopBlock()->getGCellBox(Point(i, j));
@@ -663,131 +1002,36 @@ void FlexDR::searchRepair(const SearchRepairArgs& args)
                       workerMarkerCost,
                       workerFixedShapeCost,
                       workerMarkerDecay);
-
-      int batchIdx = (xIdx % batchStepX) * batchStepY + yIdx % batchStepY;
-      if (workers[batchIdx].empty()
-          || (!dist_on_
-              && (int) workers[batchIdx].back().size() >= BATCHSIZE)) {
-        workers[batchIdx].push_back(
-            std::vector<std::unique_ptr<FlexDRWorker>>());
-      }
-      workers[batchIdx].back().push_back(std::move(worker));
-
-      yIdx++;
+      uworkers.push_back(std::move(worker));
     }
-    yIdx = 0;
-    xIdx++;
   }
 
-  omp_set_num_threads(MAX_THREADS);
-  int version = 0;
-  increaseClipsize_ = false;
-  numWorkUnits_ = 0;
-  // parallel execution
-  for (auto& workerBatch : workers) {
-    ProfileTask profile("DR:checkerboard");
-    for (auto& workersInBatch : workerBatch) {
-      {
-        const std::string batch_name = std::string("DR:batch<")
-                                       + std::to_string(workersInBatch.size())
-                                       + ">";
-        ProfileTask profile(batch_name.c_str());
-        if (dist_on_) {
-          router_->dist_pool_.join();
-          if (version++ == 0 && !design_->hasUpdates()) {
-            std::string serializedViaData;
-            serializeViaData(via_data_, serializedViaData);
-            router_->sendGlobalsUpdates(globals_path_, serializedViaData);
-          } else {
-            router_->sendDesignUpdates(globals_path_);
-          }
+  auto workerDone = [&]() {
+    cnt++;
+    if (VERBOSE > 0) {
+      if (cnt * 1.0 / tot >= prev_perc / 100.0 + 0.1 && prev_perc < 90) {
+        if (prev_perc == 0 && t.isExceed(0)) {
+          isExceed = true;
         }
-        {
-          ProfileTask task("DIST: PROCESS_BATCH");
-          // multi thread
-          ThreadException exception;
-#pragma omp parallel for schedule(dynamic)
-          for (int i = 0; i < (int) workersInBatch.size(); i++) {  // NOLINT
-            try {
-              if (dist_on_) {
-                workersInBatch[i]->distributedMain(getDesign());
-              } else {
-                workersInBatch[i]->main(getDesign());
-              }
-#pragma omp critical
-              {
-                cnt++;
-                if (VERBOSE > 0) {
-                  if (cnt * 1.0 / tot >= prev_perc / 100.0 + 0.1
-                      && prev_perc < 90) {
-                    if (prev_perc == 0 && t.isExceed(0)) {
-                      isExceed = true;
-                    }
-                    prev_perc += 10;
-                    if (isExceed) {
-                      logger_->report(
-                          "    Completing {}% with {} violations.",
+        prev_perc += 10;
+        if (isExceed) {
+          logger_->report("    Completing {}% with {} violations.",
                           prev_perc,
                           getDesign()->getTopBlock()->getNumMarkers());
-                      logger_->report("    {}.", t);
-                    }
-                  }
-                }
-              }
-            } catch (...) {
-              exception.capture();
-            }
-          }
-          exception.rethrow();
-          if (dist_on_) {
-            int j = 0;
-            std::vector<std::vector<std::pair<int, FlexDRWorker*>>>
-                distWorkerBatches(router_->getCloudSize());
-            for (int i = 0; i < workersInBatch.size(); i++) {
-              auto worker = workersInBatch.at(i).get();
-              if (!worker->isSkipRouting()) {
-                distWorkerBatches[j].push_back({i, worker});
-                j = (j + 1) % router_->getCloudSize();
-              }
-            }
-            {
-              ProfileTask task("DIST: SERIALIZE+SEND");
-#pragma omp parallel for schedule(dynamic)
-              for (int i = 0; i < distWorkerBatches.size(); i++)  // NOLINT
-                sendWorkers(distWorkerBatches.at(i), workersInBatch);
-            }
-            logger_->report("    Received Batches:{}.", t);
-            std::vector<std::pair<int, std::string>> workers;
-            router_->getWorkerResults(workers);
-            {
-              ProfileTask task("DIST: DESERIALIZING_BATCH");
-#pragma omp parallel for schedule(dynamic)
-              for (int i = 0; i < workers.size(); i++) {  // NOLINT
-                deserializeWorker(workersInBatch.at(workers.at(i).first).get(),
-                                  design_,
-                                  workers.at(i).second);
-              }
-            }
-            logger_->report("    Deserialized Batches:{}.", t);
-          }
-        }
-      }
-      {
-        ProfileTask profile("DR:end_batch");
-        // single thread
-        for (auto& worker : workersInBatch) {
-          if (worker->end(getDesign())) {
-            numWorkUnits_ += 1;
-          }
-          if (worker->isCongested()) {
-            increaseClipsize_ = true;
-          }
+          logger_->report("    {}.", t);
         }
-        workersInBatch.clear();
       }
     }
-  }
+  };
 
+  omp_set_num_threads(MAX_THREADS);
+  increaseClipsize_ = false;
+  numWorkUnits_ = 0;
+  if (dist_on_) {
+    searchRepairBatches(uworkers, numY, workerDone, t);
+  } else {
+    searchRepairScheduled(uworkers, numX, numY, workerDone);
+  }
   if (!iter) {
     removeGCell2BoundaryPin();
   }
@@ -1417,7 +1661,7 @@ int FlexDR::main()
     }
     args.size = clipSize;
     if (args.ripupMode == RipUpMode::ALL) {
-      if (hasFixed || (incremental && iter_ <= 2)) {
+      if (hasFixed || incremental_ || (incremental && iter_ <= 2)) {
         args.ripupMode = RipUpMode::INCR;
       }
     }
@@ -33,7 +33,9 @@
 #include <boost/polygon/polygon.hpp>
 #include <boost/serialization/export.hpp>
 #include <deque>
+#include <functional>
 #include <memory>
+#include <shared_mutex>
 
 #include "db/drObj/drMarker.h"
 #include "db/drObj/drNet.h"
@@ -58,6 +60,8 @@ class Logger;
 namespace drt {
 
 class frConstraint;
+class frTime;
+class FlexDRWorker;
 struct SearchRepairArgs;
 
 struct FlexDRViaData
@@ -129,6 +133,14 @@ class FlexDR
       const std::vector<std::pair<int, FlexDRWorker*>>& remote_batch,
       std::vector<std::unique_ptr<FlexDRWorker>>& batch);
 
+  // Only route around the given regions (and markers) instead of the
+  // whole die.  The nets with initial routing are kept as they are.
+  void setIncrementalRegions(std::vector<Rect> regions)
+  {
+    incremental_ = true;
+    incrementalRegions_ = std::move(regions);
+  }
+
   void reportGuideCoverage();
   void setIter(int iterNum) { iter_ = iterNum; }
   // maxSpacing fix
@@ -160,11 +172,32 @@ class FlexDR
   bool increaseClipsize_;
   float clipSizeInc_;
   int iter_;
+  bool incremental_ = false;
+  std::vector<Rect> incrementalRegions_;
 
   // others
   void initFromTA();
   void initGCell2BoundaryPin();
   void getBatchInfo(int& batchStepX, int& batchStepY);
+  std::vector<bool> getWorkersTouching(const std::vector<Rect>& boxes,
+                                       int size,
+                                       int offset,
+                                       int numX,
+                                       int numY);
+  std::vector<bool> getWorkersWithMarkers(int size,
+                                          int offset,
+                                          int numX,
+                                          int numY,
+                                          bool addRegions);
+  void searchRepairBatches(std::vector<std::unique_ptr<FlexDRWorker>>& uworkers,
+                           int numY,
+                           const std::function<void()>& workerDone,
+                           frTime& t);
+  void searchRepairScheduled(
+      std::vector<std::unique_ptr<FlexDRWorker>>& uworkers,
+      int numX,
+      int numY,
+      const std::function<void()>& workerDone);
 
   void init_halfViaEncArea();
 
@@ -349,6 +382,8 @@ class FlexDRWorker
     gridGraph_.setGraphics(in);
   }
   void setViaData(FlexDRViaData* viaData) { via_data_ = viaData; }
+  // Held shared while reading the design in main()
+  void setDesignMutex(std::shared_mutex* in) { design_mutex_ = in; }
   // getters
   frTechObject* getTech() const { return design_->getTech(); }
   void getRouteBox(Rect& boxIn) const { boxIn = routeBox_; }
@@ -396,6 +431,11 @@ class FlexDRWorker
   void updateDesign(frDesign* design);
   std::string reloadedMain();
   bool end(frDesign* design);
+  // Wall time in seconds of the phases of the last reloadedMain.  The GC
+  // time is the part of the route time spent in FlexGCWorker::main.
+  double getInitTime() const { return initTime_; }
+  double getRouteTime() const { return routeTime_; }
+  double getGCTime() const { return gcTime_; }
 
   Logger* getLogger() { return logger_; }
   void setLogger(Logger* logger)
@@ -466,6 +506,7 @@ class FlexDRWorker
   FlexDRGraphics* graphics_ = nullptr;  // owned by FlexDR
   frDebugSettings* debugSettings_ = nullptr;
   FlexDRViaData* via_data_ = nullptr;
+  std::shared_mutex* design_mutex_ = nullptr;
   Rect routeBox_;
   Rect extBox_;
   Rect drcBox_;
@@ -475,6 +516,9 @@ class FlexDRWorker
   bool followGuide_ = false;
   bool needRecheck_ = false;
   bool skipRouting_ = false;
+  double initTime_ = 0;
+  double routeTime_ = 0;
+  double gcTime_ = 0;
   RipUpMode ripupMode_ = RipUpMode::DRC;
   // drNetOrderingEnum netOrderingMode;
   frUInt4 workerDRCCost_ = 0;
@@ -729,6 +773,7 @@ class FlexDRWorker
 
   // route_queue
   void route_queue();
+  void runGC(bool incremental = false);
   void route_queue_main(std::queue<RouteQueueEntry>& rerouteQueue);
   void addMinAreaPatches_poly(gcNet* drcNet, drNet* net);
   void cleanUnneededPatches_poly(gcNet* drcNet, drNet* net);
@@ -1719,13 +1719,26 @@ void FlexDRWorker::writeGCPatchesToDRWorker(
   }
 }
 
+void FlexDRWorker::runGC(bool incremental)
+{
+  const auto start = std::chrono::steady_clock::now();
+  if (incremental) {
+    gcWorker_->mainIncremental();
+  } else {
+    gcWorker_->main();
+  }
+  const std::chrono::duration<double> elapsed
+      = std::chrono::steady_clock::now() - start;
+  gcTime_ += elapsed.count();
+}
+
 void FlexDRWorker::route_queue()
 {
   std::queue<RouteQueueEntry> rerouteQueue;
 
   if (needRecheck_) {
     gcWorker_->setEnableSurgicalFix(true);
-    gcWorker_->main();
+    runGC();
     writeGCPatchesToDRWorker();
     gcWorker_->clearPWires();
     setMarkers(gcWorker_->getMarkers());
@@ -1761,10 +1774,11 @@ void FlexDRWorker::route_queue()
 
   // route
   route_queue_main(rerouteQueue);
-  // end
+  // end, only the area around the rerouted nets is checked again if the
+  // worker started with a full check
   gcWorker_->resetTargetNet();
   gcWorker_->setEnableSurgicalFix(true);
-  gcWorker_->main();
+  runGC(true);
   // write back GC patches
   writeGCPatchesToDRWorker();
 
@@ -1978,7 +1992,7 @@ void FlexDRWorker::route_queue_main(std::queue<RouteQueueEntry>& rerouteQueue)
       if (gcWorker_->setTargetNet(net->getFrNet())) {
         gcWorker_->updateDRNet(net);
         gcWorker_->setEnableSurgicalFix(true);
-        gcWorker_->main();
+        runGC();
         modEolCosts_poly(gcWorker_->getTargetNet(), ModCostType::addRouteShape);
         // write back GC patches
         drNet* currNet = net;
@@ -2043,7 +2057,7 @@ void FlexDRWorker::route_queue_main(std::queue<RouteQueueEntry>& rerouteQueue)
           gcWorker_->setTargetNet(net->getFrNet());
           gcWorker_->updateDRNet(net);
           gcWorker_->setEnableSurgicalFix(true);
-          gcWorker_->main();
+          runGC();
           if (gcWorker_->getMarkers().empty()) {
             net->setModified(true);
             writeGCPatchesToDRWorker();
@@ -2061,12 +2075,12 @@ void FlexDRWorker::route_queue_main(std::queue<RouteQueueEntry>& rerouteQueue)
         if (obj->typeId() == frcNet) {
           auto net = static_cast<frNet*>(obj);
           if (gcWorker_->setTargetNet(net)) {
-            gcWorker_->main();
+            runGC();
             didCheck = true;
           }
         } else {
           if (gcWorker_->setTargetNet(obj)) {
-            gcWorker_->main();
+            runGC();
             didCheck = true;
           }
         }
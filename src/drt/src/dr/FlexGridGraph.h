@@ -28,6 +28,7 @@
 
 #pragma once
 
+#include <array>
 #include <cstdint>
 #include <cstring>
 #include <iostream>
@@ -1272,7 +1273,14 @@ class FlexGridGraph
                     const FlexMazeIdx& dstMazeIdx2,
                     const frDirEnum& dir) const;
   frCost getNextPathCost(const FlexWavefrontGrid& currGrid,
-                         const frDirEnum& dir) const;
+                         const frDirEnum& dir,
+                         frCost edgeCost) const;
+  // Same as getCosts for the six directions of frDirEnumAll at once.  The
+  // node bits are gathered first so the weighting is a branch-free loop the
+  // compiler can vectorize.  Directions that are not expandable get 0.
+  void getCostsBatch(const FlexWavefrontGrid& currGrid,
+                     const std::array<bool, 6>& expandable,
+                     std::array<frCost, 6>& costs) const;
   frDirEnum getLastDir(const std::bitset<WAVEFRONTBITSIZE>& buffer) const;
   void traceBackPath(const FlexWavefrontGrid& currGrid,
                      std::vector<FlexMazeIdx>& path,
@@ -1288,6 +1296,7 @@ class FlexGridGraph
                          const FlexWavefrontGrid& currGrid) const;
   void expand(FlexWavefrontGrid& currGrid,
               const frDirEnum& dir,
+              frCost edgeCost,
               const FlexMazeIdx& dstMazeIdx1,
               const FlexMazeIdx& dstMazeIdx2,
               const Point& centerPt);
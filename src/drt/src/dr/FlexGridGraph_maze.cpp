@@ -35,6 +35,7 @@ namespace drt {
 int debugMazeIter = std::numeric_limits<int>::max();
 void FlexGridGraph::expand(FlexWavefrontGrid& currGrid,
                            const frDirEnum& dir,
+                           frCost edgeCost,
                            const FlexMazeIdx& dstMazeIdx1,
                            const FlexMazeIdx& dstMazeIdx2,
                            const Point& centerPt)
@@ -53,7 +54,7 @@ void FlexGridGraph::expand(FlexWavefrontGrid& currGrid,
                    dstMazeIdx1,
                    dstMazeIdx2,
                    dir);
-  nextPathCost = getNextPathCost(currGrid, dir);
+  nextPathCost = getNextPathCost(currGrid, dir, edgeCost);
   Point currPt;
   getPoint(currPt, gridX, gridY);
   frCoord currDist = Point::manhattanDistance(currPt, centerPt);
@@ -155,9 +156,20 @@ void FlexGridGraph::expandWavefront(FlexWavefrontGrid& currGrid,
                                     const FlexMazeIdx& dstMazeIdx2,
                                     const Point& centerPt)
 {
-  for (const auto dir : frDirEnumAll) {
-    if (isExpandable(currGrid, dir)) {
-      expand(currGrid, dir, dstMazeIdx1, dstMazeIdx2, centerPt);
+  std::array<bool, 6> expandable;
+  for (int i = 0; i < 6; ++i) {
+    expandable[i] = isExpandable(currGrid, frDirEnumAll[i]);
+  }
+  std::array<frCost, 6> edgeCosts;
+  getCostsBatch(currGrid, expandable, edgeCosts);
+  for (int i = 0; i < 6; ++i) {
+    if (expandable[i]) {
+      expand(currGrid,
+             frDirEnumAll[i],
+             edgeCosts[i],
+             dstMazeIdx1,
+             dstMazeIdx2,
+             centerPt);
     }
   }
 }
@@ -322,7 +334,8 @@ void FlexGridGraph::getPrevGrid(frMIdx& gridX,
 }
 
 frCost FlexGridGraph::getNextPathCost(const FlexWavefrontGrid& currGrid,
-                                      const frDirEnum& dir) const
+                                      const frDirEnum& dir,
+                                      frCost edgeCost) const
 {
   frMIdx gridX = currGrid.x();
   frMIdx gridY = currGrid.y();
@@ -331,8 +344,6 @@ frCost FlexGridGraph::getNextPathCost(const FlexWavefrontGrid& currGrid,
   frCoord edgeLength = getEdgeLength(gridX, gridY, gridZ, dir);
   // bending cost
   auto currDir = currGrid.getLastDir();
-  auto lNum = getLayerNum(currGrid.z());
-  auto layer = getTech()->getLayer(lNum);
 
   if (currDir != dir && currDir != frDirEnum::UNKNOWN) {
     // original
@@ -473,12 +484,53 @@ frCost FlexGridGraph::getNextPathCost(const FlexWavefrontGrid& currGrid,
       }
     }
   }
-  nextPathCost
-      += getCosts(gridX, gridY, gridZ, dir, layer, useNDRCosts(currGrid));
+  nextPathCost += edgeCost;
 
   return nextPathCost;
 }
 
+void FlexGridGraph::getCostsBatch(const FlexWavefrontGrid& currGrid,
+                                  const std::array<bool, 6>& expandable,
+                                  std::array<frCost, 6>& costs) const
+{
+  const frMIdx gridX = currGrid.x();
+  const frMIdx gridY = currGrid.y();
+  const frMIdx gridZ = currGrid.z();
+  const bool considerNDR = useNDRCosts(currGrid);
+  const frLayer* layer = getTech()->getLayer(getLayerNum(gridZ));
+  const frCost blockCost = BLOCKCOST * layer->getMinWidth() * 20;
+
+  std::array<frCost, 6> edgeLength{};
+  std::array<frCost, 6> gridCost{};
+  std::array<frCost, 6> drcCost{};
+  std::array<frCost, 6> markerCost{};
+  std::array<frCost, 6> shapeCost{};
+  std::array<frCost, 6> blocked{};
+  std::array<frCost, 6> offGuide{};
+  for (int i = 0; i < 6; ++i) {
+    if (!expandable[i]) {
+      continue;
+    }
+    const frDirEnum dir = frDirEnumAll[i];
+    edgeLength[i] = getEdgeLength(gridX, gridY, gridZ, dir);
+    gridCost[i] = hasGridCost(gridX, gridY, gridZ, dir);
+    drcCost[i] = hasRouteShapeCostAdj(gridX, gridY, gridZ, dir, considerNDR);
+    markerCost[i] = hasMarkerCostAdj(gridX, gridY, gridZ, dir);
+    shapeCost[i] = hasFixedShapeCostAdj(gridX, gridY, gridZ, dir, considerNDR);
+    blocked[i] = isBlocked(gridX, gridY, gridZ, dir);
+    offGuide[i] = !hasGuide(gridX, gridY, gridZ, dir);
+  }
+
+  for (int i = 0; i < 6; ++i) {
+    const frCost len = edgeLength[i];
+    costs[i] = len + gridCost[i] * GRIDCOST * len
+               + drcCost[i] * ggDRCCost_ * len
+               + markerCost[i] * ggMarkerCost_ * len
+               + shapeCost[i] * ggFixedShapeCost_ * len
+               + blocked[i] * blockCost + offGuide[i] * GUIDECOST * len;
+  }
+}
+
 frCost FlexGridGraph::getCosts(frMIdx gridX,
                                frMIdx gridY,
                                frMIdx gridZ,
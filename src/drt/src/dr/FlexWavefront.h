@@ -28,9 +28,12 @@
 
 #pragma once
 
+#include <algorithm>
+#include <array>
 #include <bitset>
 #include <memory>
 #include <queue>
+#include <vector>
 
 #include "dr/FlexMazeTypes.h"
 #include "frBaseTypes.h"
@@ -150,18 +153,149 @@ class myPriorityQueue : public std::priority_queue<FlexWavefrontGrid>
   }
 };
 
+// Radix heap keyed on the integer cost of the grids.  A grid is kept in the
+// bucket of the highest bit in which its cost differs from the last
+// extracted cost, so push is O(1) and pop is amortized O(log C) instead of
+// O(log n).  Bucket 0 holds the grids at or below the current cost and is a
+// heap ordered by FlexWavefrontGrid::operator<, as myPriorityQueue is.  That
+// is not a total order: grids it does not order may pop in a different order
+// than from myPriorityQueue, all others pop in the same order.  The
+// estimated cost is not strictly consistent, so a push below the current
+// cost can happen and simply goes to bucket 0.
+class FlexRadixWavefront
+{
+ public:
+  bool empty() const { return size_ == 0; }
+  const FlexWavefrontGrid& top() const { return buckets_[0].front(); }
+  void pop()
+  {
+    auto& bucket = buckets_[0];
+    std::pop_heap(bucket.begin(), bucket.end());
+    bucket.pop_back();
+    --size_;
+    if (bucket.empty() && size_ > 0) {
+      redistribute();
+    }
+  }
+  void push(const FlexWavefrontGrid& in)
+  {
+    if (size_ == 0) {
+      last_ = in.getCost();
+    }
+    insert(in);
+    ++size_;
+  }
+  unsigned int size() const { return size_; }
+  void cleanup()
+  {
+    for (auto& bucket : buckets_) {
+      bucket.clear();
+    }
+    size_ = 0;
+  }
+  void fit()
+  {
+    for (auto& bucket : buckets_) {
+      bucket.clear();
+      bucket.shrink_to_fit();
+    }
+    scratch_.clear();
+    scratch_.shrink_to_fit();
+    size_ = 0;
+  }
+
+ private:
+  static constexpr int costBits_ = sizeof(frCost) * 8;
+
+  static int getBucket(frCost cost, frCost last)
+  {
+    if (cost <= last) {
+      return 0;
+    }
+    return costBits_ - __builtin_clz(cost ^ last);
+  }
+  void insert(const FlexWavefrontGrid& in)
+  {
+    const int idx = getBucket(in.getCost(), last_);
+    auto& bucket = buckets_[idx];
+    bucket.push_back(in);
+    if (idx == 0) {
+      std::push_heap(bucket.begin(), bucket.end());
+    }
+  }
+  // Moves the first non-empty bucket down once bucket 0 runs out.  All of
+  // its grids share the bits above idx with the new minimum so they land in
+  // lower buckets.
+  void redistribute()
+  {
+    int idx = 1;
+    while (buckets_[idx].empty()) {
+      ++idx;
+    }
+    scratch_.swap(buckets_[idx]);
+    last_ = std::min_element(scratch_.begin(),
+                             scratch_.end(),
+                             [](const auto& a, const auto& b) {
+                               return a.getCost() < b.getCost();
+                             })
+                ->getCost();
+    for (const auto& grid : scratch_) {
+      insert(grid);
+    }
+    scratch_.clear();
+  }
+  std::array<std::vector<FlexWavefrontGrid>, costBits_ + 1> buckets_;
+  std::vector<FlexWavefrontGrid> scratch_;
+  frCost last_ = 0;
+  unsigned int size_ = 0;
+};
+
 class FlexWavefront
 {
  public:
-  bool empty() const { return wavefrontPQ_.empty(); }
-  const FlexWavefrontGrid& top() const { return wavefrontPQ_.top(); }
-  void pop() { wavefrontPQ_.pop(); }
-  void push(const FlexWavefrontGrid& in) { wavefrontPQ_.push(in); }
-  unsigned int size() const { return wavefrontPQ_.size(); }
-  void cleanup() { wavefrontPQ_.cleanup(); }
-  void fit() { wavefrontPQ_.fit(); }
+  explicit FlexWavefront(bool radix = RADIX_WAVEFRONT) : radix_(radix) {}
+  bool empty() const
+  {
+    return radix_ ? radixPQ_.empty() : wavefrontPQ_.empty();
+  }
+  const FlexWavefrontGrid& top() const
+  {
+    return radix_ ? radixPQ_.top() : wavefrontPQ_.top();
+  }
+  void pop()
+  {
+    if (radix_) {
+      radixPQ_.pop();
+    } else {
+      wavefrontPQ_.pop();
+    }
+  }
+  void push(const FlexWavefrontGrid& in)
+  {
+    if (radix_) {
+      radixPQ_.push(in);
+    } else {
+      wavefrontPQ_.push(in);
+    }
+  }
+  unsigned int size() const
+  {
+    return radix_ ? radixPQ_.size() : wavefrontPQ_.size();
+  }
+  void cleanup()
+  {
+    wavefrontPQ_.cleanup();
+    radixPQ_.cleanup();
+  }
+  void fit()
+  {
+    wavefrontPQ_.fit();
+    radixPQ_.fit();
+  }
 
  private:
+  bool radix_;
   myPriorityQueue wavefrontPQ_;
+  FlexRadixWavefront radixPQ_;
 };
 }  // namespace drt
@@ -28,13 +28,19 @@
 
 #include "frRegionQuery.h"
 
+#include <omp.h>
+
+#include <algorithm>
 #include <boost/polygon/polygon.hpp>
+#include <chrono>
 #include <iostream>
 
 #include "frDesign.h"
+#include "frProfileTask.h"
 #include "frRTree.h"
 #include "global.h"
 #include "utl/algorithms.h"
+#include "utl/exception.h"
 
 namespace drt {
 
@@ -92,8 +98,80 @@ struct frRegionQuery::Impl
   void addGRObj(grVia* via, ObjectsByLayer<grBlockObject>& allShapes);
   void addGRObj(grShape* shape);
   void addGRObj(grVia* via);
+
+  template <typename T, typename Obj, typename AddFn>
+  static void gather(const std::vector<std::unique_ptr<Obj>>& objs,
+                     ObjectsByLayer<T>& allShapes,
+                     const AddFn& add);
+  template <typename T>
+  static void bulkLoad(ObjectsByLayer<T>& allShapes, RTreesByLayer<T*>& trees);
 };
 
+// Collects the shapes of objs per layer on MAX_THREADS threads.  Each chunk
+// of objs is gathered separately and the chunks are appended in order so
+// the result is the same as walking objs serially.
+template <typename T, typename Obj, typename AddFn>
+void frRegionQuery::Impl::gather(const std::vector<std::unique_ptr<Obj>>& objs,
+                                 ObjectsByLayer<T>& allShapes,
+                                 const AddFn& add)
+{
+  constexpr int min_chunk_size = 4096;
+  const int numObjs = objs.size();
+  const int numChunks
+      = std::min(numObjs / min_chunk_size + 1, std::max(MAX_THREADS, 1) * 4);
+  if (numChunks == 1) {
+    for (auto& obj : objs) {
+      add(obj.get(), allShapes);
+    }
+    return;
+  }
+
+  std::vector<ObjectsByLayer<T>> chunks(numChunks,
+                                        ObjectsByLayer<T>(allShapes.size()));
+  utl::ThreadException exception;
+  omp_set_num_threads(MAX_THREADS);
+#pragma omp parallel for schedule(dynamic)
+  for (int i = 0; i < numChunks; i++) {  // NOLINT
+    try {
+      const int begin = (int64_t) numObjs * i / numChunks;
+      const int end = (int64_t) numObjs * (i + 1) / numChunks;
+      for (int j = begin; j < end; j++) {
+        add(objs[j].get(), chunks[i]);
+      }
+    } catch (...) {
+      exception.capture();
+    }
+  }
+  exception.rethrow();
+
+  for (size_t layer = 0; layer < allShapes.size(); layer++) {
+    auto& shapes = allShapes[layer];
+    size_t size = shapes.size();
+    for (auto& chunk : chunks) {
+      size += chunk[layer].size();
+    }
+    shapes.reserve(size);
+    for (auto& chunk : chunks) {
+      shapes.insert(shapes.end(), chunk[layer].begin(), chunk[layer].end());
+      Objects<T>().swap(chunk[layer]);
+    }
+  }
+}
+
+// Packs one tree per layer from allShapes, building the layers concurrently.
+template <typename T>
+void frRegionQuery::Impl::bulkLoad(ObjectsByLayer<T>& allShapes,
+                                   RTreesByLayer<T*>& trees)
+{
+  omp_set_num_threads(MAX_THREADS);
+#pragma omp parallel for schedule(dynamic)
+  for (int i = 0; i < (int) allShapes.size(); i++) {  // NOLINT
+    trees[i] = boost::move(RTree<T*>(allShapes[i]));
+    allShapes[i].clear();
+    allShapes[i].shrink_to_fit();
+  }
+}
+
 frRegionQuery::frRegionQuery(frDesign* design, Logger* logger)
     : impl_(std::make_unique<Impl>())
 {
@@ -729,6 +807,8 @@ void frRegionQuery::init()
 
 void frRegionQuery::Impl::init()
 {
+  ProfileTask profile("RQ:init");
+  const auto start = std::chrono::steady_clock::now();
   const frLayerNum numLayers = design_->getTech()->getLayers().size();
   shapes_.clear();
   shapes_.resize(numLayers);
@@ -738,28 +818,29 @@ void frRegionQuery::Impl::init()
 
   ObjectsByLayer<frBlockObject> allShapes(numLayers);
 
-  int cnt = 0;
-  for (auto& inst : design_->getTopBlock()->getInsts()) {
-    for (auto& instTerm : inst->getInstTerms()) {
-      add(instTerm.get(), allShapes);
-    }
-    for (auto& instBlk : inst->getInstBlockages()) {
-      add(instBlk.get(), allShapes);
-    }
-    cnt++;
-    if (VERBOSE > 0) {
+  ProfileTask gatherTask("RQ:gather");
+  const auto& insts = design_->getTopBlock()->getInsts();
+  gather(insts,
+         allShapes,
+         [this](frInst* inst, ObjectsByLayer<frBlockObject>& shapes) {
+           for (auto& instTerm : inst->getInstTerms()) {
+             add(instTerm.get(), shapes);
+           }
+           for (auto& instBlk : inst->getInstBlockages()) {
+             add(instBlk.get(), shapes);
+           }
+         });
+  if (VERBOSE > 0) {
+    for (int cnt = 100000; cnt <= (int) insts.size();
+         cnt += (cnt < 1000000) ? 100000 : 1000000) {
       if (cnt < 1000000) {
-        if (cnt % 100000 == 0) {
-          logger_->info(DRT, 18, "  Complete {} insts.", cnt);
-        }
+        logger_->info(DRT, 18, "  Complete {} insts.", cnt);
       } else {
-        if (cnt % 1000000 == 0) {
-          logger_->info(DRT, 19, "  Complete {} insts.", cnt);
-        }
+        logger_->info(DRT, 19, "  Complete {} insts.", cnt);
       }
     }
   }
-  cnt = 0;
+  int cnt = 0;
   for (auto& term : design_->getTopBlock()->getTerms()) {
     add(term.get(), allShapes);
     cnt++;
@@ -802,11 +883,23 @@ void frRegionQuery::Impl::init()
       }
     }
   }
+  gatherTask.done();
+  const auto gathered = std::chrono::steady_clock::now();
 
+  {
+    ProfileTask task("RQ:bulkLoad");
+    bulkLoad(allShapes, shapes_);
+  }
+  debugPrint(logger_,
+             DRT,
+             "region_query",
+             1,
+             "Gathered shapes in {:.3f}s, built trees in {:.3f}s.",
+             std::chrono::duration<double>(gathered - start).count(),
+             std::chrono::duration<double>(std::chrono::steady_clock::now()
+                                           - gathered)
+                 .count());
   for (auto i = 0; i < numLayers; i++) {
-    shapes_.at(i) = boost::move(RTree<frBlockObject*>(allShapes.at(i)));
-    allShapes.at(i).clear();
-    allShapes.at(i).shrink_to_fit();
     if (VERBOSE > 0) {
       logger_->info(DRT,
                     24,
@@ -848,10 +941,8 @@ void frRegionQuery::Impl::initOrigGuide(
       }
     }
   }
+  bulkLoad(allShapes, origGuides_);
   for (auto i = 0; i < numLayers; i++) {
-    origGuides_.at(i) = boost::move(RTree<frNet*>(allShapes.at(i)));
-    allShapes.at(i).clear();
-    allShapes.at(i).shrink_to_fit();
     if (VERBOSE > 0) {
       logger_->info(DRT,
                     28,
@@ -891,10 +982,8 @@ void frRegionQuery::Impl::initGuide()
       }
     }
   }
+  bulkLoad(allGuides, guides_);
   for (auto i = 0; i < numLayers; i++) {
-    guides_.at(i) = boost::move(RTree<frGuide*>(allGuides.at(i)));
-    allGuides.at(i).clear();
-    allGuides.at(i).shrink_to_fit();
     if (VERBOSE > 0) {
       logger_->info(DRT,
                     35,
@@ -942,11 +1031,7 @@ void frRegionQuery::Impl::initRPin()
     }
   }
 
-  for (auto i = 0; i < numLayers; i++) {
-    rpins_.at(i) = boost::move(RTree<frRPin*>(allRPins.at(i)));
-    allRPins.at(i).clear();
-    allRPins.at(i).shrink_to_fit();
-  }
+  bulkLoad(allRPins, rpins_);
 }
 
 void frRegionQuery::initDRObj()
@@ -963,23 +1048,21 @@ void frRegionQuery::Impl::initDRObj()
 
   ObjectsByLayer<frBlockObject> allShapes(numLayers);
 
-  for (auto& net : design_->getTopBlock()->getNets()) {
-    for (auto& shape : net->getShapes()) {
-      addDRObj(shape.get(), allShapes);
-    }
-    for (auto& via : net->getVias()) {
-      addDRObj(via.get(), allShapes);
-    }
-    for (auto& pwire : net->getPatchWires()) {
-      addDRObj(pwire.get(), allShapes);
-    }
-  }
-
-  for (auto i = 0; i < numLayers; i++) {
-    drObjs_.at(i) = boost::move(RTree<frBlockObject*>(allShapes.at(i)));
-    allShapes.at(i).clear();
-    allShapes.at(i).shrink_to_fit();
-  }
+  ProfileTask profile("RQ:initDRObj");
+  gather(design_->getTopBlock()->getNets(),
+         allShapes,
+         [this](frNet* net, ObjectsByLayer<frBlockObject>& shapes) {
+           for (auto& shape : net->getShapes()) {
+             addDRObj(shape.get(), shapes);
+           }
+           for (auto& via : net->getVias()) {
+             addDRObj(via.get(), shapes);
+           }
+           for (auto& pwire : net->getPatchWires()) {
+             addDRObj(pwire.get(), shapes);
+           }
+         });
+  bulkLoad(allShapes, drObjs_);
 }
 
 void frRegionQuery::Impl::initGRObj()
@@ -1000,11 +1083,7 @@ void frRegionQuery::Impl::initGRObj()
     }
   }
 
-  for (auto i = 0; i < numLayers; i++) {
-    grObjs_.at(i) = boost::move(RTree<grBlockObject*>(allShapes.at(i)));
-    allShapes.at(i).clear();
-    allShapes.at(i).shrink_to_fit();
-  }
+  bulkLoad(allShapes, grObjs_);
 }
 
 void frRegionQuery::initGRObj()
@@ -93,6 +93,11 @@ int FlexGCWorker::main()
   return impl_->main();
 }
 
+int FlexGCWorker::mainIncremental()
+{
+  return impl_->mainIncremental();
+}
+
 void FlexGCWorker::checkMinStep(gcPin* pin)
 {
   impl_->checkMetalShape_minStep(pin);
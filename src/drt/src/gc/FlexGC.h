@@ -70,6 +70,10 @@ class FlexGCWorker
   // others
   void init(const frDesign* design);
   int main();
+  // Checks only the area around the nets modified (updateDRNet) since the
+  // last full main() and keeps the markers found then elsewhere.  Falls
+  // back to main() when there is no full result to start from.
+  int mainIncremental();
   void end();
   void clearPWires();
   // initialization from FlexPA, initPA0 --> addPAObj --> initPA1
@@ -126,6 +126,7 @@ class FlexGCWorker::Impl
   // others
   void init(const frDesign* design);
   int main();
+  int mainIncremental();
   void end();
   // initialization from FlexPA, initPA0 --> addPAObj --> initPA1
   void initPA0(const frDesign* design);
@@ -155,6 +156,14 @@ class FlexGCWorker::Impl
   // temps
   std::vector<drNet*> modifiedDRNets_;
 
+  // incremental checking, see mainIncremental
+  bool hasCheckedMarkers_ = false;
+  std::vector<std::unique_ptr<frMarker>> checkedMarkers_;
+  // bbox of each checked marker before modifyMarkers extended it
+  std::vector<Rect> checkedMarkerBoxes_;
+  std::vector<std::pair<frLayerNum, Rect>> dirtyBoxes_;
+  std::set<frBlockObject*> dirtyOwners_;
+
   // parameters
   gcNet* targetNet_;
   frLayerNum minLayerNum_;
@@ -540,6 +549,13 @@ class FlexGCWorker::Impl
 
   void checkMetalWidthViaTable();
   void checkMetalWidthViaTable_main(gcRect* rect);
+  void checkAll();
+  // incremental checking
+  void addDirtyNet(gcNet* net);
+  bool isDirty(const frMarker& marker) const;
+  void checkIncrementalMarkers();
+  std::vector<Rect> getMarkerBoxes() const;
+  void saveCheckedMarkers(const std::vector<Rect>& markerBoxes);
   // surgical fix
   void patchMetalShape();
   void patchMetalShape_minStep();
@@ -977,6 +977,9 @@ void FlexGCWorker::Impl::updateGCWorker()
   // start init from dr objs
   for (auto fnet : fnets) {
     auto net = owner2nets_[fnet];
+    if (hasCheckedMarkers_) {
+      addDirtyNet(net);
+    }
     getWorkerRegionQuery().removeFromRegionQuery(
         net);      // delete all region queries
     net->clear();  // delete all pins and routeXXX
@@ -1013,6 +1016,9 @@ void FlexGCWorker::Impl::updateGCWorker()
     // init gc net
     initNet(net);
     getWorkerRegionQuery().addToRegionQuery(net);
+    if (hasCheckedMarkers_) {
+      addDirtyNet(net);
+    }
   }
 }
 
@@ -4086,6 +4086,18 @@ int FlexGCWorker::Impl::main()
   }
   // clear existing markers
   clearMarkers();
+  checkAll();
+  const std::vector<Rect> markerBoxes = getMarkerBoxes();
+  // modify markers for pwires
+  modifyMarkers();
+  if (!targetNet_ && getDRWorker()) {
+    saveCheckedMarkers(markerBoxes);
+  }
+  return 0;
+}
+
+void FlexGCWorker::Impl::checkAll()
+{
   // check LEF58CornerSpacing
   checkMetalCornerSpacing();
   // check Short, NSMet, MetSpc based on max rectangles
@@ -4102,9 +4114,206 @@ int FlexGCWorker::Impl::main()
   checkMinimumCut();
   // check LEF58_METALWIDTHVIATABLE
   checkMetalWidthViaTable();
-  // modify markers for pwires
+}
+
+int FlexGCWorker::Impl::mainIncremental()
+{
+  // rechecking most of the nets one by one is slower than a full check
+  if (!hasCheckedMarkers_ || targetNet_ || !getDRWorker()
+      || 2 * (dirtyOwners_.size() + modifiedDRNets_.size()) > nets_.size()) {
+    return main();
+  }
+  pwires_.clear();
+  clearMarkers();
+  if (!modifiedDRNets_.empty()) {
+    updateGCWorker();
+  }
+  // only the modified nets can need patches, the others were patched by
+  // the full check
+  std::vector<gcNet*> dirtyNets;
+  for (auto owner : dirtyOwners_) {
+    auto it = owner2nets_.find(owner);
+    if (it != owner2nets_.end()) {
+      dirtyNets.push_back(it->second);
+    }
+  }
+  if (surgicalFixEnabled_) {
+    for (auto net : dirtyNets) {
+      targetNet_ = net;
+      checkMetalShape(true);
+      if (tech_->hasVia2ViaMinStep() || tech_->hasCornerSpacingConstraint()) {
+        patchMetalShape();
+      }
+    }
+    targetNet_ = nullptr;
+    clearMarkers();
+    if (!pwires_.empty()) {
+      updateGCWorker();
+    }
+  }
+
+  // Keep the markers away from the changes.  Violations between the nets
+  // of a dropped marker or near the changes are found again below.
+  // The kept markers are added with the bbox they were found with, so
+  // addMarker drops the same violations found again, and get the extension
+  // from the earlier patches back after modifyMarkers.
+  std::vector<gcNet*> checkNets = dirtyNets;
+  std::vector<std::pair<frMarker*, Rect>> keptMarkers;
+  for (size_t i = 0; i < checkedMarkers_.size(); i++) {
+    const auto& marker = checkedMarkers_[i];
+    if (!isDirty(*marker)) {
+      auto kept = std::make_unique<frMarker>(*marker);
+      kept->setBBox(checkedMarkerBoxes_[i]);
+      keptMarkers.emplace_back(kept.get(), marker->getBBox());
+      addMarker(std::move(kept));
+      continue;
+    }
+    for (auto src : marker->getSrcs()) {
+      auto it = owner2nets_.find(src);
+      if (it != owner2nets_.end()) {
+        checkNets.push_back(it->second);
+      }
+    }
+  }
+  std::vector<rq_box_value_t<gcRect*>> result;
+  for (const auto& [layerNum, box] : dirtyBoxes_) {
+    for (frLayerNum i = std::max(layerNum - 1, getMinLayerNum());
+         i <= std::min(layerNum + 1, getMaxLayerNum());
+         i++) {
+      result.clear();
+      getWorkerRegionQuery().queryMaxRectangle(box, i, result);
+      for (auto& [rqBox, rect] : result) {
+        checkNets.push_back(rect->getNet());
+      }
+    }
+  }
+  std::sort(checkNets.begin(),
+            checkNets.end(),
+            [](gcNet* a, gcNet* b) { return a->getId() < b->getId(); });
+  checkNets.erase(std::unique(checkNets.begin(), checkNets.end()),
+                  checkNets.end());
+  // The full check skips some rules on the nets we don't route (see
+  // checkMetalWidthViaTable), the targeted check would not.  Their own
+  // shapes don't change and their violations with the other nets are found
+  // from those nets.
+  checkNets.erase(std::remove_if(checkNets.begin(),
+                                 checkNets.end(),
+                                 [](gcNet* net) {
+                                   auto fr_net = net->getFrNet();
+                                   return fr_net
+                                          && (fr_net->isSpecial()
+                                              || fr_net->getType().isSupply());
+                                 }),
+                  checkNets.end());
+
+  // the targeted checks find every violation involving the target net,
+  // addMarker drops the ones that were kept
+  for (auto net : checkNets) {
+    targetNet_ = net;
+    checkAll();
+  }
+  targetNet_ = nullptr;
+  if (logger_->debugCheck(DRT, "gc_incr", 1)) {
+    checkIncrementalMarkers();
+  }
+  const std::vector<Rect> markerBoxes = getMarkerBoxes();
   modifyMarkers();
+  for (auto& [marker, extendedBox] : keptMarkers) {
+    Rect bbox = marker->getBBox();
+    bbox.merge(extendedBox);
+    marker->setBBox(bbox);
+  }
+  saveCheckedMarkers(markerBoxes);
   return 0;
 }
 
+void FlexGCWorker::Impl::addDirtyNet(gcNet* net)
+{
+  dirtyOwners_.insert(net->getOwner());
+  for (frLayerNum i = getMinLayerNum(); i <= getMaxLayerNum(); i++) {
+    for (auto& pin : net->getPins(i)) {
+      for (auto& rect : pin->getMaxRectangles()) {
+        Rect box;
+        Rect(gtl::xl(*rect), gtl::yl(*rect), gtl::xh(*rect), gtl::yh(*rect))
+            .bloat(MTSAFEDIST, box);
+        dirtyBoxes_.emplace_back(i, box);
+      }
+    }
+  }
+}
+
+bool FlexGCWorker::Impl::isDirty(const frMarker& marker) const
+{
+  for (auto src : marker.getSrcs()) {
+    if (dirtyOwners_.find(src) != dirtyOwners_.end()) {
+      return true;
+    }
+  }
+  const Rect bbox = marker.getBBox();
+  for (const auto& [layerNum, box] : dirtyBoxes_) {
+    if (std::abs(layerNum - marker.getLayerNum()) <= 1
+        && box.intersects(bbox)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// Compares the markers of the incremental check with a full check of the
+// same geometry.
+void FlexGCWorker::Impl::checkIncrementalMarkers()
+{
+  std::set<MarkerId> incrMarkers;
+  for (auto& [id, marker] : mapMarkers_) {
+    incrMarkers.insert(id);
+  }
+  auto markers = std::move(markers_);
+  auto mapMarkers = std::move(mapMarkers_);
+  clearMarkers();
+  checkAll();
+  std::set<MarkerId> fullMarkers;
+  for (auto& [id, marker] : mapMarkers_) {
+    fullMarkers.insert(id);
+  }
+  markers_ = std::move(markers);
+  mapMarkers_ = std::move(mapMarkers);
+  auto same = [](const MarkerId& a, const MarkerId& b) {
+    return !(a < b) && !(b < a);
+  };
+  if (!std::equal(incrMarkers.begin(),
+                  incrMarkers.end(),
+                  fullMarkers.begin(),
+                  fullMarkers.end(),
+                  same)) {
+    logger_->error(DRT,
+                   630,
+                   "Incremental GC found {} markers, a full check found {}.",
+                   incrMarkers.size(),
+                   fullMarkers.size());
+  }
+}
+
+std::vector<Rect> FlexGCWorker::Impl::getMarkerBoxes() const
+{
+  std::vector<Rect> boxes;
+  boxes.reserve(markers_.size());
+  for (auto& marker : markers_) {
+    boxes.push_back(marker->getBBox());
+  }
+  return boxes;
+}
+
+void FlexGCWorker::Impl::saveCheckedMarkers(
+    const std::vector<Rect>& markerBoxes)
+{
+  checkedMarkers_.clear();
+  for (auto& marker : markers_) {
+    checkedMarkers_.push_back(std::make_unique<frMarker>(*marker));
+  }
+  checkedMarkerBoxes_ = markerBoxes;
+  dirtyBoxes_.clear();
+  dirtyOwners_.clear();
+  hasCheckedMarkers_ = true;
+}
+
 }  // namespace drt
@@ -45,6 +45,7 @@ std::string DRC_RPT_FILE;
 std::optional<int> DRC_RPT_ITER_STEP;
 std::string CMAP_FILE;
 std::string GUIDE_REPORT_FILE;
+std::string PA_CACHE_FILE;
 
 // to be removed
 int OR_SEED = -1;
@@ -69,6 +70,8 @@ bool ENABLE_VIA_GEN = true;
 bool CLEAN_PATCHES = false;
 bool DO_PA = true;
 bool SINGLE_STEP_DR = false;
+bool INCREMENTAL_DR = false;
+bool RADIX_WAVEFRONT = false;
 bool SAVE_GUIDE_UPDATES = false;
 
 std::string VIAINPIN_BOTTOMLAYER_NAME;
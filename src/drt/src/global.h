@@ -50,6 +50,7 @@ extern std::string DRC_RPT_FILE;
 extern std::optional<int> DRC_RPT_ITER_STEP;
 extern std::string CMAP_FILE;
 extern std::string GUIDE_REPORT_FILE;
+extern std::string PA_CACHE_FILE;
 // to be removed
 extern int OR_SEED;
 extern double OR_K;
@@ -72,6 +73,8 @@ extern bool ENABLE_VIA_GEN;
 extern bool CLEAN_PATCHES;
 extern bool DO_PA;
 extern bool SINGLE_STEP_DR;
+extern bool INCREMENTAL_DR;
+extern bool RADIX_WAVEFRONT;
 extern bool SAVE_GUIDE_UPDATES;
 extern std::string VIAINPIN_BOTTOMLAYER_NAME;
 extern std::string VIAINPIN_TOPLAYER_NAME;
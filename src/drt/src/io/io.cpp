@@ -960,34 +960,39 @@ void io::Parser::updateNetRouting(frNet* netIn, odb::dbNet* net)
 void io::Parser::setNets(odb::dbBlock* block)
 {
   for (auto net : block->getNets()) {
-    bool is_special = net->isSpecial();
-    if (!is_special && net->getSigType().isSupply()) {
-      logger_->error(DRT,
-                     305,
-                     "Net {} of signal type {} is not routable by TritonRoute. "
-                     "Move to special nets.",
-                     net->getName(),
-                     net->getSigType().getString());
-    }
-    std::unique_ptr<frNet> uNetIn = std::make_unique<frNet>(net->getName());
-    auto netIn = uNetIn.get();
-    if (net->getNonDefaultRule()) {
-      uNetIn->updateNondefaultRule(design_->getTech()->getNondefaultRule(
-          net->getNonDefaultRule()->getName()));
-    }
-    if (net->getSigType() == dbSigType::CLOCK) {
-      uNetIn->updateIsClock(true);
-    }
-    if (is_special) {
-      uNetIn->setIsSpecial(true);
-    }
-    updateNetRouting(netIn, net);
-    netIn->setType(net->getSigType());
-    if (is_special) {
-      getBlock()->addSNet(std::move(uNetIn));
-    } else {
-      getBlock()->addNet(std::move(uNetIn));
-    }
+    addNet(net);
+  }
+}
+
+void io::Parser::addNet(odb::dbNet* net)
+{
+  bool is_special = net->isSpecial();
+  if (!is_special && net->getSigType().isSupply()) {
+    logger_->error(DRT,
+                   305,
+                   "Net {} of signal type {} is not routable by TritonRoute. "
+                   "Move to special nets.",
+                   net->getName(),
+                   net->getSigType().getString());
+  }
+  std::unique_ptr<frNet> uNetIn = std::make_unique<frNet>(net->getName());
+  auto netIn = uNetIn.get();
+  if (net->getNonDefaultRule()) {
+    uNetIn->updateNondefaultRule(design_->getTech()->getNondefaultRule(
+        net->getNonDefaultRule()->getName()));
+  }
+  if (net->getSigType() == dbSigType::CLOCK) {
+    uNetIn->updateIsClock(true);
+  }
+  if (is_special) {
+    uNetIn->setIsSpecial(true);
+  }
+  updateNetRouting(netIn, net);
+  netIn->setType(net->getSigType());
+  if (is_special) {
+    getBlock()->addSNet(std::move(uNetIn));
+  } else {
+    getBlock()->addNet(std::move(uNetIn));
   }
 }
 
@@ -3020,7 +3025,8 @@ void io::Parser::readTechAndLibs(odb::dbDatabase* db)
   }
 }
 
-void io::Parser::updateDesign()
+void io::Parser::updateDesign(
+    const std::unordered_set<odb::dbNet*>& ripupNets)
 {
   auto block = db_->getChip()->getBlock();
   getBlock()->removeDeletedInsts();
@@ -3030,13 +3036,29 @@ void io::Parser::updateDesign()
       setInst(db_inst);
     }
   }
+  // nets removed from the block keep no routing behind
+  for (auto& net : getBlock()->getNets()) {
+    if (block->findNet(net->getName().c_str()) == nullptr) {
+      net->clearConns();
+      net->clearRoutes();
+      net->setHasInitialRouting(false);
+    }
+  }
   for (auto db_net : block->getNets()) {
     auto netIn = getBlock()->findNet(db_net->getName());
+    if (netIn == nullptr) {
+      addNet(db_net);
+      continue;
+    }
     netIn->clearConns();
     netIn->clearRPins();
     netIn->clearGuides();
     netIn->clearOrigGuides();
     updateNetRouting(netIn, db_net);
+    if (ripupNets.find(db_net) != ripupNets.end()) {
+      netIn->clearRoutes();
+      netIn->setHasInitialRouting(false);
+    }
   }
   design_->getRegionQuery()->init();
   design_->getRegionQuery()->initDRObj();
@@ -31,6 +31,7 @@
 #include <boost/icl/interval_set.hpp>
 #include <list>
 #include <memory>
+#include <unordered_set>
 
 #include "frDesign.h"
 
@@ -87,7 +88,9 @@ class Parser
   {
     return prefTrackPatterns_;
   }
-  void updateDesign();
+  // Re-reads the connectivity and routing of the block.  The routing of
+  // ripupNets is dropped so they are routed again.
+  void updateDesign(const std::unordered_set<odb::dbNet*>& ripupNets = {});
 
  private:
   frBlock* getBlock() const { return design_->getTopBlock(); }
@@ -108,6 +111,7 @@ class Parser
   void setVias(odb::dbBlock*);
   void updateNetRouting(frNet*, odb::dbNet*);
   void setNets(odb::dbBlock*);
+  void addNet(odb::dbNet*);
   void setAccessPoints(odb::dbDatabase*);
   void getSBoxCoords(odb::dbSBox*,
                      frCoord&,
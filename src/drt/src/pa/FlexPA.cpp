@@ -182,7 +182,9 @@ int FlexPA::main()
   }
 
   init();
+  loadCache();
   prep();
+  saveCache();
 
   int stdCellPinCnt = 0;
   for (auto& inst : getDesign()->getTopBlock()->getInsts()) {
@@ -99,6 +99,12 @@ class FlexPA
       uniqueInstPatterns_;
 
   UniqueInsts unique_insts_;
+  // pin access cache, indexed by unique instance; an empty key means the
+  // class is not cacheable
+  std::vector<std::string> cacheKeys_;
+  std::vector<bool> cachedUnique_;
+  std::vector<std::vector<std::vector<int>>> cachedPatterns_;
+  int numCachedUnique_ = 0;
   using UniqueMTerm = std::pair<const UniqueInsts::InstSet*, frMTerm*>;
   std::map<UniqueMTerm, bool> skip_unique_inst_term_;
 
@@ -132,6 +138,14 @@ class FlexPA
   void initTrackCoords();
   void initViaRawPriority();
   void initSkipInstTerm();
+  // cache
+  uint64_t getCacheSignature() const;
+  uint64_t getNeighborhoodSignature(frInst* inst) const;
+  void initCacheKeys();
+  void loadCache();
+  void saveCache() const;
+  bool isCached(int uniqueIdx) const;
+  void applyCachedPatterns(int uniqueIdx);
   // prep
   void prep();
   void prepPoint();
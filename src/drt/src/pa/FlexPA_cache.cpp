@@ -0,0 +1,434 @@
+/*
+ * Copyright (c) 2024, The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the University nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE REGENTS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <omp.h>
+
+#include <boost/functional/hash.hpp>
+#include <boost/serialization/string.hpp>
+#include <fstream>
+
+#include "FlexPA.h"
+#include "distributed/frArchive.h"
+#include "frProfileTask.h"
+#include "serialization.h"
+#include "utl/exception.h"
+
+namespace drt {
+
+using utl::ThreadException;
+
+namespace {
+
+// Bump when the contents of the cache change.
+constexpr int cacheVersion = 1;
+
+// Pin access of one unique instance class.  Access points are relative to
+// the instance origin (as left by revertAccessPoints) and are stored for
+// every pin of every inst term in master order.  Patterns hold, for each pin
+// of the non-skipped inst terms, the index of the chosen access point or -1.
+struct CacheEntry
+{
+  std::vector<std::unique_ptr<frPinAccess>> pinAccess;
+  std::vector<std::vector<int>> patterns;
+
+  template <class Archive>
+  void serialize(Archive& ar, const unsigned int version)
+  {
+    (ar) & pinAccess;
+    (ar) & patterns;
+  }
+};
+
+using Cache = std::map<std::string, CacheEntry>;
+
+template <typename Fig>
+void hashFigs(size_t& sig, const std::vector<std::unique_ptr<Fig>>& figs)
+{
+  for (auto& fig : figs) {
+    const Rect box = fig->getBBox();
+    boost::hash_combine(sig, static_cast<frShape*>(fig.get())->getLayerNum());
+    boost::hash_combine(sig, box.xMin());
+    boost::hash_combine(sig, box.yMin());
+    boost::hash_combine(sig, box.xMax());
+    boost::hash_combine(sig, box.yMax());
+  }
+}
+
+}  // namespace
+
+// Everything outside of the unique instances that changes the pin access
+// result: settings, tech geometry and the geometry of every master.  A cache
+// written with a different signature is ignored.
+uint64_t FlexPA::getCacheSignature() const
+{
+  size_t sig = 0;
+  boost::hash_combine(sig, cacheVersion);
+  boost::hash_combine(sig, DBPROCESSNODE);
+  boost::hash_combine(sig, BOTTOM_ROUTING_LAYER);
+  boost::hash_combine(sig, TOP_ROUTING_LAYER);
+  boost::hash_combine(sig, VIAINPIN_BOTTOMLAYERNUM);
+  boost::hash_combine(sig, VIAINPIN_TOPLAYERNUM);
+  boost::hash_combine(sig, MINNUMACCESSPOINT_STDCELLPIN);
+  boost::hash_combine(sig, MINNUMACCESSPOINT_MACROCELLPIN);
+  boost::hash_combine(sig, ENABLE_VIA_GEN);
+  auto tech = getTech();
+  for (auto& layer : tech->getLayers()) {
+    boost::hash_combine(sig, layer->getName());
+    boost::hash_combine(sig, layer->getType().getString());
+    boost::hash_combine(sig, layer->getDir().getString());
+    boost::hash_combine(sig, layer->getWidth());
+    boost::hash_combine(sig, layer->getMinWidth());
+    boost::hash_combine(sig, layer->getWrongDirWidth());
+    boost::hash_combine(sig, layer->getPitch());
+    boost::hash_combine(sig, layer->getNumMasks());
+    if (layer->getType() == dbTechLayerType::ROUTING) {
+      const frCoord width = layer->getMinWidth();
+      boost::hash_combine(sig,
+                          layer->getMinSpacingValue(width, width, 0, true));
+      if (layer->getAreaConstraint() != nullptr) {
+        boost::hash_combine(sig, layer->getAreaConstraint()->getMinArea());
+      }
+    }
+  }
+  // The values of the other rules are not hashed, only which rules exist.
+  for (int i = 0; tech->getConstraint(i) != nullptr; i++) {
+    boost::hash_combine(sig, (int) tech->getConstraint(i)->typeId());
+  }
+  for (auto& via : tech->getVias()) {
+    boost::hash_combine(sig, via->getName());
+    hashFigs(sig, via->getLayer1Figs());
+    hashFigs(sig, via->getCutFigs());
+    hashFigs(sig, via->getLayer2Figs());
+  }
+  for (auto& master : getDesign()->getMasters()) {
+    boost::hash_combine(sig, master->getName());
+    const Rect box = master->getBBox();
+    boost::hash_combine(sig, box.dx());
+    boost::hash_combine(sig, box.dy());
+    for (auto& term : master->getTerms()) {
+      boost::hash_combine(sig, term->getName());
+      for (auto& pin : term->getPins()) {
+        hashFigs(sig, pin->getFigs());
+      }
+    }
+    for (auto& blockage : master->getBlockages()) {
+      hashFigs(sig, blockage->getPin()->getFigs());
+    }
+  }
+  return sig;
+}
+
+// The fixed shapes seen by the pin access checks around the unique instance,
+// relative to its origin.  This includes the instance's own pins and
+// obstructions so a changed master misses the cache too.
+uint64_t FlexPA::getNeighborhoodSignature(frInst* inst) const
+{
+  auto tech = getTech();
+  frLayerNum maxLayerNum = tech->getBottomLayerNum();
+  for (auto& instTerm : inst->getInstTerms()) {
+    for (auto& pin : instTerm->getTerm()->getPins()) {
+      for (auto& fig : pin->getFigs()) {
+        maxLayerNum = std::max(
+            maxLayerNum, static_cast<frShape*>(fig.get())->getLayerNum());
+      }
+    }
+  }
+  // vias up from the top pin layer reach two layers above it
+  maxLayerNum = std::min(maxLayerNum + 2, tech->getTopLayerNum());
+
+  // prepPoint checks 5 pitches around each access point and
+  // genPatterns_gc 3000 dbu around each pattern.
+  frCoord extension = 3000;
+  for (frLayerNum lNum = tech->getBottomLayerNum(); lNum <= maxLayerNum;
+       lNum++) {
+    auto layer = tech->getLayer(lNum);
+    if (layer->getType() == dbTechLayerType::ROUTING) {
+      extension = std::max(extension, 5 * (frCoord) layer->getPitch());
+    }
+  }
+
+  const Point origin = inst->getOrigin();
+  Rect box = inst->getBBox();
+  box.bloat(extension, box);
+
+  // Summed so the result doesn't depend on the query order.
+  size_t sig = 0;
+  auto regionQuery = getDesign()->getRegionQuery();
+  frRegionQuery::Objects<frBlockObject> result;
+  for (frLayerNum lNum = tech->getBottomLayerNum(); lNum <= maxLayerNum;
+       lNum++) {
+    result.clear();
+    regionQuery->query(box, lNum, result);
+    for (auto& [rect, obj] : result) {
+      size_t shape = 0;
+      boost::hash_combine(shape, lNum);
+      boost::hash_combine(shape, (int) obj->typeId());
+      boost::hash_combine(shape, rect.xMin() - origin.x());
+      boost::hash_combine(shape, rect.yMin() - origin.y());
+      boost::hash_combine(shape, rect.xMax() - origin.x());
+      boost::hash_combine(shape, rect.yMax() - origin.y());
+      sig += shape;
+    }
+  }
+  return sig;
+}
+
+void FlexPA::initCacheKeys()
+{
+  ProfileTask profile("PA:cacheKeys");
+  const auto& unique = unique_insts_.getUnique();
+  cacheKeys_.clear();
+  cacheKeys_.resize(unique.size());
+
+  omp_set_num_threads(MAX_THREADS);
+  ThreadException exception;
+#pragma omp parallel for schedule(dynamic)
+  for (int i = 0; i < (int) unique.size(); i++) {  // NOLINT
+    try {
+      frInst* inst = unique[i];
+      const std::vector<frCoord>* offsets
+          = unique_insts_.getTrackOffsets(inst);
+      if (offsets == nullptr) {
+        continue;
+      }
+      std::string key = fmt::format("{} {} ",
+                                    inst->getMaster()->getName(),
+                                    inst->getOrient().getString());
+      for (frCoord offset : *offsets) {
+        key += fmt::format("{},", offset);
+      }
+      // skipped terms get no access points
+      for (auto& instTerm : inst->getInstTerms()) {
+        key += isSkipInstTerm(instTerm.get()) ? '0' : '1';
+      }
+      key += fmt::format(" {:x}", getNeighborhoodSignature(inst));
+      cacheKeys_[i] = std::move(key);
+    } catch (...) {
+      exception.capture();
+    }
+  }
+  exception.rethrow();
+}
+
+bool FlexPA::isCached(const int uniqueIdx) const
+{
+  return uniqueIdx < (int) cachedUnique_.size() && cachedUnique_[uniqueIdx];
+}
+
+void FlexPA::loadCache()
+{
+  const auto& unique = unique_insts_.getUnique();
+  cachedUnique_.assign(unique.size(), false);
+  cachedPatterns_.clear();
+  cachedPatterns_.resize(unique.size());
+  numCachedUnique_ = 0;
+  if (PA_CACHE_FILE.empty()) {
+    return;
+  }
+
+  ProfileTask profile("PA:loadCache");
+  initCacheKeys();
+
+  std::ifstream file(PA_CACHE_FILE);
+  if (!file) {
+    return;
+  }
+  int version = 0;
+  uint64_t signature = 0;
+  Cache cache;
+  try {
+    frIArchive ar(file);
+    ar.setDesign(design_);
+    registerTypes(ar);
+    ar >> version;
+    if (version == cacheVersion) {
+      ar >> signature;
+      if (signature == getCacheSignature()) {
+        ar >> cache;
+      }
+    }
+  } catch (std::exception& e) {
+    logger_->warn(DRT,
+                  618,
+                  "Unable to read pin access cache {}: {}",
+                  PA_CACHE_FILE,
+                  e.what());
+    return;
+  }
+  if (version != cacheVersion || signature != getCacheSignature()) {
+    logger_->info(DRT,
+                  619,
+                  "Pin access cache {} was written with different settings "
+                  "and is ignored.",
+                  PA_CACHE_FILE);
+    return;
+  }
+
+  for (int i = 0; i < (int) unique.size(); i++) {
+    auto it = cache.find(cacheKeys_[i]);
+    if (cacheKeys_[i].empty() || it == cache.end()) {
+      continue;
+    }
+    frInst* inst = unique[i];
+    CacheEntry& entry = it->second;
+
+    // Check the entry against the master before using it.
+    std::vector<frPin*> pins;
+    std::vector<frPinAccess*> patternPins;
+    size_t paIdx = 0;
+    for (auto& instTerm : inst->getInstTerms()) {
+      const bool skip = isSkipInstTerm(instTerm.get());
+      for (auto& pin : instTerm->getTerm()->getPins()) {
+        pins.push_back(pin.get());
+        if (!skip && paIdx < entry.pinAccess.size()) {
+          patternPins.push_back(entry.pinAccess[paIdx].get());
+        }
+        paIdx++;
+      }
+    }
+    bool valid = pins.size() == entry.pinAccess.size();
+    for (const auto& pattern : entry.patterns) {
+      valid = valid && pattern.size() == patternPins.size();
+      for (size_t p = 0; valid && p < pattern.size(); p++) {
+        valid = pattern[p] < patternPins[p]->getNumAccessPoints();
+      }
+    }
+    if (!valid) {
+      continue;
+    }
+
+    const int uniquePAIdx = unique_insts_.getPAIndex(inst);
+    for (size_t p = 0; p < pins.size(); p++) {
+      pins[p]->setPinAccess(uniquePAIdx, std::move(entry.pinAccess[p]));
+    }
+    cachedPatterns_[i] = std::move(entry.patterns);
+    cachedUnique_[i] = true;
+    numCachedUnique_++;
+  }
+
+  if (VERBOSE > 0) {
+    logger_->info(DRT,
+                  620,
+                  "Reused pin access of {} of {} unique instances from {}.",
+                  numCachedUnique_,
+                  unique.size(),
+                  PA_CACHE_FILE);
+  }
+}
+
+// Rebuilds the patterns of a cached unique instance from the access point
+// indices the same way genPatterns_commit builds them.
+void FlexPA::applyCachedPatterns(const int uniqueIdx)
+{
+  frInst* inst = unique_insts_.getUnique(uniqueIdx);
+  const int paIdx = unique_insts_.getPAIndex(inst);
+  for (const auto& indices : cachedPatterns_[uniqueIdx]) {
+    auto pattern = std::make_unique<FlexPinAccessPattern>();
+    frAccessPoint* leftAP = nullptr;
+    frAccessPoint* rightAP = nullptr;
+    frCoord leftPt = std::numeric_limits<frCoord>::max();
+    frCoord rightPt = std::numeric_limits<frCoord>::min();
+    size_t idx = 0;
+    for (auto& instTerm : inst->getInstTerms()) {
+      if (isSkipInstTerm(instTerm.get())) {
+        continue;
+      }
+      for (auto& pin : instTerm->getTerm()->getPins()) {
+        const int apIdx = indices[idx++];
+        if (apIdx < 0) {
+          pattern->addAccessPoint(nullptr);
+          continue;
+        }
+        frAccessPoint* ap = pin->getPinAccess(paIdx)->getAccessPoint(apIdx);
+        const Point pt = ap->getPoint();
+        if (pt.x() < leftPt) {
+          leftAP = ap;
+          leftPt = pt.x();
+        }
+        if (pt.x() > rightPt) {
+          rightAP = ap;
+          rightPt = pt.x();
+        }
+        pattern->addAccessPoint(ap);
+      }
+    }
+    pattern->setBoundaryAP(true, leftAP);
+    pattern->setBoundaryAP(false, rightAP);
+    pattern->updateCost();
+    uniqueInstPatterns_[uniqueIdx].push_back(std::move(pattern));
+  }
+}
+
+void FlexPA::saveCache() const
+{
+  if (PA_CACHE_FILE.empty()) {
+    return;
+  }
+  ProfileTask profile("PA:saveCache");
+  const auto& unique = unique_insts_.getUnique();
+  Cache cache;
+  for (int i = 0; i < (int) unique.size(); i++) {
+    if (cacheKeys_[i].empty()) {
+      continue;
+    }
+    frInst* inst = unique[i];
+    const int paIdx = unique_insts_.getPAIndex(inst);
+    CacheEntry& entry = cache[cacheKeys_[i]];
+    for (auto& instTerm : inst->getInstTerms()) {
+      for (auto& pin : instTerm->getTerm()->getPins()) {
+        entry.pinAccess.push_back(
+            std::make_unique<frPinAccess>(*pin->getPinAccess(paIdx)));
+      }
+    }
+    if (i >= (int) uniqueInstPatterns_.size()) {
+      continue;
+    }
+    for (const auto& pattern : uniqueInstPatterns_[i]) {
+      std::vector<int> indices;
+      indices.reserve(pattern->getPattern().size());
+      for (frAccessPoint* ap : pattern->getPattern()) {
+        indices.push_back(ap ? ap->getId() : -1);
+      }
+      entry.patterns.push_back(std::move(indices));
+    }
+  }
+
+  std::ofstream file(PA_CACHE_FILE);
+  if (!file) {
+    logger_->warn(
+        DRT, 621, "Unable to write pin access cache {}.", PA_CACHE_FILE);
+    return;
+  }
+  frOArchive ar(file);
+  registerTypes(ar);
+  const uint64_t signature = getCacheSignature();
+  ar << cacheVersion;
+  ar << signature;
+  ar << cache;
+}
+
+}  // namespace drt
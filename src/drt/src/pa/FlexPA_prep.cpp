@@ -1549,6 +1549,9 @@ void FlexPA::prepPoint()
           && masterType != dbMasterType::RING) {
         continue;
       }
+      if (isCached(i)) {
+        continue;
+      }
       ProfileTask profile("PA:uniqueInstance");
       for (auto& instTerm : inst->getInstTerms()) {
         // only do for normal and clock terms
@@ -1765,6 +1768,10 @@ void FlexPA::prepPattern()
           && masterType != dbMasterType::CORE_ANTENNACELL) {
         continue;
       }
+      if (isCached(currUniqueInstIdx)) {
+        applyCachedPatterns(currUniqueInstIdx);
+        continue;
+      }
 
       int numValidPattern = prepPattern_inst(inst, currUniqueInstIdx, 1.0);
 
@@ -1868,6 +1875,10 @@ void FlexPA::revertAccessPoints()
 {
   const auto& unique = unique_insts_.getUnique();
   for (auto& inst : unique) {
+    // cached access points are already relative to the origin
+    if (isCached(unique_insts_.getIndex(inst))) {
+      continue;
+    }
     const dbTransform xform = inst->getTransform();
     const Point offset(xform.getOffset());
     dbTransform revertXform;
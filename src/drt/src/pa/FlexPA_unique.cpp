@@ -186,6 +186,7 @@ void UniqueInsts::computeUnique(
       for (auto& [vec, insts] : offsetMap) {
         auto uniqueInst = *(insts.begin());
         unique_.push_back(uniqueInst);
+        unique2offsets_[uniqueInst] = &vec;
         for (auto i : insts) {
           inst2unique_[i] = uniqueInst;
           inst2Class_[i] = &insts;
@@ -297,6 +298,13 @@ std::set<frInst*, frBlockObjectComp>* UniqueInsts::getClass(frInst* inst) const
   return inst2Class_.at(inst);
 }
 
+const std::vector<frCoord>* UniqueInsts::getTrackOffsets(
+    frInst* unique_inst) const
+{
+  auto it = unique2offsets_.find(unique_inst);
+  return it == unique2offsets_.end() ? nullptr : it->second;
+}
+
 bool UniqueInsts::hasUnique(frInst* inst) const
 {
   return inst2unique_.find(inst) != inst2unique_.end();
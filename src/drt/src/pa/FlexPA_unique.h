@@ -60,6 +60,9 @@ class UniqueInsts
 
   // Gets the instances in the equivalence set of the given inst
   InstSet* getClass(frInst* inst) const;
+  // Gets the track offsets of the class of the given unique inst.  NDR
+  // instances are their own class and have none.
+  const std::vector<frCoord>* getTrackOffsets(frInst* unique_inst) const;
 
   const std::vector<frInst*>& getUnique() const;
   frInst* getUnique(int idx) const;
@@ -101,6 +104,9 @@ class UniqueInsts
   std::unordered_map<frInst*, InstSet*> inst2Class_;
   // Maps a unique instance to its pin access index
   std::map<frInst*, int, frBlockObjectComp> unique2paidx_;
+  // Maps a unique instance to the track offsets of its class
+  std::map<frInst*, const std::vector<frCoord>*, frBlockObjectComp>
+      unique2offsets_;
   // Maps a unique instance to its index in unique_
   std::map<frInst*, int, frBlockObjectComp> unique2Idx_;
   // master orient track-offset to instances
@@ -814,6 +814,7 @@ void serializeGlobals(Archive& ar)
   (ar) & SHAPEBLOATWIDTH;
   (ar) & HISTCOST;
   (ar) & CONGCOST;
+  (ar) & RADIX_WAVEFRONT;
 }
 
 }  // namespace drt
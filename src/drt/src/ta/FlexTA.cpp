@@ -32,7 +32,11 @@
 
 #include <algorithm>
 #include <chrono>
+#include <condition_variable>
+#include <functional>
 #include <iostream>
+#include <mutex>
+#include <queue>
 #include <sstream>
 
 #include "FlexTA_graphics.h"
@@ -69,7 +73,14 @@ int FlexTAWorker::main_mt()
     std::cout << ss.str();
   }
 
-  init();
+  {
+    // Other workers may be saving their results to the guides in end().
+    std::shared_lock<std::shared_mutex> design_lock;
+    if (design_mutex_) {
+      design_lock = std::shared_lock<std::shared_mutex>(*design_mutex_);
+    }
+    init();
+  }
   if (isInitTA()) {
     hardIroutesMode = true;
     sortIroutes();
@@ -119,7 +130,7 @@ int FlexTA::initTA_helper(int iter,
   auto& ygp = gCellPatterns.at(1);
   int sol = 0;
   numPanels = 0;
-  std::vector<std::vector<std::unique_ptr<FlexTAWorker>>> workers;
+  std::vector<std::unique_ptr<FlexTAWorker>> workers;
   if (isH) {
     for (int i = offset; i < (int) ygp.getCount(); i += size) {
       auto uworker
@@ -137,10 +148,7 @@ int FlexTA::initTA_helper(int iter,
       worker.setExtBox(extBox);
       worker.setDir(dbTechLayerDir::HORIZONTAL);
       worker.setTAIter(iter);
-      if (workers.empty() || (int) workers.back().size() >= BATCHSIZETA) {
-        workers.emplace_back(std::vector<std::unique_ptr<FlexTAWorker>>());
-      }
-      workers.back().emplace_back(std::move(uworker));
+      workers.push_back(std::move(uworker));
     }
   } else {
     for (int i = offset; i < (int) xgp.getCount(); i += size) {
@@ -159,38 +167,99 @@ int FlexTA::initTA_helper(int iter,
       worker.setExtBox(extBox);
       worker.setDir(dbTechLayerDir::VERTICAL);
       worker.setTAIter(iter);
-      if (workers.empty() || (int) workers.back().size() >= BATCHSIZETA) {
-        workers.emplace_back(std::vector<std::unique_ptr<FlexTAWorker>>());
+      workers.push_back(std::move(uworker));
+    }
+  }
+
+  // Panels used to be run in batches of BATCHSIZETA with a barrier after
+  // each batch: the panels of a batch are assigned from the same state and
+  // the next batch sees all of their guides.  Only adjacent panels overlap,
+  // so the same result is reached by letting a panel wait just for its
+  // neighbor in the previous batch and by saving a panel only once its
+  // neighbors in the same batch have been assigned.  The result does not
+  // depend on the number of threads.
+  const int numWorkers = workers.size();
+  auto batch = [](int idx) { return idx / BATCHSIZETA; };
+  // task 2 * i assigns panel i, task 2 * i + 1 saves it to the guides
+  std::vector<int> numPending(2 * numWorkers, 0);
+  std::vector<std::vector<int>> dependents(2 * numWorkers);
+  auto addDependency = [&](int task, int dependent) {
+    numPending[dependent]++;
+    dependents[task].push_back(dependent);
+  };
+  for (int i = 0; i < numWorkers; i++) {
+    addDependency(2 * i, 2 * i + 1);
+    if (i > 0) {
+      if (batch(i - 1) == batch(i)) {
+        addDependency(2 * (i - 1), 2 * i + 1);
+        addDependency(2 * i, 2 * (i - 1) + 1);
+      } else {
+        addDependency(2 * (i - 1) + 1, 2 * i);
       }
-      workers.back().push_back(std::move(uworker));
+    }
+  }
+  std::priority_queue<int, std::vector<int>, std::greater<>> ready;
+  for (int task = 0; task < 2 * numWorkers; task++) {
+    if (numPending[task] == 0) {
+      ready.push(task);
     }
   }
 
-  omp_set_num_threads(std::min(8, MAX_THREADS));
-  // parallel execution
-  // multi thread
-  for (auto& workerBatch : workers) {
-    ProfileTask profile("TA:batch");
-    utl::ThreadException exception;
-#pragma omp parallel for schedule(dynamic)
-    for (int i = 0; i < (int) workerBatch.size(); i++) {
+  std::mutex readyMutex;
+  std::condition_variable readyCond;
+  int numRemaining = 2 * numWorkers;
+  bool failed = false;
+  std::shared_mutex designMutex;
+  utl::ThreadException exception;
+  omp_set_num_threads(MAX_THREADS);
+#pragma omp parallel
+  {
+    while (true) {
+      int task;
+      {
+        std::unique_lock<std::mutex> lock(readyMutex);
+        readyCond.wait(lock, [&]() {
+          return !ready.empty() || numRemaining == 0 || failed;
+        });
+        if (ready.empty() || failed) {
+          break;
+        }
+        task = ready.top();
+        ready.pop();
+      }
+      bool ok = true;
       try {
-        workerBatch[i]->main_mt();
-#pragma omp critical
-        {
-          sol += workerBatch[i]->getNumAssigned();
+        auto& worker = workers[task / 2];
+        if (task % 2 == 0) {
+          ProfileTask profile("TA:assign");
+          worker->setDesignMutex(&designMutex);
+          worker->main_mt();
+        } else {
+          ProfileTask profile("TA:end");
+          std::unique_lock<std::shared_mutex> lock(designMutex);
+          worker->end();
+          sol += worker->getNumAssigned();
           numPanels++;
+          worker.reset();
         }
       } catch (...) {
         exception.capture();
+        ok = false;
       }
+      {
+        std::unique_lock<std::mutex> lock(readyMutex);
+        failed |= !ok;
+        numRemaining--;
+        for (int dependent : dependents[task]) {
+          if (--numPending[dependent] == 0) {
+            ready.push(dependent);
+          }
+        }
+      }
+      readyCond.notify_all();
     }
-    exception.rethrow();
-    for (auto& worker : workerBatch) {
-      worker->end();
-    }
-    workerBatch.clear();
   }
+  exception.rethrow();
   return sol;
 }
 
@@ -30,6 +30,7 @@
 
 #include <memory>
 #include <set>
+#include <shared_mutex>
 
 #include "db/obj/frVia.h"
 #include "db/taObj/taPin.h"
@@ -133,6 +134,8 @@ class FlexTAWorker
   void setExtBox(const Rect& boxIn) { extBox_ = boxIn; }
   void setDir(const dbTechLayerDir& in) { dir_ = in; }
   void setTAIter(int in) { taIter_ = in; }
+  // Held shared while reading the design in main_mt()
+  void setDesignMutex(std::shared_mutex* in) { design_mutex_ = in; }
   void addIroute(std::unique_ptr<taPin> in, bool isExt = false)
   {
     in->setId(iroutes_.size() + extIroutes_.size());
@@ -201,6 +204,7 @@ class FlexTAWorker
   Rect extBox_;
   dbTechLayerDir dir_;
   int taIter_;
+  std::shared_mutex* design_mutex_ = nullptr;
   FlexTAWorkerRegionQuery rq_;
 
   std::vector<std::unique_ptr<taPin>> iroutes_;  // unsorted iroutes
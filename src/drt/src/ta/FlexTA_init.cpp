@@ -544,6 +544,11 @@ void FlexTAWorker::initIroutes()
     result.clear();
     regionQuery->queryGuide(getExtBox(), lNum, result);
     for (auto& [boostb, guide] : result) {
+      // routed nets are left untouched in incremental mode
+      if (INCREMENTAL_DR && guide->getNet()
+          && guide->getNet()->hasInitialRouting()) {
+        continue;
+      }
       initIroute(guide);
     }
   }
@@ -0,0 +1,33 @@
+# detailed_route -incremental after resizing a routed instance
+source "helpers.tcl"
+
+read_lef testcase/ispd18_sample/ispd18_sample.input.lef
+read_def testcase/ispd18_sample/ispd18_sample.input.def
+read_guides testcase/ispd18_sample/ispd18_sample.input.guide
+
+set drc_file [make_result_file detailed_route_incremental1.drc.rpt]
+
+detailed_route -output_drc $drc_file -verbose 0
+set full_drvs [detailed_route_num_drvs]
+
+set block [ord::get_db_block]
+[$block findInst inst5638] swapMaster [[ord::get_db] findMaster BUFX3]
+
+detailed_route -output_drc $drc_file -verbose 0 -incremental
+set incremental_drvs [detailed_route_num_drvs]
+
+set errors {}
+foreach net [$block getNets] {
+  if { [$net getSigType] == "SIGNAL" && [$net getWire] == "NULL" } {
+    lappend errors "net [$net getName] is not routed"
+  }
+}
+if { $incremental_drvs > $full_drvs } {
+  lappend errors "$incremental_drvs DRVs after the incremental run"
+}
+
+if { [llength $errors] == 0 } {
+  puts "pass"
+} else {
+  puts "fail: [join $errors {, }]"
+}
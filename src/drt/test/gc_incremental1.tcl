@@ -0,0 +1,15 @@
+# compare the incremental GC markers with a full check in every DR worker
+source "helpers.tcl"
+
+read_lef testcase/ispd18_sample/ispd18_sample.input.lef
+read_def testcase/ispd18_sample/ispd18_sample.input.def
+read_guides testcase/ispd18_sample/ispd18_sample.input.guide
+
+set_debug_level DRT gc_incr 1
+
+set drc_file [make_result_file gc_incremental1.drc.rpt]
+if { [catch { detailed_route -output_drc $drc_file -verbose 0 } error] } {
+  puts "fail: $error"
+} else {
+  puts "pass"
+}
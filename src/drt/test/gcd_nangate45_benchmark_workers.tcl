@@ -0,0 +1,4 @@
+# Runs the workers dumped by gcd_nangate45_dump_worker.tcl several times
+# and reports the time per phase.
+source "helpers.tcl"
+detailed_route_benchmark_workers -dump_dir results -repeat 3
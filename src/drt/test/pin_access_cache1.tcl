@@ -0,0 +1,41 @@
+# pin access read back from -pin_access_cache matches an uncached run
+source "helpers.tcl"
+
+proc write_access_points { file_name } {
+  set stream [open $file_name w]
+  foreach inst [[ord::get_db_block] getInsts] {
+    foreach iterm [$inst getITerms] {
+      foreach ap [$iterm getPrefAccessPoints] {
+        puts $stream \
+          "[$iterm getName] [[$ap getLayer] getName] [$ap getPoint]"
+      }
+    }
+  }
+  close $stream
+}
+
+read_lef testcase/ispd18_sample/ispd18_sample.input.lef
+read_def testcase/ispd18_sample/ispd18_sample.input.def
+
+set cache_file [make_result_file pin_access_cache1.cache]
+set ap_file [make_result_file pin_access_cache1.ap]
+set ap_file_miss [make_result_file pin_access_cache1-miss.ap]
+set ap_file_hit [make_result_file pin_access_cache1-hit.ap]
+file delete $cache_file
+
+pin_access
+write_access_points $ap_file
+
+# The first run with the cache fills it, the second one reads it.
+pin_access -pin_access_cache $cache_file
+write_access_points $ap_file_miss
+pin_access -pin_access_cache $cache_file
+write_access_points $ap_file_hit
+
+if { [file size $ap_file] > 0
+     && ![diff_files $ap_file $ap_file_miss]
+     && ![diff_files $ap_file $ap_file_hit] } {
+  puts "pass"
+} else {
+  puts "fail"
+}
@@ -14,5 +14,8 @@ record_tests {
   #drt_readme_msgs_check
 }
 record_pass_fail_tests {
+  detailed_route_incremental1
+  gc_incremental1
   gc_test
+  pin_access_cache1
 }
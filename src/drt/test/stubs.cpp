@@ -69,11 +69,11 @@ OpenRoad* OpenRoad::openRoad()
   return nullptr;
 }
 
-void OpenRoad::writeDb(const char*)
+void OpenRoad::writeDb(const char*, bool)
 {
 }
 
-void OpenRoad::readDb(const char*)
+void OpenRoad::readDb(const char*, bool)
 {
 }
 
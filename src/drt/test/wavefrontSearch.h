@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) 2024, The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the University nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE REGENTS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#pragma once
+
+#include <algorithm>
+#include <random>
+#include <tuple>
+#include <vector>
+
+#include "dr/FlexWavefront.h"
+
+namespace drt {
+
+// The fields FlexWavefrontGrid::operator< orders on (dist is always 0
+// here).  Grids with the same key are equivalent to the queue and may pop
+// in any order.
+using WavefrontKey = std::tuple<frCost, frMIdx, frCost>;
+
+inline WavefrontKey getWavefrontKey(const FlexWavefrontGrid& grid)
+{
+  return {grid.getCost(), grid.z(), grid.getPathCost()};
+}
+
+// Replays a maze-search-like pattern: every popped grid pushes a few
+// successors whose cost is mostly, but not always, above its own.  Returns
+// the keys in pop order.
+inline std::vector<WavefrontKey> runWavefrontSearch(FlexWavefront& wavefront,
+                                                    int numPops)
+{
+  std::mt19937 rng(42);
+  std::uniform_int_distribution<int> step(-20, 400);
+  std::uniform_int_distribution<int> small(0, 3);
+  std::vector<WavefrontKey> popped;
+  wavefront.cleanup();
+  for (int i = 0; i < 8; ++i) {
+    const frCost cost = 1000 + small(rng);
+    wavefront.push({i, 0, small(rng), 0, 0, false, 0, 0, 0, cost});
+  }
+  while (!wavefront.empty() && (int) popped.size() < numPops) {
+    const FlexWavefrontGrid curr = wavefront.top();
+    wavefront.pop();
+    popped.push_back(getWavefrontKey(curr));
+    for (int i = 0; i < 3; ++i) {
+      const frCost cost = std::max<int>(curr.getCost() + step(rng), 0);
+      wavefront.push({curr.x() + 1,
+                      curr.y() + i,
+                      small(rng),
+                      0,
+                      0,
+                      false,
+                      0,
+                      0,
+                      curr.getPathCost() + small(rng),
+                      cost});
+    }
+  }
+  return popped;
+}
+
+}  // namespace drt
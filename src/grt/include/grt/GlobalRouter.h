@@ -190,6 +190,8 @@ class GlobalRouter : public ant::GlobalRouteSource
   void saveGuides();
   void writeSegments(const char* file_name);
   void readSegments(const char* file_name);
+  void writeState(const char* file_name);
+  void readState(const char* file_name);
   bool netIsCovered(odb::dbNet* db_net, std::string& pins_not_covered);
   bool segmentIsLine(const GSegment& segment);
   bool segmentCoversPin(const GSegment& segment, const Pin& pin);
@@ -310,6 +312,7 @@ class GlobalRouter : public ant::GlobalRouteSource
  private:
   // Net functions
   Net* addNet(odb::dbNet* db_net);
+  Net* createNet(odb::dbNet* db_net);
   void removeNet(odb::dbNet* db_net);
 
   void applyAdjustments(int min_routing_layer, int max_routing_layer);
@@ -355,6 +358,7 @@ class GlobalRouter : public ant::GlobalRouteSource
                                               odb::Point& pos_on_grid);
   int getNetMaxRoutingLayer(const Net* net);
   void findPins(Net* net);
+  void findPins(const std::vector<Net*>& nets);
   void findFastRoutePins(Net* net,
                          std::vector<RoutePt>& pins_on_grid,
                          int& root_idx);
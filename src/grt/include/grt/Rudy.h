@@ -68,6 +68,16 @@ class Rudy
    * */
   void calculateRudy();
 
+  /**
+   * Update the Rudy of the nets whose terminal bounding box changed, or that
+   * were created or destroyed, since the last `calculateRudy` or
+   * `updateRudy`. Falls back to `calculateRudy` when most nets changed.
+   * Tile values may differ from a new `calculateRudy` by rounding errors.
+   * The resource reductions of blockages and layer adjustments are not
+   * recomputed, use `calculateRudy` after those changed.
+   * */
+  void updateRudy();
+
   /**
    * Set the grid area and grid numbers.
    * Default value will be the die area of block and (40, 40), respectively.
@@ -79,7 +89,7 @@ class Rudy
    * If the layer which name is metal1 and it has getWidth value, then this
    * function will not applied, but it will apply that information.
    * */
-  void setWireWidth(int wire_width) { wire_width_ = wire_width; }
+  void setWireWidth(int wire_width);
 
   const Tile& getTile(int x, int y) const { return grid_.at(x).at(y); }
   std::pair<int, int> getGridSize() const;
@@ -92,7 +102,20 @@ class Rudy
   void makeGrid();
   void getResourceReductions();
   Tile& getEditableTile(int x, int y) { return grid_.at(x).at(y); }
-  void processIntersectionSignalNet(odb::Rect net_rect);
+  odb::Rect getNetRect(odb::dbNet* net) const;
+  void calculateRudy(std::vector<odb::Rect> net_rects);
+  void processIntersectionSignalNet(const odb::Rect& net_rect,
+                                    int min_column,
+                                    int max_column);
+  void addNetRudyDiff(std::vector<double>& rudy_diff,
+                      const odb::Rect& net_rect,
+                      float sign) const;
+  void addTilesRudyDiff(std::vector<double>& rudy_diff,
+                        int min_x,
+                        int max_x,
+                        int min_y,
+                        int max_y,
+                        double rudy) const;
 
   odb::dbBlock* block_;
   odb::Rect grid_block_;
@@ -102,6 +125,9 @@ class Rudy
   int wire_width_ = 100;
   int tile_size_ = 0;
   std::vector<std::vector<Tile>> grid_;
+  // Terminal bounding box of each net, by net id, as of the last update.
+  // Empty until the first calculateRudy.
+  std::vector<odb::Rect> net_rects_;
 };
 
 }  // namespace grt
@@ -36,6 +36,7 @@
 
 %{
 #include "grt/GlobalRouter.h"
+#include "grt/Rudy.h"
 
 using namespace grt;
 
@@ -44,6 +45,9 @@ using namespace grt;
 %include "../../Exception-py.i"
 
 %include <std_string.i>
+%include <std_pair.i>
+
+%template(IntPair) std::pair<int, int>;
 
 %ignore grt::GlobalRouter::init;
 %ignore grt::GlobalRouter::initDebugFastRoute;
@@ -51,3 +55,4 @@ using namespace grt;
 %ignore grt::GlobalRouter::setRenderer;
 
 %include "grt/GlobalRouter.h"
+%include "grt/Rudy.h"
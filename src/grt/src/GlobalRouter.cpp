@@ -35,6 +35,8 @@
 
 #include "grt/GlobalRouter.h"
 
+#include <omp.h>
+
 #include <algorithm>
 #include <boost/icl/interval.hpp>
 #include <cmath>
@@ -72,6 +74,8 @@
 #include "stt/SteinerTreeBuilder.h"
 #include "utl/Logger.h"
 #include "utl/algorithms.h"
+#include "utl/exception.h"
+#include "utl/timer.h"
 
 namespace grt {
 
@@ -184,9 +188,14 @@ std::vector<Net*> GlobalRouter::initFastRoute(int min_routing_layer,
   initCoreGrid(max_routing_layer);
   setCapacities(min_routing_layer, max_routing_layer);
 
+  utl::Timer timer;
   std::vector<Net*> nets = findNets();
+  debugPrint(
+      logger_, GRT, "init", 1, "Find nets and pins: {:.3f}s", timer.elapsed());
   checkPinPlacement();
+  timer.reset();
   initNetlist(nets);
+  debugPrint(logger_, GRT, "init", 1, "Init netlist: {:.3f}s", timer.elapsed());
 
   applyAdjustments(min_routing_layer, max_routing_layer);
   perturbCapacities();
@@ -197,12 +206,26 @@ std::vector<Net*> GlobalRouter::initFastRoute(int min_routing_layer,
 void GlobalRouter::applyAdjustments(int min_routing_layer,
                                     int max_routing_layer)
 {
+  utl::Timer timer;
   fastroute_->initEdges();
   computeGridAdjustments(min_routing_layer, max_routing_layer);
+  debugPrint(
+      logger_, GRT, "init", 1, "Grid adjustments: {:.3f}s", timer.elapsed());
+  timer.reset();
   computeTrackAdjustments(min_routing_layer, max_routing_layer);
+  debugPrint(
+      logger_, GRT, "init", 1, "Track adjustments: {:.3f}s", timer.elapsed());
+  timer.reset();
   computeObstructionsAdjustments();
   std::vector<int> track_space = grid_->getTrackPitches();
   fastroute_->initBlockedIntervals(track_space);
+  debugPrint(logger_,
+             GRT,
+             "init",
+             1,
+             "Obstruction adjustments: {:.3f}s",
+             timer.elapsed());
+  timer.reset();
   computeUserGlobalAdjustments(min_routing_layer, max_routing_layer);
   computeUserLayerAdjustments(max_routing_layer);
 
@@ -213,6 +236,8 @@ void GlobalRouter::applyAdjustments(int min_routing_layer,
   }
   addResourcesForPinAccess();
   fastroute_->initAuxVar();
+  debugPrint(
+      logger_, GRT, "init", 1, "Other adjustments: {:.3f}s", timer.elapsed());
 }
 
 // If file name is specified, save congestion report file.
@@ -950,7 +975,7 @@ void GlobalRouter::findPins(Net* net)
     // this way, the result based on drt APs is maintained
     if (!has_access_points && pinOverlapsWithSingleTrack(pin, pos_on_grid)) {
       const int conn_layer = pin.getConnectionLayer();
-      odb::dbTechLayer* layer = routing_layers_[conn_layer];
+      odb::dbTechLayer* layer = routing_layers_.at(conn_layer);
       pos_on_grid = grid_->getPositionOnGrid(pos_on_grid);
       if (!(pos_on_grid == pin_position)
           && ((layer->getDirection() == odb::dbTechLayerDir::HORIZONTAL
@@ -965,6 +990,22 @@ void GlobalRouter::findPins(Net* net)
   }
 }
 
+void GlobalRouter::findPins(const std::vector<Net*>& nets)
+{
+  // Placing the pins of a net on the grid only reads the db and the grid.
+  const int num_threads = db_->getThreadCount();
+  utl::ThreadException exception;
+#pragma omp parallel for schedule(dynamic, 64) num_threads(num_threads)
+  for (int i = 0; i < nets.size(); i++) {
+    try {
+      findPins(nets[i]);
+    } catch (...) {
+      exception.capture();
+    }
+  }
+  exception.rethrow();
+}
+
 int GlobalRouter::getNetMaxRoutingLayer(const Net* net)
 {
   return net->getSignalType() == odb::dbSigType::CLOCK
@@ -2381,6 +2422,94 @@ void GlobalRouter::readSegments(const char* file_name)
   }
 }
 
+void GlobalRouter::writeState(const char* file_name)
+{
+  if (routes_.empty()) {
+    logger_->error(
+        GRT, 272, "Run global_route before writing the global route state.");
+  }
+
+  std::ofstream out(file_name);
+  if (!out) {
+    logger_->error(
+        GRT, 273, "Global route state file {} could not be opened.", file_name);
+  }
+  fastroute_->writeState(out);
+}
+
+void GlobalRouter::readState(const char* file_name)
+{
+  if (db_->getChip() == nullptr || db_->getChip()->getBlock() == nullptr
+      || db_->getTech() == nullptr) {
+    logger_->error(GRT, 274, "Load design before reading the route state.");
+  }
+
+  std::ifstream in(file_name);
+  if (!in.is_open()) {
+    logger_->error(
+        GRT, 275, "Failed to open global route state file {}.", file_name);
+  }
+
+  clear();
+  block_ = db_->getChip()->getBlock();
+
+  int min_layer, max_layer;
+  getMinMaxLayer(min_layer, max_layer);
+  std::vector<Net*> nets = initFastRoute(min_layer, max_layer);
+
+  std::vector<odb::dbNet*> unrouted_db_nets;
+  NetRouteMap routes = fastroute_->readState(in, unrouted_db_nets);
+
+  const std::set<odb::dbNet*> unrouted(unrouted_db_nets.begin(),
+                                       unrouted_db_nets.end());
+  std::vector<Net*> restored_nets;
+  std::vector<Net*> unrouted_nets;
+  for (Net* net : nets) {
+    if (unrouted.find(net->getDbNet()) != unrouted.end()) {
+      unrouted_nets.push_back(net);
+    } else {
+      restored_nets.push_back(net);
+    }
+  }
+
+  // Same post processing findRouting applies to the routes from fastroute.
+  addRemainingGuides(routes, restored_nets, min_layer, max_layer);
+  connectPadPins(routes);
+  for (auto& [db_net, route] : routes) {
+    mergeSegments(db_net_map_[db_net]->getPins(), route);
+  }
+  routes_ = std::move(routes);
+
+  if (verbose_) {
+    logger_->info(GRT,
+                  276,
+                  "Restored routes of {} nets, rerouting {} nets.",
+                  routes_.size(),
+                  unrouted_nets.size());
+  }
+
+  // Nets that changed since the state was written are routed over the
+  // restored ones, as in incremental global routing.
+  if (!unrouted_nets.empty()) {
+    const float old_critical_nets_percentage
+        = fastroute_->getCriticalNetsPercentage();
+    fastroute_->setVerbose(false);
+    fastroute_->setCriticalNetsPercentage(0);
+    fastroute_->setCongestionReportIterStep(0);
+
+    initFastRouteIncr(unrouted_nets);
+    NetRouteMap new_routes = findRouting(unrouted_nets, min_layer, max_layer);
+    mergeResults(new_routes);
+
+    fastroute_->setCriticalNetsPercentage(old_critical_nets_percentage);
+    fastroute_->setCongestionReportIterStep(congestion_report_iter_step_);
+    fastroute_->setVerbose(verbose_);
+  }
+
+  updateDbCongestion();
+  computeWirelength();
+}
+
 bool GlobalRouter::netIsCovered(odb::dbNet* db_net,
                                 std::string& pins_not_covered)
 {
@@ -2936,7 +3065,7 @@ bool GlobalRouter::pinOverlapsWithSingleTrack(const Pin& pin,
   int conn_layer = pin.getConnectionLayer();
   std::vector<odb::Rect> pin_boxes = pin.getBoxes().at(conn_layer);
 
-  odb::dbTechLayer* layer = routing_layers_[conn_layer];
+  odb::dbTechLayer* layer = routing_layers_.at(conn_layer);
   RoutingTracks tracks = getRoutingTracksByIndex(conn_layer);
 
   odb::Rect pin_rect;
@@ -3286,15 +3415,18 @@ std::vector<Net*> GlobalRouter::findNets()
     db_nets = nets_to_route_;
   }
   std::vector<Net*> clk_nets;
+  std::vector<Net*> new_nets;
   for (odb::dbNet* db_net : db_nets) {
-    Net* net = addNet(db_net);
+    Net* net = createNet(db_net);
     // add clock nets not connected to a leaf first
     if (net) {
+      new_nets.push_back(net);
       bool is_non_leaf_clock = isNonLeafClock(net->getDbNet());
       if (is_non_leaf_clock)
         clk_nets.push_back(net);
     }
   }
+  findPins(new_nets);
 
   std::vector<Net*> non_clk_nets;
   for (auto [ignored, net] : db_net_map_) {
@@ -3316,6 +3448,16 @@ std::vector<Net*> GlobalRouter::findNets()
 }
 
 Net* GlobalRouter::addNet(odb::dbNet* db_net)
+{
+  Net* net = createNet(db_net);
+  if (net) {
+    findPins(net);
+  }
+  return net;
+}
+
+// Creates the net and its pins without placing the pins on the grid.
+Net* GlobalRouter::createNet(odb::dbNet* db_net)
 {
   if (!db_net->getSigType().isSupply() && !db_net->isSpecial()
       && db_net->getSWires().empty() && !db_net->isConnectedByAbutment()) {
@@ -3323,7 +3465,6 @@ Net* GlobalRouter::addNet(odb::dbNet* db_net)
     db_net_map_[db_net] = net;
     makeItermPins(net, db_net, grid_->getGridArea());
     makeBtermPins(net, db_net, grid_->getGridArea());
-    findPins(net);
     return net;
   }
   return nullptr;
@@ -3724,27 +3865,72 @@ void GlobalRouter::extendObstructions(
   }
 }
 
+// Runs collect(i, result) for every i in [0, count) on num_threads threads
+// and then apply(i, result) in index order on the calling thread, so the
+// outcome does not depend on the number of threads.  Works in chunks to bound
+// the memory held by the results.
+template <typename Result, typename Collect, typename Apply>
+static void collectInParallel(const int count,
+                              const int num_threads,
+                              const Collect& collect,
+                              const Apply& apply)
+{
+  const int chunk_size = 1024 * num_threads;
+  std::vector<Result> results;
+  for (int begin = 0; begin < count; begin += chunk_size) {
+    const int end = std::min(begin + chunk_size, count);
+    results.clear();
+    results.resize(end - begin);
+    utl::ThreadException exception;
+#pragma omp parallel for schedule(dynamic, 16) num_threads(num_threads)
+    for (int i = begin; i < end; i++) {
+      try {
+        collect(i, results[i - begin]);
+      } catch (...) {
+        exception.capture();
+      }
+    }
+    exception.rethrow();
+    for (int i = begin; i < end; i++) {
+      apply(i, results[i - begin]);
+    }
+  }
+}
+
 int GlobalRouter::findInstancesObstructions(
     odb::Rect& die_area,
     const std::vector<int>& layer_extensions,
     std::map<int, std::vector<odb::Rect>>& layer_obs_map)
 {
+  // The shapes an instance blocks, in the order they are applied.  The first
+  // num_macro_obs shapes are extended macro obstructions.
+  struct InstObstructions
+  {
+    bool is_macro = false;
+    int obstructions_cnt = 0;
+    int num_macro_obs = 0;
+    int blockages_outside_die = 0;
+    std::vector<std::pair<odb::Rect, odb::dbTechLayer*>> shapes;
+    std::vector<odb::dbMTerm*> pins_outside_die;
+  };
+
   int macros_cnt = 0;
   int obstructions_cnt = 0;
   int pin_out_of_die_count = 0;
   odb::dbTech* tech = db_->getTech();
-  for (odb::dbInst* inst : block_->getInsts()) {
+  odb::dbSet<odb::dbInst> block_insts = block_->getInsts();
+  const std::vector<odb::dbInst*> insts(block_insts.begin(),
+                                        block_insts.end());
+
+  auto collect = [&](const int i, InstObstructions& result) {
+    odb::dbInst* inst = insts[i];
     odb::dbMaster* master = inst->getMaster();
 
     const odb::dbTransform transform = inst->getTransform();
 
-    bool isMacro = false;
-    if (master->isBlock()) {
-      macros_cnt++;
-      isMacro = true;
-    }
+    result.is_macro = master->isBlock();
 
-    if (isMacro) {
+    if (result.is_macro) {
       std::unordered_map<int, std::vector<odb::Rect>> macro_obs_per_layer;
       int bottom_layer = std::numeric_limits<int>::max();
       int top_layer = std::numeric_limits<int>::min();
@@ -3756,7 +3942,7 @@ int GlobalRouter::findInstancesObstructions(
           transform.apply(rect);
 
           macro_obs_per_layer[layer].push_back(rect);
-          obstructions_cnt++;
+          result.obstructions_cnt++;
 
           bottom_layer = std::min(bottom_layer, layer);
           top_layer = std::max(top_layer, layer);
@@ -3765,7 +3951,7 @@ int GlobalRouter::findInstancesObstructions(
 
       extendObstructions(macro_obs_per_layer, bottom_layer, top_layer);
 
-      // iterate all Rects for each layer and apply adjustment in FastRoute
+      // extend all Rects for each layer before applying them in FastRoute
       for (auto& [layer, obs] : macro_obs_per_layer) {
         odb::dbTechLayer* tech_layer = tech->findRoutingLayer(layer);
         int layer_extension = layer_extensions[layer];
@@ -3779,10 +3965,10 @@ int GlobalRouter::findInstancesObstructions(
             cur_obs.set_xlo(cur_obs.xMin() - layer_extension);
             cur_obs.set_xhi(cur_obs.xMax() + layer_extension);
           }
-          layer_obs_map[layer].push_back(cur_obs);
-          applyObstructionAdjustment(cur_obs, tech->findRoutingLayer(layer));
+          result.shapes.emplace_back(cur_obs, tech_layer);
         }
       }
+      result.num_macro_obs = result.shapes.size();
     } else {
       for (odb::dbBox* box : master->getObstructions()) {
         int layer = box->getTechLayer()->getRoutingLevel();
@@ -3794,15 +3980,10 @@ int GlobalRouter::findInstancesObstructions(
           odb::Point upper_bound = odb::Point(rect.xMax(), rect.yMax());
           odb::Rect obstruction_rect = odb::Rect(lower_bound, upper_bound);
           if (!die_area.contains(obstruction_rect)) {
-            if (verbose_)
-              logger_->warn(GRT,
-                            38,
-                            "Found blockage outside die area in instance {}.",
-                            inst->getConstName());
+            result.blockages_outside_die++;
           }
-          odb::dbTechLayer* tech_layer = box->getTechLayer();
-          applyObstructionAdjustment(obstruction_rect, tech_layer);
-          obstructions_cnt++;
+          result.shapes.emplace_back(obstruction_rect, box->getTechLayer());
+          result.obstructions_cnt++;
         }
       }
     }
@@ -3832,20 +4013,48 @@ int GlobalRouter::findInstancesObstructions(
             pin_box = odb::Rect(lower_bound, upper_bound);
             if (!die_area.contains(pin_box)
                 && !mterm->getSigType().isSupply()) {
-              logger_->warn(GRT,
-                            39,
-                            "Found pin {} outside die area in instance {}.",
-                            mterm->getConstName(),
-                            inst->getConstName());
-              pin_out_of_die_count++;
+              result.pins_outside_die.push_back(mterm);
             }
-            odb::dbTechLayer* tech_layer = box->getTechLayer();
-            applyObstructionAdjustment(pin_box, tech_layer);
+            result.shapes.emplace_back(pin_box, tech_layer);
           }
         }
       }
     }
-  }
+  };
+
+  auto apply = [&](const int i, const InstObstructions& result) {
+    odb::dbInst* inst = insts[i];
+    if (result.is_macro) {
+      macros_cnt++;
+    }
+    obstructions_cnt += result.obstructions_cnt;
+    if (verbose_) {
+      for (int j = 0; j < result.blockages_outside_die; j++) {
+        logger_->warn(GRT,
+                      38,
+                      "Found blockage outside die area in instance {}.",
+                      inst->getConstName());
+      }
+    }
+    for (odb::dbMTerm* mterm : result.pins_outside_die) {
+      logger_->warn(GRT,
+                    39,
+                    "Found pin {} outside die area in instance {}.",
+                    mterm->getConstName(),
+                    inst->getConstName());
+      pin_out_of_die_count++;
+    }
+    for (int j = 0; j < result.shapes.size(); j++) {
+      const auto& [rect, tech_layer] = result.shapes[j];
+      if (j < result.num_macro_obs) {
+        layer_obs_map[tech_layer->getRoutingLevel()].push_back(rect);
+      }
+      applyObstructionAdjustment(rect, tech_layer);
+    }
+  };
+
+  collectInParallel<InstObstructions>(
+      insts.size(), db_->getThreadCount(), collect, apply);
 
   if (pin_out_of_die_count > 0) {
     if (verbose_)
@@ -3860,17 +4069,23 @@ int GlobalRouter::findInstancesObstructions(
 
 void GlobalRouter::findNetsObstructions(odb::Rect& die_area)
 {
+  using NetShapes = std::vector<std::pair<odb::Rect, odb::dbTechLayer*>>;
+
   odb::dbSet<odb::dbNet> nets = block_->getNets();
 
   if (nets.empty()) {
     logger_->error(GRT, 94, "Design with no nets.");
   }
 
-  for (odb::dbNet* db_net : nets) {
+  const std::vector<odb::dbNet*> db_nets(nets.begin(), nets.end());
+
+  // Decodes the wires of a net into the shapes they block.
+  auto collect = [&](const int i, NetShapes& shapes) {
+    odb::dbNet* db_net = db_nets[i];
     odb::uint wire_cnt = 0, via_cnt = 0;
     db_net->getWireCount(wire_cnt, via_cnt);
     if (wire_cnt == 0)
-      continue;
+      return;
 
     std::vector<odb::dbShape> via_boxes;
     if (db_net->getSigType().isSupply()) {
@@ -3883,13 +4098,10 @@ void GlobalRouter::findNetsObstructions(odb::Rect& die_area)
               if (tech_layer->getRoutingLevel() == 0) {
                 continue;
               }
-              odb::Rect via_rect = box.getBox();
-              applyNetObstruction(via_rect, tech_layer, die_area, db_net);
+              shapes.emplace_back(box.getBox(), tech_layer);
             }
           } else {
-            odb::Rect wire_rect = s->getBox();
-            odb::dbTechLayer* tech_layer = s->getTechLayer();
-            applyNetObstruction(wire_rect, tech_layer, die_area, db_net);
+            shapes.emplace_back(s->getBox(), s->getTechLayer());
           }
         }
       }
@@ -3909,19 +4121,24 @@ void GlobalRouter::findNetsObstructions(odb::Rect& die_area)
               if (tech_layer->getRoutingLevel() == 0) {
                 continue;
               }
-              odb::Rect via_rect = box.getBox();
-              applyNetObstruction(via_rect, tech_layer, die_area, db_net);
+              shapes.emplace_back(box.getBox(), tech_layer);
             }
           } else {
-            odb::Rect wire_rect = shape.getBox();
-            odb::dbTechLayer* tech_layer = shape.getTechLayer();
-
-            applyNetObstruction(wire_rect, tech_layer, die_area, db_net);
+            shapes.emplace_back(shape.getBox(), shape.getTechLayer());
           }
         }
       }
     }
-  }
+  };
+
+  auto apply = [&](const int i, const NetShapes& shapes) {
+    for (const auto& [rect, tech_layer] : shapes) {
+      applyNetObstruction(rect, tech_layer, die_area, db_nets[i]);
+    }
+  };
+
+  collectInParallel<NetShapes>(
+      db_nets.size(), db_->getThreadCount(), collect, apply);
 }
 
 void GlobalRouter::applyNetObstruction(const odb::Rect& rect,
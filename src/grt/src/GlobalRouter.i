@@ -303,6 +303,16 @@ void read_segments(const char* file_name)
   getGlobalRouter()->readSegments(file_name);
 }
 
+void write_state(const char* file_name)
+{
+  getGlobalRouter()->writeState(file_name);
+}
+
+void read_state(const char* file_name)
+{
+  getGlobalRouter()->readState(file_name);
+}
+
 } // namespace
 
 %} // inline
@@ -422,6 +422,28 @@ proc read_global_route_segments { args } {
   grt::read_segments $file_name
 }
 
+sta::define_cmd_args "write_global_route_state" { file_name }
+
+proc write_global_route_state { args } {
+  sta::parse_key_args "write_global_route_state" args \
+    keys {} \
+    flags {}
+  sta::check_argc_eq1 "write_global_route_state" $args
+  set file_name $args
+  grt::write_state $file_name
+}
+
+sta::define_cmd_args "read_global_route_state" { file_name }
+
+proc read_global_route_state { args } {
+  sta::parse_key_args "read_global_route_state" args \
+    keys {} \
+    flags {}
+  sta::check_argc_eq1 "read_global_route_state" $args
+  set file_name $args
+  grt::read_state $file_name
+}
+
 sta::define_cmd_args "global_route_debug" {
   [-st]       # Show the Steiner Tree generated by stt
   [-rst]      # Show the Rectilinear Steiner Tree generated by FastRoute
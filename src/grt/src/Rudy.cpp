@@ -32,10 +32,16 @@
 
 #include "grt/Rudy.h"
 
+#include <omp.h>
+
+#include <algorithm>
+#include <utility>
+
 #include "grt/GRoute.h"
 #include "grt/GlobalRouter.h"
 #include "odb/dbShape.h"
 #include "utl/Logger.h"
+#include "utl/exception.h"
 
 namespace grt {
 
@@ -83,6 +89,13 @@ void Rudy::setGridConfig(odb::Rect block, int tile_cnt_x, int tile_cnt_y)
   grid_block_ = block;
   tile_cnt_x_ = tile_cnt_x;
   tile_cnt_y_ = tile_cnt_y;
+  net_rects_.clear();
+}
+
+void Rudy::setWireWidth(int wire_width)
+{
+  wire_width_ = wire_width;
+  net_rects_.clear();
 }
 
 void Rudy::makeGrid()
@@ -130,6 +143,25 @@ void Rudy::getResourceReductions()
 
 void Rudy::calculateRudy()
 {
+  if (grid_.empty()) {
+    return;
+  }
+
+  std::vector<odb::Rect> net_rects;
+  for (odb::dbNet* net : block_->getNets()) {
+    const size_t net_id = net->getId();
+    if (net_id >= net_rects.size()) {
+      net_rects.resize(net_id + 1);
+    }
+    net_rects[net_id] = getNetRect(net);
+  }
+  calculateRudy(std::move(net_rects));
+}
+
+void Rudy::calculateRudy(std::vector<odb::Rect> net_rects)
+{
+  net_rects_ = std::move(net_rects);
+
   // Clear previous computation
   for (auto& grid_column : grid_) {
     for (auto& tile : grid_column) {
@@ -140,19 +172,109 @@ void Rudy::calculateRudy()
   getResourceReductions();
 
   // refer: https://ieeexplore.ieee.org/document/4211973
-  for (auto net : block_->getNets()) {
-    if (!net->getSigType().isSupply()) {
-      const auto net_rect = net->getTermBBox();
-      processIntersectionSignalNet(net_rect);
+  // Each thread owns a block of tile columns and adds all the nets, in net
+  // order, to them. Every tile then sums the same values in the same order
+  // as a serial run, without a copy of the grid per thread.
+  const int num_threads
+      = std::min(tile_cnt_x_, block_->getDb()->getThreadCount());
+  utl::ThreadException exception;
+#pragma omp parallel num_threads(std::max(1, num_threads))
+  {
+    const int thread = omp_get_thread_num();
+    const int thread_count = omp_get_num_threads();
+    const int min_column = tile_cnt_x_ * thread / thread_count;
+    const int max_column = tile_cnt_x_ * (thread + 1) / thread_count - 1;
+    try {
+      for (const odb::Rect& net_rect : net_rects_) {
+        processIntersectionSignalNet(net_rect, min_column, max_column);
+      }
+    } catch (...) {
+      exception.capture();
     }
   }
+  exception.rethrow();
+}
+
+void Rudy::updateRudy()
+{
+  if (grid_.empty()) {
+    return;
+  }
+  if (net_rects_.empty()) {
+    calculateRudy();
+    return;
+  }
+
+  std::vector<odb::Rect> net_rects;
+  size_t num_nets = 0;
+  for (odb::dbNet* net : block_->getNets()) {
+    const size_t net_id = net->getId();
+    if (net_id >= net_rects.size()) {
+      net_rects.resize(net_id + 1);
+    }
+    net_rects[net_id] = getNetRect(net);
+    num_nets++;
+  }
+  // Created or destroyed nets have an empty rect on one side.
+  const size_t max_size = std::max(net_rects.size(), net_rects_.size());
+  net_rects.resize(max_size);
+  net_rects_.resize(max_size);
+  std::vector<int> changed_nets;
+  for (size_t net_id = 0; net_id < max_size; net_id++) {
+    if (net_rects[net_id] != net_rects_[net_id]) {
+      changed_nets.push_back(net_id);
+    }
+  }
+
+  // Removing and adding back most of the nets costs as much as a new
+  // calculation and accumulates rounding errors.
+  if (changed_nets.size() * 2 > num_nets) {
+    calculateRudy(std::move(net_rects));
+    return;
+  }
+  if (changed_nets.empty()) {
+    return;
+  }
+
+  // Each changed net is removed and added back in O(1) in a 2D difference
+  // array, which one prefix sum pass turns into the change of every tile.
+  std::vector<double> rudy_diff((tile_cnt_x_ + 1) * (tile_cnt_y_ + 1), 0.0);
+  for (const int net_id : changed_nets) {
+    addNetRudyDiff(rudy_diff, net_rects_[net_id], -1);
+    addNetRudyDiff(rudy_diff, net_rects[net_id], 1);
+  }
+  net_rects_ = std::move(net_rects);
+
+  std::vector<double> sums(tile_cnt_y_, 0.0);
+  for (int x = 0; x < tile_cnt_x_; x++) {
+    double column_sum = 0;
+    for (int y = 0; y < tile_cnt_y_; y++) {
+      column_sum += rudy_diff[x * (tile_cnt_y_ + 1) + y];
+      sums[y] += column_sum;
+      getEditableTile(x, y).addRudy(sums[y]);
+    }
+  }
+}
+
+odb::Rect Rudy::getNetRect(odb::dbNet* net) const
+{
+  if (net->getSigType().isSupply()) {
+    return odb::Rect();
+  }
+  const odb::Rect net_rect = net->getTermBBox();
+  if (net_rect.isInverted() || net_rect.area() == 0) {
+    // TODO: handle nets with 0 area from getTermBBox()
+    return odb::Rect();
+  }
+  return net_rect;
 }
 
-void Rudy::processIntersectionSignalNet(const odb::Rect net_rect)
+void Rudy::processIntersectionSignalNet(const odb::Rect& net_rect,
+                                        const int min_column,
+                                        const int max_column)
 {
   const auto net_area = net_rect.area();
   if (net_area == 0) {
-    // TODO: handle nets with 0 area from getTermBBox()
     return;
   }
   const auto hpwl = static_cast<float>(net_rect.dx() + net_rect.dy());
@@ -160,10 +282,10 @@ void Rudy::processIntersectionSignalNet(const odb::Rect net_rect)
   const auto net_congestion = wire_area / net_area;
 
   // Calculate the intersection range
-  const int min_x_index
-      = std::max(0, (net_rect.xMin() - grid_block_.xMin()) / tile_size_);
+  const int min_x_index = std::max(
+      min_column, (net_rect.xMin() - grid_block_.xMin()) / tile_size_);
   const int max_x_index = std::min(
-      tile_cnt_x_ - 1, (net_rect.xMax() - grid_block_.xMin()) / tile_size_);
+      max_column, (net_rect.xMax() - grid_block_.xMin()) / tile_size_);
   const int min_y_index
       = std::max(0, (net_rect.yMin() - grid_block_.yMin()) / tile_size_);
   const int max_y_index = std::min(
@@ -186,6 +308,125 @@ void Rudy::processIntersectionSignalNet(const odb::Rect net_rect)
   }
 }
 
+void Rudy::addTilesRudyDiff(std::vector<double>& rudy_diff,
+                            const int min_x,
+                            const int max_x,
+                            const int min_y,
+                            const int max_y,
+                            const double rudy) const
+{
+  const int row_size = tile_cnt_y_ + 1;
+  rudy_diff[min_x * row_size + min_y] += rudy;
+  rudy_diff[min_x * row_size + max_y + 1] -= rudy;
+  rudy_diff[(max_x + 1) * row_size + min_y] -= rudy;
+  rudy_diff[(max_x + 1) * row_size + max_y + 1] += rudy;
+}
+
+namespace {
+
+// A range of tiles along one axis covered by the same fraction of their
+// length.
+struct TileSpan
+{
+  int min;
+  int max;
+  float ratio;
+};
+
+float overlapRatio(const int net_min,
+                   const int net_max,
+                   const int tile_min,
+                   const int tile_max)
+{
+  const int overlap = std::min(net_max, tile_max) - std::max(net_min, tile_min);
+  return std::max(0, overlap) / static_cast<float>(tile_max - tile_min);
+}
+
+// Tiles strictly between the first and the last one are fully covered.
+int makeSpans(const int min_index,
+              const int max_index,
+              const float min_ratio,
+              const float max_ratio,
+              TileSpan spans[3])
+{
+  if (min_index == max_index) {
+    spans[0] = {min_index, min_index, min_ratio};
+    return 1;
+  }
+  int count = 0;
+  spans[count++] = {min_index, min_index, min_ratio};
+  if (max_index - min_index > 1) {
+    spans[count++] = {min_index + 1, max_index - 1, 1.0f};
+  }
+  spans[count++] = {max_index, max_index, max_ratio};
+  return count;
+}
+
+}  // namespace
+
+void Rudy::addNetRudyDiff(std::vector<double>& rudy_diff,
+                          const odb::Rect& net_rect,
+                          const float sign) const
+{
+  const auto net_area = net_rect.area();
+  if (net_area == 0) {
+    return;
+  }
+  const auto hpwl = static_cast<float>(net_rect.dx() + net_rect.dy());
+  const auto wire_area = hpwl * wire_width_;
+  const auto net_congestion = wire_area / net_area;
+
+  const int min_x_index
+      = std::max(0, (net_rect.xMin() - grid_block_.xMin()) / tile_size_);
+  const int max_x_index = std::min(
+      tile_cnt_x_ - 1, (net_rect.xMax() - grid_block_.xMin()) / tile_size_);
+  const int min_y_index
+      = std::max(0, (net_rect.yMin() - grid_block_.yMin()) / tile_size_);
+  const int max_y_index = std::min(
+      tile_cnt_y_ - 1, (net_rect.yMax() - grid_block_.yMin()) / tile_size_);
+  if (min_x_index > max_x_index || min_y_index > max_y_index) {
+    return;
+  }
+
+  // The fraction of a tile covered by the net is the product of its x and
+  // y overlap ratios, so the range splits into at most 3x3 blocks of tiles
+  // with the same Rudy, each added in O(1) to the difference array.
+  const odb::Rect min_tile = getTile(min_x_index, min_y_index).getRect();
+  const odb::Rect max_tile = getTile(max_x_index, max_y_index).getRect();
+  TileSpan x_spans[3];
+  TileSpan y_spans[3];
+  const int x_count = makeSpans(
+      min_x_index,
+      max_x_index,
+      overlapRatio(
+          net_rect.xMin(), net_rect.xMax(), min_tile.xMin(), min_tile.xMax()),
+      overlapRatio(
+          net_rect.xMin(), net_rect.xMax(), max_tile.xMin(), max_tile.xMax()),
+      x_spans);
+  const int y_count = makeSpans(
+      min_y_index,
+      max_y_index,
+      overlapRatio(
+          net_rect.yMin(), net_rect.yMax(), min_tile.yMin(), min_tile.yMax()),
+      overlapRatio(
+          net_rect.yMin(), net_rect.yMax(), max_tile.yMin(), max_tile.yMax()),
+      y_spans);
+
+  for (int i = 0; i < x_count; i++) {
+    for (int j = 0; j < y_count; j++) {
+      const TileSpan& x_span = x_spans[i];
+      const TileSpan& y_span = y_spans[j];
+      const auto rudy = net_congestion * x_span.ratio * y_span.ratio * 100;
+      addTilesRudyDiff(rudy_diff,
+                       x_span.min,
+                       x_span.max,
+                       y_span.min,
+                       y_span.max,
+                       sign * rudy);
+    }
+  }
+}
+
 std::pair<int, int> Rudy::getGridSize() const
 {
   if (grid_.empty()) {
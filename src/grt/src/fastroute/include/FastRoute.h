@@ -40,6 +40,7 @@
 #include <boost/icl/interval.hpp>
 #include <boost/icl/interval_set.hpp>
 #include <boost/multi_array.hpp>
+#include <iosfwd>
 #include <set>
 #include <unordered_map>
 #include <vector>
@@ -93,6 +94,29 @@ struct DebugSetting
 
 using stt::Tree;
 
+// Work arrays of the 2D maze routing, one per thread
+struct MazeScratch
+{
+  multi_array<double, 2> d1;
+  multi_array<double, 2> d2;
+  std::vector<bool> pop_heap2;
+  std::vector<double*> src_heap;
+  std::vector<double*> dest_heap;
+  multi_array<short, 2> parent_x1;
+  multi_array<short, 2> parent_y1;
+  multi_array<short, 2> parent_x3;
+  multi_array<short, 2> parent_y3;
+  multi_array<bool, 2> hv;
+  multi_array<bool, 2> hyper_v;
+  multi_array<bool, 2> hyper_h;
+  multi_array<int, 2> corr_edge;
+  multi_array<bool, 2> in_region;
+  std::vector<OrderNetEdge> net_eo;
+  // gcells whose edge usage was increased, merged after each batch
+  std::vector<std::pair<int, int>> h_used_ggrid;
+  std::vector<std::pair<int, int>> v_used_ggrid;
+};
+
 class FastRouteCore
 {
  public:
@@ -103,6 +127,9 @@ class FastRouteCore
 
   void clear();
   void saveCongestion(int iter = -1);
+  void writeState(std::ostream& out);
+  NetRouteMap readState(std::istream& in,
+                        std::vector<odb::dbNet*>& unrouted_nets);
   void setGridsAndLayers(int x, int y, int nLayers);
   void addVCapacity(short verticalCapacity, int layer);
   void addHCapacity(short horizontalCapacity, int layer);
@@ -262,6 +289,25 @@ class FastRouteCore
                      const int slope,
                      const int L,
                      float& slack_th);
+  bool mazeRouteNet(const int netID,
+                    const odb::Rect& footprint,
+                    const int iter,
+                    const int expand,
+                    const float cost_height,
+                    const int ripup_threshold,
+                    const int maze_edge_threshold,
+                    const int cost_type,
+                    const float logis_cof,
+                    const int via,
+                    const int slope,
+                    const int L,
+                    const float slack_th,
+                    int& last_enlarge,
+                    MazeScratch& scratch);
+  odb::Rect getMazeFootprint(const int netID, const int expand);
+  std::vector<std::vector<int>> getMazeBatches(
+      const std::vector<odb::Rect>& footprints);
+  void initMazeScratch(MazeScratch& scratch);
   void convertToMazeroute();
   void updateCongestionHistory(const int upType, bool stopDEC, int& max_adj);
   int getOverflow2D(int* maxOverflow);
@@ -298,10 +344,7 @@ class FastRouteCore
   void convertToMazerouteNet(const int netID);
   void setupHeap(const int netID,
                  const int edgeID,
-                 std::vector<double*>& src_heap,
-                 std::vector<double*>& dest_heap,
-                 multi_array<double, 2>& d1,
-                 multi_array<double, 2>& d2,
+                 MazeScratch& scratch,
                  const int regionX1,
                  const int regionX2,
                  const int regionY1,
@@ -441,6 +484,7 @@ class FastRouteCore
                       int edgeID,
                       multi_array<double, 2>& d1,
                       multi_array<double, 2>& d2,
+                      const std::vector<double>& cost_table,
                       int threshold,
                       int enlarge);
 
@@ -475,6 +519,7 @@ class FastRouteCore
   bool newRipup3DType3(const int netID, const int edgeID);
   void newRipupNet(const int netID);
   void releaseNetResources(const int netID);
+  void reserveNetResources(const int netID);
 
   // utility functions
   void setTreeNodesVariables(int netID);
@@ -509,7 +554,7 @@ class FastRouteCore
   float CalculatePartialSlack();
   bool checkRoute2DTree(int netID);
   void removeLoops();
-  void netedgeOrderDec(int netID);
+  void netedgeOrderDec(int netID, std::vector<OrderNetEdge>& net_eo);
   void printTree2D(int netID);
   void printEdge2D(int netID, int edgeID);
   void printEdge3D(int netID, int edgeID);
@@ -589,15 +634,14 @@ class FastRouteCore
   std::vector<double> cost_hvh_test_;  // Vertical first Z
   std::vector<double> cost_v_test_;    // Vertical segment cost
   std::vector<double> cost_tb_test_;   // Top and bottom boundary cost
-  std::vector<double> h_cost_table_;
-  std::vector<double> v_cost_table_;
+  std::vector<float> h_cost_table_;  // maze cost by edge usage
+  std::vector<float> v_cost_table_;
   std::vector<int> xcor_;
   std::vector<int> ycor_;
   std::vector<int> dcor_;
 
   std::vector<FrNet*> nets_;
   std::unordered_map<odb::dbNet*, int> db_net_id_map_;  // db net -> net id
-  std::vector<OrderNetEdge> net_eo_;
   std::vector<std::vector<int>>
       gxs_;  // the copy of xs for nets, used for second FLUTE
   std::vector<std::vector<int>>
@@ -612,18 +656,11 @@ class FastRouteCore
   multi_array<Edge, 2> h_edges_;       // The way it is indexed is (Y, X)
   multi_array<Edge3D, 3> h_edges_3D_;  // The way it is indexed is (Layer, Y, X)
   multi_array<Edge3D, 3> v_edges_3D_;  // The way it is indexed is (Layer, Y, X)
-  multi_array<int, 2> corr_edge_;
-  multi_array<short, 2> parent_x1_;
-  multi_array<short, 2> parent_y1_;
-  multi_array<short, 2> parent_x3_;
-  multi_array<short, 2> parent_y3_;
-  multi_array<bool, 2> hv_;
-  multi_array<bool, 2> hyper_v_;
-  multi_array<bool, 2> hyper_h_;
   multi_array<bool, 2> in_region_;
 
   std::vector<StTree> sttrees_;  // the Steiner trees
   std::vector<StTree> sttrees_bk_;
+  std::vector<MazeScratch> maze_scratch_;
 
   utl::Logger* logger_;
   stt::SteinerTreeBuilder* stt_builder_;
@@ -119,22 +119,12 @@ void FastRouteCore::clear()
   h_edges_3D_.resize(boost::extents[0][0][0]);
   v_edges_3D_.resize(boost::extents[0][0][0]);
 
-  parent_x1_.resize(boost::extents[0][0]);
-  parent_y1_.resize(boost::extents[0][0]);
-  parent_x3_.resize(boost::extents[0][0]);
-  parent_y3_.resize(boost::extents[0][0]);
-
-  net_eo_.clear();
+  maze_scratch_.clear();
 
   xcor_.clear();
   ycor_.clear();
   dcor_.clear();
 
-  hv_.resize(boost::extents[0][0]);
-  hyper_v_.resize(boost::extents[0][0]);
-  hyper_h_.resize(boost::extents[0][0]);
-  corr_edge_.resize(boost::extents[0][0]);
-
   in_region_.resize(boost::extents[0][0]);
 
   v_capacity_3D_.clear();
@@ -195,11 +185,6 @@ void FastRouteCore::setGridsAndLayers(int x, int y, int nLayers)
     last_row_h_capacity_3D_[i] = 0;
   }
 
-  hv_.resize(boost::extents[y_range_][x_range_]);
-  hyper_v_.resize(boost::extents[y_range_][x_range_]);
-  hyper_h_.resize(boost::extents[y_range_][x_range_]);
-  corr_edge_.resize(boost::extents[y_range_][x_range_]);
-
   in_region_.resize(boost::extents[y_range_][x_range_]);
 
   cost_hvh_.resize(x_range_);  // Horizontal first Z
@@ -698,11 +683,6 @@ void FastRouteCore::initAuxVar()
   tree_order_cong_.clear();
 
   grid_hv_ = x_range_ * y_range_;
-
-  parent_x1_.resize(boost::extents[y_grid_][x_grid_]);
-  parent_y1_.resize(boost::extents[y_grid_][x_grid_]);
-  parent_x3_.resize(boost::extents[y_grid_][x_grid_]);
-  parent_y3_.resize(boost::extents[y_grid_][x_grid_]);
 }
 
 NetRouteMap FastRouteCore::getRoutes()
@@ -998,7 +978,6 @@ NetRouteMap FastRouteCore::run()
   xcor_.resize(max_degree2);
   ycor_.resize(max_degree2);
   dcor_.resize(max_degree2);
-  net_eo_.reserve(max_degree2);
 
   int THRESH_M = 20;
   const int ENLARGE = 15;  // 5
@@ -1417,7 +1396,7 @@ NetRouteMap FastRouteCore::run()
   }
 
   NetRouteMap routes = getRoutes();
-  net_eo_.clear();
+  maze_scratch_.clear();
   net_ids_.clear();
   return routes;
 }
@@ -496,6 +496,38 @@ void FastRouteCore::releaseNetResources(const int netID)
   }
 }
 
+// Inverse of releaseNetResources, used to restore the usage of a net
+// route that was not created by the core code.
+void FastRouteCore::reserveNetResources(const int netID)
+{
+  const FrNet* net = nets_[netID];
+  const int edgeCost = net->getEdgeCost();
+
+  for (const TreeEdge& treeedge : sttrees_[netID].edges) {
+    const std::vector<short>& gridsX = treeedge.route.gridsX;
+    const std::vector<short>& gridsY = treeedge.route.gridsY;
+    const std::vector<short>& gridsL = treeedge.route.gridsL;
+    const int routeLen = treeedge.route.routelen;
+
+    for (int i = 0; i < routeLen; i++) {
+      if (gridsL[i] != gridsL[i + 1]) {
+        continue;
+      }
+      if (gridsX[i] == gridsX[i + 1]) {  // a vertical edge
+        const int ymin = std::min(gridsY[i], gridsY[i + 1]);
+        v_edges_[ymin][gridsX[i]].usage += edgeCost;
+        v_edges_3D_[gridsL[i]][ymin][gridsX[i]].usage
+            += net->getLayerEdgeCost(gridsL[i]);
+      } else if (gridsY[i] == gridsY[i + 1]) {  // a horizontal edge
+        const int xmin = std::min(gridsX[i], gridsX[i + 1]);
+        h_edges_[gridsY[i]][xmin].usage += edgeCost;
+        h_edges_3D_[gridsL[i]][gridsY[i]][xmin].usage
+            += net->getLayerEdgeCost(gridsL[i]);
+      }
+    }
+  }
+}
+
 void FastRouteCore::newRipupNet(const int netID)
 {
   const int edgeCost = nets_[netID]->getEdgeCost();
@@ -30,11 +30,17 @@
 // POSSIBILITY OF SUCH DAMAGE.
 ////////////////////////////////////////////////////////////////////////////////
 
+#include <omp.h>
+
 #include <algorithm>
+#include <limits>
+#include <numeric>
 
 #include "DataType.h"
 #include "FastRoute.h"
+#include "odb/db.h"
 #include "utl/Logger.h"
+#include "utl/exception.h"
 
 namespace grt {
 
@@ -724,24 +730,29 @@ void FastRouteCore::updateCongestionHistory(const int upType,
 // put all the nodes in the subtree t1 and t2 into src_heap and dest_heap
 // netID     - the ID for the net
 // edgeID    - the ID for the tree edge to route
-// d1        - the distance of any grid from the source subtree t1
-// d2        - the distance of any grid from the destination subtree t2
-// src_heap  - the heap storing the addresses for d1
-// dest_heap - the heap storing the addresses for d2
+// scratch   - the work arrays of the thread, holding
+//   d1        - the distance of any grid from the source subtree t1
+//   d2        - the distance of any grid from the destination subtree t2
+//   src_heap  - the heap storing the addresses for d1
+//   dest_heap - the heap storing the addresses for d2
 void FastRouteCore::setupHeap(const int netID,
                               const int edgeID,
-                              std::vector<double*>& src_heap,
-                              std::vector<double*>& dest_heap,
-                              multi_array<double, 2>& d1,
-                              multi_array<double, 2>& d2,
+                              MazeScratch& scratch,
                               const int regionX1,
                               const int regionX2,
                               const int regionY1,
                               const int regionY2)
 {
+  auto& src_heap = scratch.src_heap;
+  auto& dest_heap = scratch.dest_heap;
+  auto& d1 = scratch.d1;
+  auto& d2 = scratch.d2;
+  auto& in_region = scratch.in_region;
+  auto& corr_edge = scratch.corr_edge;
+
   for (int i = regionY1; i <= regionY2; i++) {
     for (int j = regionX1; j <= regionX2; j++)
-      in_region_[i][j] = true;
+      in_region[i][j] = true;
   }
 
   const auto& treeedges = sttrees_[netID].edges;
@@ -808,12 +819,12 @@ void FastRouteCore::setupHeap(const int netID,
         if (treeedges[edge].route.routelen > 0) {  // not a degraded edge
           // put nbr into src_heap if in enlarged region
           const TreeNode& nbr_node = treenodes[nbr];
-          if (in_region_[nbr_node.y][nbr_node.x]) {
+          if (in_region[nbr_node.y][nbr_node.x]) {
             const int nbrX = nbr_node.x;
             const int nbrY = nbr_node.y;
             d1[nbrY][nbrX] = 0;
             src_heap.push_back(&d1[nbrY][nbrX]);
-            corr_edge_[nbrY][nbrX] = edge;
+            corr_edge[nbrY][nbrX] = edge;
           }
           const Route* route = &(treeedges[edge].route);
           if (route->type != RouteType::MazeRoute) {
@@ -825,10 +836,10 @@ void FastRouteCore::setupHeap(const int netID,
             const int x_grid = route->gridsX[j];
             const int y_grid = route->gridsY[j];
 
-            if (in_region_[y_grid][x_grid]) {
+            if (in_region[y_grid][x_grid]) {
               d1[y_grid][x_grid] = 0;
               src_heap.push_back(&d1[y_grid][x_grid]);
-              corr_edge_[y_grid][x_grid] = edge;
+              corr_edge[y_grid][x_grid] = edge;
             }
           }
         }  // if not a degraded edge (len>0)
@@ -878,12 +889,12 @@ void FastRouteCore::setupHeap(const int netID,
         if (treeedges[edge].route.routelen > 0) {  // not a degraded edge
           // put nbr into dest_heap
           const TreeNode& nbr_node = treenodes[nbr];
-          if (in_region_[nbr_node.y][nbr_node.x]) {
+          if (in_region[nbr_node.y][nbr_node.x]) {
             const int nbrX = nbr_node.x;
             const int nbrY = nbr_node.y;
             d2[nbrY][nbrX] = 0;
             dest_heap.push_back(&d2[nbrY][nbrX]);
-            corr_edge_[nbrY][nbrX] = edge;
+            corr_edge[nbrY][nbrX] = edge;
           }
 
           const Route* route = &(treeedges[edge].route);
@@ -895,10 +906,10 @@ void FastRouteCore::setupHeap(const int netID,
           for (int j = 1; j < route->routelen; j++) {
             const int x_grid = route->gridsX[j];
             const int y_grid = route->gridsY[j];
-            if (in_region_[y_grid][x_grid]) {
+            if (in_region[y_grid][x_grid]) {
               d2[y_grid][x_grid] = 0;
               dest_heap.push_back(&d2[y_grid][x_grid]);
-              corr_edge_[y_grid][x_grid] = edge;
+              corr_edge[y_grid][x_grid] = edge;
             }
           }
         }  // if the edge is not degraded (len>0)
@@ -912,7 +923,7 @@ void FastRouteCore::setupHeap(const int netID,
 
   for (int i = regionY1; i <= regionY2; i++) {
     for (int j = regionX1; j <= regionX2; j++)
-      in_region_[i][j] = false;
+      in_region[i][j] = false;
   }
 }
 
@@ -1317,8 +1328,6 @@ void FastRouteCore::mazeRouteMSMD(const int iter,
                                   float& slack_th)
 {
   // maze routing for multi-source, multi-destination
-  int tmpX, tmpY;
-
   const int max_usage_multiplier = 40;
 
   // allocate memory for distance and parent and pop_heap
@@ -1334,11 +1343,6 @@ void FastRouteCore::mazeRouteMSMD(const int iter,
         = getCost(i, logis_cof, cost_height, slope, v_capacity_, cost_type);
   }
 
-  for (int i = 0; i < y_grid_; i++) {
-    for (int j = 0; j < x_grid_; j++)
-      in_region_[i][j] = false;
-  }
-
   if (ordering) {
     if (critical_nets_percentage_) {
       slack_th = CalculatePartialSlack();
@@ -1346,790 +1350,985 @@ void FastRouteCore::mazeRouteMSMD(const int iter,
     StNetOrder();
   }
 
-  std::vector<double*> src_heap;
-  std::vector<double*> dest_heap;
-  src_heap.reserve(y_grid_ * x_grid_);
-  dest_heap.reserve(y_grid_ * x_grid_);
-
-  multi_array<double, 2> d1(boost::extents[y_range_][x_range_]);
-  multi_array<double, 2> d2(boost::extents[y_range_][x_range_]);
-
-  std::vector<bool> pop_heap2(y_grid_ * x_range_, false);
+  const int num_nets = net_ids_.size();
+  std::vector<int> net_order(num_nets);
+  std::vector<odb::Rect> footprints(num_nets);
+  for (int i = 0; i < num_nets; i++) {
+    net_order[i] = ordering ? tree_order_cong_[i].treeIndex : net_ids_[i];
+    footprints[i] = getMazeFootprint(net_order[i], expand);
+  }
 
-  for (int nidRPC = 0; nidRPC < net_ids_.size(); nidRPC++) {
-    const int netID
-        = ordering ? tree_order_cong_[nidRPC].treeIndex : net_ids_[nidRPC];
+  const int num_threads
+      = std::max(1, std::min(db_->getThreadCount(), num_nets));
+  std::vector<std::vector<int>> batches;
+  if (num_threads > 1) {
+    batches = getMazeBatches(footprints);
+  } else {
+    batches.emplace_back(num_nets);
+    std::iota(batches[0].begin(), batches[0].end(), 0);
+  }
+  debugPrint(logger_,
+             utl::GRT,
+             "maze_2d",
+             1,
+             "Routing {} nets in {} batches using {} threads.",
+             num_nets,
+             batches.size(),
+             num_threads);
+
+  // The nets of a batch do not share any gcell of their footprints, so they
+  // are routed concurrently without locking the edges.  The used gcells are
+  // merged once the batch is done.
+  maze_scratch_.resize(num_threads);
+  std::vector<int> net_enlarge(num_nets, -1);
+  utl::ThreadException exception;
+  for (const std::vector<int>& batch : batches) {
+    const int batch_size = batch.size();
+#pragma omp parallel for schedule(dynamic) num_threads(num_threads) \
+    if (batch_size > 1)
+    for (int i = 0; i < batch_size; i++) {
+      try {
+        const int idx = batch[i];
+        MazeScratch& scratch = maze_scratch_[omp_get_thread_num()];
+        initMazeScratch(scratch);
+        while (!mazeRouteNet(net_order[idx],
+                             footprints[idx],
+                             iter,
+                             expand,
+                             cost_height,
+                             ripup_threshold,
+                             maze_edge_threshold,
+                             cost_type,
+                             logis_cof,
+                             via,
+                             slope,
+                             L,
+                             slack_th,
+                             net_enlarge[idx],
+                             scratch)) {
+          // the tree could not be updated, so rebuild it and try again
+#pragma omp critical(fastroute_reinit_tree)
+          reInitTree(net_order[idx]);
+        }
+      } catch (...) {
+        exception.capture();
+      }
+    }
+    exception.rethrow();
 
-    const int num_terminals = sttrees_[netID].num_terminals;
+    for (MazeScratch& scratch : maze_scratch_) {
+      h_used_ggrid_.insert(scratch.h_used_ggrid.begin(),
+                           scratch.h_used_ggrid.end());
+      v_used_ggrid_.insert(scratch.v_used_ggrid.begin(),
+                           scratch.v_used_ggrid.end());
+      scratch.h_used_ggrid.clear();
+      scratch.v_used_ggrid.clear();
+    }
+  }
 
-    const int origENG = expand;
+  // leave enlarge_ as routing the nets one by one does
+  for (int i = num_nets - 1; i >= 0; i--) {
+    if (net_enlarge[i] >= 0) {
+      enlarge_ = net_enlarge[i];
+      break;
+    }
+  }
 
-    netedgeOrderDec(netID);
+  h_cost_table_.clear();
+  v_cost_table_.clear();
+}
 
-    auto& treeedges = sttrees_[netID].edges;
-    auto& treenodes = sttrees_[netID].nodes;
-    // loop for all the tree edges
-    const int num_edges = sttrees_[netID].num_edges();
-    for (int edgeREC = 0; edgeREC < num_edges; edgeREC++) {
-      const int edgeID = net_eo_[edgeREC].edgeID;
-      TreeEdge* treeedge = &(treeedges[edgeID]);
-
-      int n1 = treeedge->n1;
-      int n2 = treeedge->n2;
-      const int n1x = treenodes[n1].x;
-      const int n1y = treenodes[n1].y;
-      const int n2x = treenodes[n2].x;
-      const int n2y = treenodes[n2].y;
-      treeedge->len = abs(n2x - n1x) + abs(n2y - n1y);
-
-      if (treeedge->len
-          <= maze_edge_threshold)  // only route the non-degraded edges (len>0)
-      {
-        continue;
+// Returns the gcells the maze routing of a net may read or change: its
+// tree nodes, its current routes and the search regions around them.
+odb::Rect FastRouteCore::getMazeFootprint(const int netID, const int expand)
+{
+  int x_min = std::numeric_limits<int>::max();
+  int y_min = std::numeric_limits<int>::max();
+  int x_max = std::numeric_limits<int>::min();
+  int y_max = std::numeric_limits<int>::min();
+  auto add = [&](const int x, const int y) {
+    x_min = std::min(x_min, x);
+    y_min = std::min(y_min, y);
+    x_max = std::max(x_max, x);
+    y_max = std::max(y_max, y);
+  };
+  for (const TreeNode& node : sttrees_[netID].nodes) {
+    add(node.x, node.y);
+  }
+  for (const TreeEdge& edge : sttrees_[netID].edges) {
+    if (edge.len > 0 && edge.route.type == RouteType::MazeRoute) {
+      for (int i = 0; i <= edge.route.routelen; i++) {
+        add(edge.route.gridsX[i], edge.route.gridsY[i]);
       }
+    }
+  }
+  if (x_min > x_max) {
+    return odb::Rect(0, 0, 0, 0);
+  }
+  return odb::Rect(std::max(x_min - expand, 0),
+                   std::max(y_min - expand, 0),
+                   std::min(x_max + expand, x_grid_ - 1),
+                   std::min(y_max + expand, y_grid_ - 1));
+}
 
-      const bool enter = newRipupCheck(treeedge,
-                                       n1x,
-                                       n1y,
-                                       n2x,
-                                       n2y,
-                                       ripup_threshold,
-                                       slack_th,
-                                       netID,
-                                       edgeID);
-
-      if (!enter) {
-        continue;
+// Splits the nets into batches whose footprints do not overlap.  A net goes
+// in the batch after the last one holding an earlier net it overlaps, so
+// routing the batches in order gives the same result as routing the nets
+// one by one, whatever the number of threads.  Overlaps are found on bins
+// of several gcells, which is conservative.
+std::vector<std::vector<int>> FastRouteCore::getMazeBatches(
+    const std::vector<odb::Rect>& footprints)
+{
+  const int bin_size = std::max(1, std::max(x_grid_, y_grid_) / 256);
+  const int x_bins = (x_grid_ - 1) / bin_size + 1;
+  const int y_bins = (y_grid_ - 1) / bin_size + 1;
+  multi_array<int, 2> last_batch(boost::extents[y_bins][x_bins]);
+  std::fill_n(last_batch.data(), last_batch.num_elements(), -1);
+
+  std::vector<std::vector<int>> batches;
+  for (int i = 0; i < footprints.size(); i++) {
+    const odb::Rect& footprint = footprints[i];
+    const int x1 = footprint.xMin() / bin_size;
+    const int x2 = footprint.xMax() / bin_size;
+    const int y1 = footprint.yMin() / bin_size;
+    const int y2 = footprint.yMax() / bin_size;
+    int batch = 0;
+    for (int y = y1; y <= y2; y++) {
+      for (int x = x1; x <= x2; x++) {
+        batch = std::max(batch, last_batch[y][x] + 1);
+      }
+    }
+    for (int y = y1; y <= y2; y++) {
+      for (int x = x1; x <= x2; x++) {
+        last_batch[y][x] = batch;
       }
+    }
+    if (batch == batches.size()) {
+      batches.emplace_back();
+    }
+    batches[batch].push_back(i);
+  }
+  return batches;
+}
+
+void FastRouteCore::initMazeScratch(MazeScratch& scratch)
+{
+  if (scratch.d1.shape()[0] == y_range_ && scratch.d1.shape()[1] == x_range_
+      && scratch.parent_x1.shape()[0] == y_grid_
+      && scratch.parent_x1.shape()[1] == x_grid_) {
+    return;
+  }
+  scratch.d1.resize(boost::extents[y_range_][x_range_]);
+  scratch.d2.resize(boost::extents[y_range_][x_range_]);
+  scratch.pop_heap2.assign(y_grid_ * x_range_, false);
+  scratch.src_heap.reserve(y_grid_ * x_grid_);
+  scratch.dest_heap.reserve(y_grid_ * x_grid_);
+  scratch.parent_x1.resize(boost::extents[y_grid_][x_grid_]);
+  scratch.parent_y1.resize(boost::extents[y_grid_][x_grid_]);
+  scratch.parent_x3.resize(boost::extents[y_grid_][x_grid_]);
+  scratch.parent_y3.resize(boost::extents[y_grid_][x_grid_]);
+  scratch.hv.resize(boost::extents[y_range_][x_range_]);
+  scratch.hyper_v.resize(boost::extents[y_range_][x_range_]);
+  scratch.hyper_h.resize(boost::extents[y_range_][x_range_]);
+  scratch.corr_edge.resize(boost::extents[y_range_][x_range_]);
+  scratch.in_region.resize(boost::extents[y_range_][x_range_]);
+  std::fill_n(
+      scratch.in_region.data(), scratch.in_region.num_elements(), false);
+}
 
-      // ripup the routing for the edge
-      const int ymin = std::min(n1y, n2y);
-      const int ymax = std::max(n1y, n2y);
+// Reroutes the tree edges of a net that need it, within footprint.  Returns
+// false if the tree of the net has to be rebuilt before routing it again.
+bool FastRouteCore::mazeRouteNet(const int netID,
+                                 const odb::Rect& footprint,
+                                 const int iter,
+                                 const int expand,
+                                 const float cost_height,
+                                 const int ripup_threshold,
+                                 const int maze_edge_threshold,
+                                 const int cost_type,
+                                 const float logis_cof,
+                                 const int via,
+                                 const int slope,
+                                 const int L,
+                                 const float slack_th,
+                                 int& last_enlarge,
+                                 MazeScratch& scratch)
+{
+  int tmpX, tmpY;
 
-      const int xmin = std::min(n1x, n2x);
-      const int xmax = std::max(n1x, n2x);
+  auto& d1 = scratch.d1;
+  auto& d2 = scratch.d2;
+  auto& pop_heap2 = scratch.pop_heap2;
+  auto& src_heap = scratch.src_heap;
+  auto& dest_heap = scratch.dest_heap;
+  auto& parent_x1 = scratch.parent_x1;
+  auto& parent_y1 = scratch.parent_y1;
+  auto& parent_x3 = scratch.parent_x3;
+  auto& parent_y3 = scratch.parent_y3;
+  auto& hv = scratch.hv;
+  auto& hyper_v = scratch.hyper_v;
+  auto& hyper_h = scratch.hyper_h;
+  auto& corr_edge = scratch.corr_edge;
+  auto& net_eo = scratch.net_eo;
 
-      enlarge_ = std::min(origENG, (iter / 6 + 3) * treeedge->route.routelen);
+  const int num_terminals = sttrees_[netID].num_terminals;
 
-      int decrease = 0;
+  netedgeOrderDec(netID, net_eo);
 
-      if (nets_[netID]->isCritical()) {
-        decrease = std::min((iter / 7) * 5, enlarge_ / 2);
-      }
-      const int regionX1 = std::max(xmin - enlarge_ + decrease, 0);
-      const int regionX2 = std::min(xmax + enlarge_ - decrease, x_grid_ - 1);
-      const int regionY1 = std::max(ymin - enlarge_ + decrease, 0);
-      const int regionY2 = std::min(ymax + enlarge_ - decrease, y_grid_ - 1);
-
-      // initialize d1[][] and d2[][] as BIG_INT
-      for (int i = regionY1; i <= regionY2; i++) {
-        for (int j = regionX1; j <= regionX2; j++) {
-          d1[i][j] = BIG_INT;
-          d2[i][j] = BIG_INT;
-          hyper_h_[i][j] = false;
-          hyper_v_[i][j] = false;
-        }
+  auto& treeedges = sttrees_[netID].edges;
+  auto& treenodes = sttrees_[netID].nodes;
+  // loop for all the tree edges
+  const int num_edges = sttrees_[netID].num_edges();
+  for (int edgeREC = 0; edgeREC < num_edges; edgeREC++) {
+    const int edgeID = net_eo[edgeREC].edgeID;
+    TreeEdge* treeedge = &(treeedges[edgeID]);
+
+    int n1 = treeedge->n1;
+    int n2 = treeedge->n2;
+    const int n1x = treenodes[n1].x;
+    const int n1y = treenodes[n1].y;
+    const int n2x = treenodes[n2].x;
+    const int n2y = treenodes[n2].y;
+    treeedge->len = abs(n2x - n1x) + abs(n2y - n1y);
+
+    if (treeedge->len
+        <= maze_edge_threshold)  // only route the non-degraded edges (len>0)
+    {
+      continue;
+    }
+
+    const bool enter = newRipupCheck(treeedge,
+                                     n1x,
+                                     n1y,
+                                     n2x,
+                                     n2y,
+                                     ripup_threshold,
+                                     slack_th,
+                                     netID,
+                                     edgeID);
+
+    if (!enter) {
+      continue;
+    }
+
+    // ripup the routing for the edge
+    const int ymin = std::min(n1y, n2y);
+    const int ymax = std::max(n1y, n2y);
+
+    const int xmin = std::min(n1x, n2x);
+    const int xmax = std::max(n1x, n2x);
+
+    const int enlarge
+        = std::min(expand, (iter / 6 + 3) * treeedge->route.routelen);
+    last_enlarge = enlarge;
+
+    int decrease = 0;
+
+    if (nets_[netID]->isCritical()) {
+      decrease = std::min((iter / 7) * 5, enlarge / 2);
+    }
+    // the footprint is within the grid and holds every region of the net
+    const int regionX1 = std::max(xmin - enlarge + decrease, footprint.xMin());
+    const int regionX2 = std::min(xmax + enlarge - decrease, footprint.xMax());
+    const int regionY1 = std::max(ymin - enlarge + decrease, footprint.yMin());
+    const int regionY2 = std::min(ymax + enlarge - decrease, footprint.yMax());
+
+    // initialize d1[][] and d2[][] as BIG_INT
+    for (int i = regionY1; i <= regionY2; i++) {
+      for (int j = regionX1; j <= regionX2; j++) {
+        d1[i][j] = BIG_INT;
+        d2[i][j] = BIG_INT;
+        hyper_h[i][j] = false;
+        hyper_v[i][j] = false;
       }
+    }
 
-      // setup src_heap, dest_heap and initialize d1[][] and d2[][] for all the
-      // grids on the two subtrees
-      setupHeap(netID,
-                edgeID,
-                src_heap,
-                dest_heap,
-                d1,
-                d2,
-                regionX1,
-                regionX2,
-                regionY1,
-                regionY2);
-
-      // while loop to find shortest path
-      int ind1 = (src_heap[0] - &d1[0][0]);
-      for (int i = 0; i < dest_heap.size(); i++)
-        pop_heap2[(dest_heap[i] - &d2[0][0])] = true;
-
-      // stop when the grid position been popped out from both src_heap and
-      // dest_heap
-      while (pop_heap2[ind1] == false) {
-        // relax all the adjacent grids within the enlarged region for
-        // source subtree
-        const int curX = ind1 % x_range_;
-        const int curY = ind1 / x_range_;
-        int preX, preY;
-        if (d1[curY][curX] != 0) {
-          if (hv_[curY][curX]) {
-            preX = parent_x1_[curY][curX];
-            preY = parent_y1_[curY][curX];
-          } else {
-            preX = parent_x3_[curY][curX];
-            preY = parent_y3_[curY][curX];
-          }
+    // setup src_heap, dest_heap and initialize d1[][] and d2[][] for all the
+    // grids on the two subtrees
+    setupHeap(netID,
+              edgeID,
+              scratch,
+              regionX1,
+              regionX2,
+              regionY1,
+              regionY2);
+
+    // while loop to find shortest path
+    int ind1 = (src_heap[0] - &d1[0][0]);
+    for (int i = 0; i < dest_heap.size(); i++)
+      pop_heap2[(dest_heap[i] - &d2[0][0])] = true;
+
+    // stop when the grid position been popped out from both src_heap and
+    // dest_heap
+    while (pop_heap2[ind1] == false) {
+      // relax all the adjacent grids within the enlarged region for
+      // source subtree
+      const int curX = ind1 % x_range_;
+      const int curY = ind1 / x_range_;
+      int preX, preY;
+      if (d1[curY][curX] != 0) {
+        if (hv[curY][curX]) {
+          preX = parent_x1[curY][curX];
+          preY = parent_y1[curY][curX];
         } else {
-          preX = curX;
-          preY = curY;
+          preX = parent_x3[curY][curX];
+          preY = parent_y3[curY][curX];
         }
+      } else {
+        preX = curX;
+        preY = curY;
+      }
+
+      removeMin(src_heap);
 
-        removeMin(src_heap);
-
-        // left
-        if (curX > regionX1) {
-          float tmp, cost1, cost2;
-          const int pos1 = h_edges_[curY][curX - 1].usage_red()
-                           + L * h_edges_[curY][(curX - 1)].last_usage;
-
-          if (pos1 < h_cost_table_.size())
-            cost1 = h_cost_table_.at(pos1);
-          else
-            cost1 = getCost(
-                pos1, logis_cof, cost_height, slope, h_capacity_, cost_type);
-
-          if ((preY == curY) || (d1[curY][curX] == 0)) {
-            tmp = d1[curY][curX] + cost1;
-          } else {
-            if (curX < regionX2 - 1) {
-              const int pos2 = h_edges_[curY][curX].usage_red()
-                               + L * h_edges_[curY][curX].last_usage;
-
-              if (pos2 < h_cost_table_.size())
-                cost2 = h_cost_table_.at(pos2);
-              else
-                cost2 = getCost(pos2,
-                                logis_cof,
-                                cost_height,
-                                slope,
-                                h_capacity_,
-                                cost_type);
-
-              const int tmp_cost = d1[curY][curX + 1] + cost2;
-
-              if (tmp_cost < d1[curY][curX] + via) {
-                hyper_h_[curY][curX] = true;
-              }
+      // left
+      if (curX > regionX1) {
+        float tmp, cost1, cost2;
+        const int pos1 = h_edges_[curY][curX - 1].usage_red()
+                         + L * h_edges_[curY][(curX - 1)].last_usage;
+
+        if (pos1 < h_cost_table_.size())
+          cost1 = h_cost_table_[pos1];
+        else
+          cost1 = getCost(
+              pos1, logis_cof, cost_height, slope, h_capacity_, cost_type);
+
+        if ((preY == curY) || (d1[curY][curX] == 0)) {
+          tmp = d1[curY][curX] + cost1;
+        } else {
+          if (curX < regionX2 - 1) {
+            const int pos2 = h_edges_[curY][curX].usage_red()
+                             + L * h_edges_[curY][curX].last_usage;
+
+            if (pos2 < h_cost_table_.size())
+              cost2 = h_cost_table_[pos2];
+            else
+              cost2 = getCost(pos2,
+                              logis_cof,
+                              cost_height,
+                              slope,
+                              h_capacity_,
+                              cost_type);
+
+            const int tmp_cost = d1[curY][curX + 1] + cost2;
+
+            if (tmp_cost < d1[curY][curX] + via) {
+              hyper_h[curY][curX] = true;
             }
-            tmp = d1[curY][curX] + via + cost1;
-          }
-          tmpX = curX - 1;  // the left neighbor
-
-          if (d1[curY][tmpX]
-              >= BIG_INT)  // left neighbor not been put into src_heap
-          {
-            d1[curY][tmpX] = tmp;
-            parent_x3_[curY][tmpX] = curX;
-            parent_y3_[curY][tmpX] = curY;
-            hv_[curY][tmpX] = false;
-            src_heap.push_back(&d1[curY][tmpX]);
-            updateHeap(src_heap, src_heap.size() - 1);
-          } else if (d1[curY][tmpX] > tmp)  // left neighbor been put into
-                                            // src_heap but needs update
-          {
-            d1[curY][tmpX] = tmp;
-            parent_x3_[curY][tmpX] = curX;
-            parent_y3_[curY][tmpX] = curY;
-            hv_[curY][tmpX] = false;
-            double* dtmp = &d1[curY][tmpX];
-            int ind = 0;
-            while (src_heap[ind] != dtmp)
-              ind++;
-            updateHeap(src_heap, ind);
           }
+          tmp = d1[curY][curX] + via + cost1;
+        }
+        tmpX = curX - 1;  // the left neighbor
+
+        if (d1[curY][tmpX]
+            >= BIG_INT)  // left neighbor not been put into src_heap
+        {
+          d1[curY][tmpX] = tmp;
+          parent_x3[curY][tmpX] = curX;
+          parent_y3[curY][tmpX] = curY;
+          hv[curY][tmpX] = false;
+          src_heap.push_back(&d1[curY][tmpX]);
+          updateHeap(src_heap, src_heap.size() - 1);
+        } else if (d1[curY][tmpX] > tmp)  // left neighbor been put into
+                                          // src_heap but needs update
+        {
+          d1[curY][tmpX] = tmp;
+          parent_x3[curY][tmpX] = curX;
+          parent_y3[curY][tmpX] = curY;
+          hv[curY][tmpX] = false;
+          double* dtmp = &d1[curY][tmpX];
+          int ind = 0;
+          while (src_heap[ind] != dtmp)
+            ind++;
+          updateHeap(src_heap, ind);
         }
-        // right
-        if (curX < regionX2) {
-          double tmp, cost1, cost2;
-          const int pos1 = h_edges_[curY][curX].usage_red()
-                           + L * h_edges_[curY][curX].last_usage;
-
-          if (pos1 < h_cost_table_.size())
-            cost1 = h_cost_table_.at(pos1);
-          else
-            cost1 = getCost(
-                pos1, logis_cof, cost_height, slope, h_capacity_, cost_type);
-
-          if ((preY == curY) || (d1[curY][curX] == 0)) {
-            tmp = d1[curY][curX] + cost1;
-          } else {
-            if (curX > regionX1 + 1) {
-              const int pos2 = h_edges_[curY][curX - 1].usage_red()
-                               + L * h_edges_[curY][curX - 1].last_usage;
-
-              if (pos2 < h_cost_table_.size())
-                cost2 = h_cost_table_.at(pos2);
-              else
-                cost2 = getCost(pos2,
-                                logis_cof,
-                                cost_height,
-                                slope,
-                                h_capacity_,
-                                cost_type);
-              const int tmp_cost = d1[curY][curX - 1] + cost2;
-
-              if (tmp_cost < d1[curY][curX] + via) {
-                hyper_h_[curY][curX] = true;
-              }
+      }
+      // right
+      if (curX < regionX2) {
+        double tmp, cost1, cost2;
+        const int pos1 = h_edges_[curY][curX].usage_red()
+                         + L * h_edges_[curY][curX].last_usage;
+
+        if (pos1 < h_cost_table_.size())
+          cost1 = h_cost_table_[pos1];
+        else
+          cost1 = getCost(
+              pos1, logis_cof, cost_height, slope, h_capacity_, cost_type);
+
+        if ((preY == curY) || (d1[curY][curX] == 0)) {
+          tmp = d1[curY][curX] + cost1;
+        } else {
+          if (curX > regionX1 + 1) {
+            const int pos2 = h_edges_[curY][curX - 1].usage_red()
+                             + L * h_edges_[curY][curX - 1].last_usage;
+
+            if (pos2 < h_cost_table_.size())
+              cost2 = h_cost_table_[pos2];
+            else
+              cost2 = getCost(pos2,
+                              logis_cof,
+                              cost_height,
+                              slope,
+                              h_capacity_,
+                              cost_type);
+            const int tmp_cost = d1[curY][curX - 1] + cost2;
+
+            if (tmp_cost < d1[curY][curX] + via) {
+              hyper_h[curY][curX] = true;
             }
-            tmp = d1[curY][curX] + via + cost1;
-          }
-          tmpX = curX + 1;  // the right neighbor
-
-          if (d1[curY][tmpX]
-              >= BIG_INT)  // right neighbor not been put into src_heap
-          {
-            d1[curY][tmpX] = tmp;
-            parent_x3_[curY][tmpX] = curX;
-            parent_y3_[curY][tmpX] = curY;
-            hv_[curY][tmpX] = false;
-            src_heap.push_back(&d1[curY][tmpX]);
-            updateHeap(src_heap, src_heap.size() - 1);
-          } else if (d1[curY][tmpX] > tmp)  // right neighbor been put into
-                                            // src_heap but needs update
-          {
-            d1[curY][tmpX] = tmp;
-            parent_x3_[curY][tmpX] = curX;
-            parent_y3_[curY][tmpX] = curY;
-            hv_[curY][tmpX] = false;
-            double* dtmp = &d1[curY][tmpX];
-            int ind = 0;
-            while (src_heap[ind] != dtmp)
-              ind++;
-            updateHeap(src_heap, ind);
           }
+          tmp = d1[curY][curX] + via + cost1;
+        }
+        tmpX = curX + 1;  // the right neighbor
+
+        if (d1[curY][tmpX]
+            >= BIG_INT)  // right neighbor not been put into src_heap
+        {
+          d1[curY][tmpX] = tmp;
+          parent_x3[curY][tmpX] = curX;
+          parent_y3[curY][tmpX] = curY;
+          hv[curY][tmpX] = false;
+          src_heap.push_back(&d1[curY][tmpX]);
+          updateHeap(src_heap, src_heap.size() - 1);
+        } else if (d1[curY][tmpX] > tmp)  // right neighbor been put into
+                                          // src_heap but needs update
+        {
+          d1[curY][tmpX] = tmp;
+          parent_x3[curY][tmpX] = curX;
+          parent_y3[curY][tmpX] = curY;
+          hv[curY][tmpX] = false;
+          double* dtmp = &d1[curY][tmpX];
+          int ind = 0;
+          while (src_heap[ind] != dtmp)
+            ind++;
+          updateHeap(src_heap, ind);
         }
-        // bottom
-        if (curY > regionY1) {
-          double tmp, cost1, cost2;
-          const int pos1 = v_edges_[curY - 1][curX].usage_red()
-                           + L * v_edges_[curY - 1][curX].last_usage;
-
-          if (pos1 < v_cost_table_.size())
-            cost1 = v_cost_table_.at(pos1);
-          else
-            cost1 = getCost(
-                pos1, logis_cof, cost_height, slope, v_capacity_, cost_type);
-
-          if ((preX == curX) || (d1[curY][curX] == 0)) {
-            tmp = d1[curY][curX] + cost1;
-          } else {
-            if (curY < regionY2 - 1) {
-              const int pos2 = v_edges_[curY][curX].usage_red()
-                               + L * v_edges_[curY][curX].last_usage;
-
-              if (pos2 < v_cost_table_.size())
-                cost2 = v_cost_table_.at(pos2);
-              else
-                cost2 = getCost(pos2,
-                                logis_cof,
-                                cost_height,
-                                slope,
-                                v_capacity_,
-                                cost_type);
-              const int tmp_cost = d1[curY + 1][curX] + cost2;
-
-              if (tmp_cost < d1[curY][curX] + via) {
-                hyper_v_[curY][curX] = true;
-              }
+      }
+      // bottom
+      if (curY > regionY1) {
+        double tmp, cost1, cost2;
+        const int pos1 = v_edges_[curY - 1][curX].usage_red()
+                         + L * v_edges_[curY - 1][curX].last_usage;
+
+        if (pos1 < v_cost_table_.size())
+          cost1 = v_cost_table_[pos1];
+        else
+          cost1 = getCost(
+              pos1, logis_cof, cost_height, slope, v_capacity_, cost_type);
+
+        if ((preX == curX) || (d1[curY][curX] == 0)) {
+          tmp = d1[curY][curX] + cost1;
+        } else {
+          if (curY < regionY2 - 1) {
+            const int pos2 = v_edges_[curY][curX].usage_red()
+                             + L * v_edges_[curY][curX].last_usage;
+
+            if (pos2 < v_cost_table_.size())
+              cost2 = v_cost_table_[pos2];
+            else
+              cost2 = getCost(pos2,
+                              logis_cof,
+                              cost_height,
+                              slope,
+                              v_capacity_,
+                              cost_type);
+            const int tmp_cost = d1[curY + 1][curX] + cost2;
+
+            if (tmp_cost < d1[curY][curX] + via) {
+              hyper_v[curY][curX] = true;
             }
-            tmp = d1[curY][curX] + via + cost1;
-          }
-          tmpY = curY - 1;  // the bottom neighbor
-          if (d1[tmpY][curX]
-              >= BIG_INT)  // bottom neighbor not been put into src_heap
-          {
-            d1[tmpY][curX] = tmp;
-            parent_x1_[tmpY][curX] = curX;
-            parent_y1_[tmpY][curX] = curY;
-            hv_[tmpY][curX] = true;
-            src_heap.push_back(&d1[tmpY][curX]);
-            updateHeap(src_heap, src_heap.size() - 1);
-          } else if (d1[tmpY][curX] > tmp)  // bottom neighbor been put into
-                                            // src_heap but needs update
-          {
-            d1[tmpY][curX] = tmp;
-            parent_x1_[tmpY][curX] = curX;
-            parent_y1_[tmpY][curX] = curY;
-            hv_[tmpY][curX] = true;
-            double* dtmp = &d1[tmpY][curX];
-            int ind = 0;
-            while (src_heap[ind] != dtmp)
-              ind++;
-            updateHeap(src_heap, ind);
           }
+          tmp = d1[curY][curX] + via + cost1;
         }
-        // top
-        if (curY < regionY2) {
-          double tmp, cost1, cost2;
-          const int pos1 = v_edges_[curY][curX].usage_red()
-                           + L * v_edges_[curY][curX].last_usage;
-
-          if (pos1 < v_cost_table_.size())
-            cost1 = v_cost_table_.at(pos1);
-          else
-            cost1 = getCost(
-                pos1, logis_cof, cost_height, slope, v_capacity_, cost_type);
-
-          if ((preX == curX) || (d1[curY][curX] == 0)) {
-            tmp = d1[curY][curX] + cost1;
-          } else {
-            if (curY > regionY1 + 1) {
-              const int pos2 = v_edges_[curY - 1][curX].usage_red()
-                               + L * v_edges_[curY - 1][curX].last_usage;
-
-              if (pos2 < v_cost_table_.size())
-                cost2 = v_cost_table_.at(pos2);
-              else
-                cost2 = getCost(pos2,
-                                logis_cof,
-                                cost_height,
-                                slope,
-                                v_capacity_,
-                                cost_type);
-
-              const int tmp_cost = d1[curY - 1][curX] + cost2;
-
-              if (tmp_cost < d1[curY][curX] + via) {
-                hyper_v_[curY][curX] = true;
-              }
+        tmpY = curY - 1;  // the bottom neighbor
+        if (d1[tmpY][curX]
+            >= BIG_INT)  // bottom neighbor not been put into src_heap
+        {
+          d1[tmpY][curX] = tmp;
+          parent_x1[tmpY][curX] = curX;
+          parent_y1[tmpY][curX] = curY;
+          hv[tmpY][curX] = true;
+          src_heap.push_back(&d1[tmpY][curX]);
+          updateHeap(src_heap, src_heap.size() - 1);
+        } else if (d1[tmpY][curX] > tmp)  // bottom neighbor been put into
+                                          // src_heap but needs update
+        {
+          d1[tmpY][curX] = tmp;
+          parent_x1[tmpY][curX] = curX;
+          parent_y1[tmpY][curX] = curY;
+          hv[tmpY][curX] = true;
+          double* dtmp = &d1[tmpY][curX];
+          int ind = 0;
+          while (src_heap[ind] != dtmp)
+            ind++;
+          updateHeap(src_heap, ind);
+        }
+      }
+      // top
+      if (curY < regionY2) {
+        double tmp, cost1, cost2;
+        const int pos1 = v_edges_[curY][curX].usage_red()
+                         + L * v_edges_[curY][curX].last_usage;
+
+        if (pos1 < v_cost_table_.size())
+          cost1 = v_cost_table_[pos1];
+        else
+          cost1 = getCost(
+              pos1, logis_cof, cost_height, slope, v_capacity_, cost_type);
+
+        if ((preX == curX) || (d1[curY][curX] == 0)) {
+          tmp = d1[curY][curX] + cost1;
+        } else {
+          if (curY > regionY1 + 1) {
+            const int pos2 = v_edges_[curY - 1][curX].usage_red()
+                             + L * v_edges_[curY - 1][curX].last_usage;
+
+            if (pos2 < v_cost_table_.size())
+              cost2 = v_cost_table_[pos2];
+            else
+              cost2 = getCost(pos2,
+                              logis_cof,
+                              cost_height,
+                              slope,
+                              v_capacity_,
+                              cost_type);
+
+            const int tmp_cost = d1[curY - 1][curX] + cost2;
+
+            if (tmp_cost < d1[curY][curX] + via) {
+              hyper_v[curY][curX] = true;
             }
-            tmp = d1[curY][curX] + via + cost1;
-          }
-          tmpY = curY + 1;  // the top neighbor
-          if (d1[tmpY][curX]
-              >= BIG_INT)  // top neighbor not been put into src_heap
-          {
-            d1[tmpY][curX] = tmp;
-            parent_x1_[tmpY][curX] = curX;
-            parent_y1_[tmpY][curX] = curY;
-            hv_[tmpY][curX] = true;
-            src_heap.push_back(&d1[tmpY][curX]);
-            updateHeap(src_heap, src_heap.size() - 1);
-          } else if (d1[tmpY][curX] > tmp)  // top neighbor been put into
-                                            // src_heap but needs update
-          {
-            d1[tmpY][curX] = tmp;
-            parent_x1_[tmpY][curX] = curX;
-            parent_y1_[tmpY][curX] = curY;
-            hv_[tmpY][curX] = true;
-            double* dtmp = &d1[tmpY][curX];
-            int ind = 0;
-            while (src_heap[ind] != dtmp)
-              ind++;
-            updateHeap(src_heap, ind);
           }
+          tmp = d1[curY][curX] + via + cost1;
         }
+        tmpY = curY + 1;  // the top neighbor
+        if (d1[tmpY][curX]
+            >= BIG_INT)  // top neighbor not been put into src_heap
+        {
+          d1[tmpY][curX] = tmp;
+          parent_x1[tmpY][curX] = curX;
+          parent_y1[tmpY][curX] = curY;
+          hv[tmpY][curX] = true;
+          src_heap.push_back(&d1[tmpY][curX]);
+          updateHeap(src_heap, src_heap.size() - 1);
+        } else if (d1[tmpY][curX] > tmp)  // top neighbor been put into
+                                          // src_heap but needs update
+        {
+          d1[tmpY][curX] = tmp;
+          parent_x1[tmpY][curX] = curX;
+          parent_y1[tmpY][curX] = curY;
+          hv[tmpY][curX] = true;
+          double* dtmp = &d1[tmpY][curX];
+          int ind = 0;
+          while (src_heap[ind] != dtmp)
+            ind++;
+          updateHeap(src_heap, ind);
+        }
+      }
 
-        // update ind1 for next loop
-        ind1 = (src_heap[0] - &d1[0][0]);
+      // update ind1 for next loop
+      ind1 = (src_heap[0] - &d1[0][0]);
 
-      }  // while loop
+    }  // while loop
 
-      for (int i = 0; i < dest_heap.size(); i++)
-        pop_heap2[(dest_heap[i] - &d2[0][0])] = false;
+    for (int i = 0; i < dest_heap.size(); i++)
+      pop_heap2[(dest_heap[i] - &d2[0][0])] = false;
 
-      const int crossX = ind1 % x_range_;
-      const int crossY = ind1 / x_range_;
+    const int crossX = ind1 % x_range_;
+    const int crossY = ind1 / x_range_;
 
-      int cnt = 0;
-      int curX = crossX;
-      int curY = crossY;
-      std::vector<int> tmp_gridsX, tmp_gridsY;
-      while (d1[curY][curX] != 0)  // loop until reach subtree1
-      {
-        bool hypered = false;
-        if (cnt != 0) {
-          if (curX != tmpX && hyper_h_[curY][curX]) {
-            curX = 2 * curX - tmpX;
-            hypered = true;
-          }
+    int cnt = 0;
+    int curX = crossX;
+    int curY = crossY;
+    std::vector<int> tmp_gridsX, tmp_gridsY;
+    while (d1[curY][curX] != 0)  // loop until reach subtree1
+    {
+      bool hypered = false;
+      if (cnt != 0) {
+        if (curX != tmpX && hyper_h[curY][curX]) {
+          curX = 2 * curX - tmpX;
+          hypered = true;
+        }
 
-          if (curY != tmpY && hyper_v_[curY][curX]) {
-            curY = 2 * curY - tmpY;
-            hypered = true;
-          }
+        if (curY != tmpY && hyper_v[curY][curX]) {
+          curY = 2 * curY - tmpY;
+          hypered = true;
         }
-        tmpX = curX;
-        tmpY = curY;
-        if (!hypered) {
-          if (hv_[tmpY][tmpX]) {
-            curY = parent_y1_[tmpY][tmpX];
-          } else {
-            curX = parent_x3_[tmpY][tmpX];
-          }
+      }
+      tmpX = curX;
+      tmpY = curY;
+      if (!hypered) {
+        if (hv[tmpY][tmpX]) {
+          curY = parent_y1[tmpY][tmpX];
+        } else {
+          curX = parent_x3[tmpY][tmpX];
         }
-        tmp_gridsX.push_back(curX);
-        tmp_gridsY.push_back(curY);
-        cnt++;
       }
-      // reverse the grids on the path
-      std::vector<int> gridsX(tmp_gridsX.rbegin(), tmp_gridsX.rend());
-      std::vector<int> gridsY(tmp_gridsY.rbegin(), tmp_gridsY.rend());
-
-      // add the connection point (crossX, crossY)
-      gridsX.push_back(crossX);
-      gridsY.push_back(crossY);
+      tmp_gridsX.push_back(curX);
+      tmp_gridsY.push_back(curY);
       cnt++;
+    }
+    // reverse the grids on the path
+    std::vector<int> gridsX(tmp_gridsX.rbegin(), tmp_gridsX.rend());
+    std::vector<int> gridsY(tmp_gridsY.rbegin(), tmp_gridsY.rend());
 
-      curX = crossX;
-      curY = crossY;
-      const int cnt_n1n2 = cnt;
-
-      // change the tree structure according to the new routing for the tree
-      // edge find E1 and E2, and the endpoints of the edges they are on
-      const int E1x = gridsX[0];
-      const int E1y = gridsY[0];
-      const int E2x = gridsX.back();
-      const int E2y = gridsY.back();
-
-      const int edge_n1n2 = edgeID;
-      // (1) consider subtree1
-      if (n1 < num_terminals && (E1x != n1x || E1y != n1y)) {
-        // split neighbor edge and return id new node
-        n1 = splitEdge(treeedges, treenodes, n2, n1, edgeID);
+    // add the connection point (crossX, crossY)
+    gridsX.push_back(crossX);
+    gridsY.push_back(crossY);
+    cnt++;
+
+    curX = crossX;
+    curY = crossY;
+    const int cnt_n1n2 = cnt;
+
+    // change the tree structure according to the new routing for the tree
+    // edge find E1 and E2, and the endpoints of the edges they are on
+    const int E1x = gridsX[0];
+    const int E1y = gridsY[0];
+    const int E2x = gridsX.back();
+    const int E2y = gridsY.back();
+
+    const int edge_n1n2 = edgeID;
+    // (1) consider subtree1
+    if (n1 < num_terminals && (E1x != n1x || E1y != n1y)) {
+      // split neighbor edge and return id new node
+      n1 = splitEdge(treeedges, treenodes, n2, n1, edgeID);
+    }
+    if (n1 >= num_terminals && (E1x != n1x || E1y != n1y))
+    // n1 is not a pin and E1!=n1, then make change to subtree1,
+    // otherwise, no change to subtree1
+    {
+      // find the endpoints of the edge E1 is on
+      const int endpt1 = treeedges[corr_edge[E1y][E1x]].n1;
+      const int endpt2 = treeedges[corr_edge[E1y][E1x]].n2;
+
+      // find A1, A2 and edge_n1A1, edge_n1A2
+      int A1, A2;
+      int edge_n1A1, edge_n1A2;
+      if (treenodes[n1].nbr[0] == n2) {
+        A1 = treenodes[n1].nbr[1];
+        A2 = treenodes[n1].nbr[2];
+        edge_n1A1 = treenodes[n1].edge[1];
+        edge_n1A2 = treenodes[n1].edge[2];
+      } else if (treenodes[n1].nbr[1] == n2) {
+        A1 = treenodes[n1].nbr[0];
+        A2 = treenodes[n1].nbr[2];
+        edge_n1A1 = treenodes[n1].edge[0];
+        edge_n1A2 = treenodes[n1].edge[2];
+      } else {
+        A1 = treenodes[n1].nbr[0];
+        A2 = treenodes[n1].nbr[1];
+        edge_n1A1 = treenodes[n1].edge[0];
+        edge_n1A2 = treenodes[n1].edge[1];
       }
-      if (n1 >= num_terminals && (E1x != n1x || E1y != n1y))
-      // n1 is not a pin and E1!=n1, then make change to subtree1,
-      // otherwise, no change to subtree1
+
+      if (endpt1 == n1 || endpt2 == n1)  // E1 is on (n1, A1) or (n1, A2)
       {
-        // find the endpoints of the edge E1 is on
-        const int endpt1 = treeedges[corr_edge_[E1y][E1x]].n1;
-        const int endpt2 = treeedges[corr_edge_[E1y][E1x]].n2;
-
-        // find A1, A2 and edge_n1A1, edge_n1A2
-        int A1, A2;
-        int edge_n1A1, edge_n1A2;
-        if (treenodes[n1].nbr[0] == n2) {
-          A1 = treenodes[n1].nbr[1];
-          A2 = treenodes[n1].nbr[2];
-          edge_n1A1 = treenodes[n1].edge[1];
-          edge_n1A2 = treenodes[n1].edge[2];
-        } else if (treenodes[n1].nbr[1] == n2) {
-          A1 = treenodes[n1].nbr[0];
-          A2 = treenodes[n1].nbr[2];
-          edge_n1A1 = treenodes[n1].edge[0];
-          edge_n1A2 = treenodes[n1].edge[2];
-        } else {
-          A1 = treenodes[n1].nbr[0];
-          A2 = treenodes[n1].nbr[1];
-          edge_n1A1 = treenodes[n1].edge[0];
-          edge_n1A2 = treenodes[n1].edge[1];
+        // if E1 is on (n1, A2), switch A1 and A2 so that E1 is always on
+        // (n1, A1)
+        if (endpt1 == A2 || endpt2 == A2) {
+          std::swap(A1, A2);
+          std::swap(edge_n1A1, edge_n1A2);
         }
 
-        if (endpt1 == n1 || endpt2 == n1)  // E1 is on (n1, A1) or (n1, A2)
-        {
-          // if E1 is on (n1, A2), switch A1 and A2 so that E1 is always on
-          // (n1, A1)
-          if (endpt1 == A2 || endpt2 == A2) {
-            std::swap(A1, A2);
-            std::swap(edge_n1A1, edge_n1A2);
-          }
-
-          // update route for edge (n1, A1), (n1, A2)
-          bool route_ok = updateRouteType1(netID,
-                                           treenodes,
-                                           n1,
-                                           A1,
-                                           A2,
-                                           E1x,
-                                           E1y,
-                                           treeedges,
-                                           edge_n1A1,
-                                           edge_n1A2);
-          if (!route_ok) {
-            if (verbose_)
-              logger_->error(GRT,
-                             150,
-                             "Net {} has errors during updateRouteType1.",
-                             nets_[netID]->getName());
-            reInitTree(netID);
-            nidRPC--;
+        // update route for edge (n1, A1), (n1, A2)
+        bool route_ok = updateRouteType1(netID,
+                                         treenodes,
+                                         n1,
+                                         A1,
+                                         A2,
+                                         E1x,
+                                         E1y,
+                                         treeedges,
+                                         edge_n1A1,
+                                         edge_n1A2);
+        if (!route_ok) {
+          if (verbose_)
+            logger_->error(GRT,
+                           150,
+                           "Net {} has errors during updateRouteType1.",
+                           nets_[netID]->getName());
+          return false;
+        }
+        // update position for n1
+        treenodes[n1].x = E1x;
+        treenodes[n1].y = E1y;
+      }     // if E1 is on (n1, A1) or (n1, A2)
+      else  // E1 is not on (n1, A1) or (n1, A2), but on (C1, C2)
+      {
+        const int C1 = endpt1;
+        const int C2 = endpt2;
+        const int edge_C1C2 = corr_edge[E1y][E1x];
+
+        // update route for edge (n1, C1), (n1, C2) and (A1, A2)
+        bool route_ok = updateRouteType2(netID,
+                                         treenodes,
+                                         n1,
+                                         A1,
+                                         A2,
+                                         C1,
+                                         C2,
+                                         E1x,
+                                         E1y,
+                                         treeedges,
+                                         edge_n1A1,
+                                         edge_n1A2,
+                                         edge_C1C2);
+        if (!route_ok) {
+          debugPrint(logger_,
+                     utl::GRT,
+                     "maze_2d",
+                     1,
+                     "Net {} has errors during updateRouteType2.",
+                     nets_[netID]->getName());
+          return false;
+        }
+        // update position for n1
+        treenodes[n1].x = E1x;
+        treenodes[n1].y = E1y;
+        // update 3 edges (n1, A1)->(C1, n1), (n1, A2)->(n1, C2), (C1,
+        // C2)->(A1, A2)
+        const int edge_n1C1 = edge_n1A1;
+        treeedges[edge_n1C1].n1 = C1;
+        treeedges[edge_n1C1].n2 = n1;
+        const int edge_n1C2 = edge_n1A2;
+        treeedges[edge_n1C2].n1 = n1;
+        treeedges[edge_n1C2].n2 = C2;
+        const int edge_A1A2 = edge_C1C2;
+        treeedges[edge_A1A2].n1 = A1;
+        treeedges[edge_A1A2].n2 = A2;
+        // update nbr and edge for 5 nodes n1, A1, A2, C1, C2
+        // n1's nbr (n2, A1, A2)->(n2, C1, C2)
+        treenodes[n1].nbr[0] = n2;
+        treenodes[n1].edge[0] = edge_n1n2;
+        treenodes[n1].nbr[1] = C1;
+        treenodes[n1].edge[1] = edge_n1C1;
+        treenodes[n1].nbr[2] = C2;
+        treenodes[n1].edge[2] = edge_n1C2;
+        // A1's nbr n1->A2
+        for (int i = 0; i < 3; i++) {
+          if (treenodes[A1].nbr[i] == n1) {
+            treenodes[A1].nbr[i] = A2;
+            treenodes[A1].edge[i] = edge_A1A2;
             break;
           }
-          // update position for n1
-          treenodes[n1].x = E1x;
-          treenodes[n1].y = E1y;
-        }     // if E1 is on (n1, A1) or (n1, A2)
-        else  // E1 is not on (n1, A1) or (n1, A2), but on (C1, C2)
-        {
-          const int C1 = endpt1;
-          const int C2 = endpt2;
-          const int edge_C1C2 = corr_edge_[E1y][E1x];
-
-          // update route for edge (n1, C1), (n1, C2) and (A1, A2)
-          bool route_ok = updateRouteType2(netID,
-                                           treenodes,
-                                           n1,
-                                           A1,
-                                           A2,
-                                           C1,
-                                           C2,
-                                           E1x,
-                                           E1y,
-                                           treeedges,
-                                           edge_n1A1,
-                                           edge_n1A2,
-                                           edge_C1C2);
-          if (!route_ok) {
-            debugPrint(logger_,
-                       utl::GRT,
-                       "maze_2d",
-                       1,
-                       "Net {} has errors during updateRouteType2.",
-                       nets_[netID]->getName());
-            reInitTree(netID);
-            nidRPC--;
+        }
+        // A2's nbr n1->A1
+        for (int i = 0; i < 3; i++) {
+          if (treenodes[A2].nbr[i] == n1) {
+            treenodes[A2].nbr[i] = A1;
+            treenodes[A2].edge[i] = edge_A1A2;
             break;
           }
-          // update position for n1
-          treenodes[n1].x = E1x;
-          treenodes[n1].y = E1y;
-          // update 3 edges (n1, A1)->(C1, n1), (n1, A2)->(n1, C2), (C1,
-          // C2)->(A1, A2)
-          const int edge_n1C1 = edge_n1A1;
-          treeedges[edge_n1C1].n1 = C1;
-          treeedges[edge_n1C1].n2 = n1;
-          const int edge_n1C2 = edge_n1A2;
-          treeedges[edge_n1C2].n1 = n1;
-          treeedges[edge_n1C2].n2 = C2;
-          const int edge_A1A2 = edge_C1C2;
-          treeedges[edge_A1A2].n1 = A1;
-          treeedges[edge_A1A2].n2 = A2;
-          // update nbr and edge for 5 nodes n1, A1, A2, C1, C2
-          // n1's nbr (n2, A1, A2)->(n2, C1, C2)
-          treenodes[n1].nbr[0] = n2;
-          treenodes[n1].edge[0] = edge_n1n2;
-          treenodes[n1].nbr[1] = C1;
-          treenodes[n1].edge[1] = edge_n1C1;
-          treenodes[n1].nbr[2] = C2;
-          treenodes[n1].edge[2] = edge_n1C2;
-          // A1's nbr n1->A2
-          for (int i = 0; i < 3; i++) {
-            if (treenodes[A1].nbr[i] == n1) {
-              treenodes[A1].nbr[i] = A2;
-              treenodes[A1].edge[i] = edge_A1A2;
-              break;
-            }
-          }
-          // A2's nbr n1->A1
-          for (int i = 0; i < 3; i++) {
-            if (treenodes[A2].nbr[i] == n1) {
-              treenodes[A2].nbr[i] = A1;
-              treenodes[A2].edge[i] = edge_A1A2;
-              break;
-            }
-          }
-          // C1's nbr C2->n1
-          for (int i = 0; i < 3; i++) {
-            if (treenodes[C1].nbr[i] == C2) {
-              treenodes[C1].nbr[i] = n1;
-              treenodes[C1].edge[i] = edge_n1C1;
-              break;
-            }
+        }
+        // C1's nbr C2->n1
+        for (int i = 0; i < 3; i++) {
+          if (treenodes[C1].nbr[i] == C2) {
+            treenodes[C1].nbr[i] = n1;
+            treenodes[C1].edge[i] = edge_n1C1;
+            break;
           }
-          // C2's nbr C1->n1
-          for (int i = 0; i < 3; i++) {
-            if (treenodes[C2].nbr[i] == C1) {
-              treenodes[C2].nbr[i] = n1;
-              treenodes[C2].edge[i] = edge_n1C2;
-              break;
-            }
+        }
+        // C2's nbr C1->n1
+        for (int i = 0; i < 3; i++) {
+          if (treenodes[C2].nbr[i] == C1) {
+            treenodes[C2].nbr[i] = n1;
+            treenodes[C2].edge[i] = edge_n1C2;
+            break;
           }
+        }
 
-        }  // else E1 is not on (n1, A1) or (n1, A2), but on (C1, C2)
-      }    // n1 is not a pin and E1!=n1
+      }  // else E1 is not on (n1, A1) or (n1, A2), but on (C1, C2)
+    }    // n1 is not a pin and E1!=n1
 
-      // (2) consider subtree2
-      if (n2 < num_terminals && (E2x != n2x || E2y != n2y)) {
-        // split neighbor edge and return id new node
-        n2 = splitEdge(treeedges, treenodes, n1, n2, edgeID);
+    // (2) consider subtree2
+    if (n2 < num_terminals && (E2x != n2x || E2y != n2y)) {
+      // split neighbor edge and return id new node
+      n2 = splitEdge(treeedges, treenodes, n1, n2, edgeID);
+    }
+    if (n2 >= num_terminals && (E2x != n2x || E2y != n2y))
+    // n2 is not a pin and E2!=n2, then make change to subtree2,
+    // otherwise, no change to subtree2
+    {
+      // find the endpoints of the edge E1 is on
+      const int endpt1 = treeedges[corr_edge[E2y][E2x]].n1;
+      const int endpt2 = treeedges[corr_edge[E2y][E2x]].n2;
+
+      // find B1, B2
+      int B1, B2;
+      int edge_n2B1, edge_n2B2;
+      if (treenodes[n2].nbr[0] == n1) {
+        B1 = treenodes[n2].nbr[1];
+        B2 = treenodes[n2].nbr[2];
+        edge_n2B1 = treenodes[n2].edge[1];
+        edge_n2B2 = treenodes[n2].edge[2];
+      } else if (treenodes[n2].nbr[1] == n1) {
+        B1 = treenodes[n2].nbr[0];
+        B2 = treenodes[n2].nbr[2];
+        edge_n2B1 = treenodes[n2].edge[0];
+        edge_n2B2 = treenodes[n2].edge[2];
+      } else {
+        B1 = treenodes[n2].nbr[0];
+        B2 = treenodes[n2].nbr[1];
+        edge_n2B1 = treenodes[n2].edge[0];
+        edge_n2B2 = treenodes[n2].edge[1];
       }
-      if (n2 >= num_terminals && (E2x != n2x || E2y != n2y))
-      // n2 is not a pin and E2!=n2, then make change to subtree2,
-      // otherwise, no change to subtree2
+
+      if (endpt1 == n2 || endpt2 == n2)  // E2 is on (n2, B1) or (n2, B2)
       {
-        // find the endpoints of the edge E1 is on
-        const int endpt1 = treeedges[corr_edge_[E2y][E2x]].n1;
-        const int endpt2 = treeedges[corr_edge_[E2y][E2x]].n2;
-
-        // find B1, B2
-        int B1, B2;
-        int edge_n2B1, edge_n2B2;
-        if (treenodes[n2].nbr[0] == n1) {
-          B1 = treenodes[n2].nbr[1];
-          B2 = treenodes[n2].nbr[2];
-          edge_n2B1 = treenodes[n2].edge[1];
-          edge_n2B2 = treenodes[n2].edge[2];
-        } else if (treenodes[n2].nbr[1] == n1) {
-          B1 = treenodes[n2].nbr[0];
-          B2 = treenodes[n2].nbr[2];
-          edge_n2B1 = treenodes[n2].edge[0];
-          edge_n2B2 = treenodes[n2].edge[2];
-        } else {
-          B1 = treenodes[n2].nbr[0];
-          B2 = treenodes[n2].nbr[1];
-          edge_n2B1 = treenodes[n2].edge[0];
-          edge_n2B2 = treenodes[n2].edge[1];
+        // if E2 is on (n2, B2), switch B1 and B2 so that E2 is always on
+        // (n2, B1)
+        if (endpt1 == B2 || endpt2 == B2) {
+          std::swap(B1, B2);
+          std::swap(edge_n2B1, edge_n2B2);
         }
 
-        if (endpt1 == n2 || endpt2 == n2)  // E2 is on (n2, B1) or (n2, B2)
-        {
-          // if E2 is on (n2, B2), switch B1 and B2 so that E2 is always on
-          // (n2, B1)
-          if (endpt1 == B2 || endpt2 == B2) {
-            std::swap(B1, B2);
-            std::swap(edge_n2B1, edge_n2B2);
-          }
+        // update route for edge (n2, B1), (n2, B2)
+        bool route_ok = updateRouteType1(netID,
+                                         treenodes,
+                                         n2,
+                                         B1,
+                                         B2,
+                                         E2x,
+                                         E2y,
+                                         treeedges,
+                                         edge_n2B1,
+                                         edge_n2B2);
+        if (!route_ok) {
+          debugPrint(logger_,
+                     utl::GRT,
+                     "maze_2d",
+                     1,
+                     "Net {} has errors during updateRouteType1.",
+                     nets_[netID]->getName());
+          return false;
+        }
 
-          // update route for edge (n2, B1), (n2, B2)
-          bool route_ok = updateRouteType1(netID,
-                                           treenodes,
-                                           n2,
-                                           B1,
-                                           B2,
-                                           E2x,
-                                           E2y,
-                                           treeedges,
-                                           edge_n2B1,
-                                           edge_n2B2);
-          if (!route_ok) {
-            debugPrint(logger_,
-                       utl::GRT,
-                       "maze_2d",
-                       1,
-                       "Net {} has errors during updateRouteType1.",
-                       nets_[netID]->getName());
-            reInitTree(netID);
-            nidRPC--;
+        // update position for n2
+        treenodes[n2].x = E2x;
+        treenodes[n2].y = E2y;
+      }     // if E2 is on (n2, B1) or (n2, B2)
+      else  // E2 is not on (n2, B1) or (n2, B2), but on (D1, D2)
+      {
+        const int D1 = endpt1;
+        const int D2 = endpt2;
+        const int edge_D1D2 = corr_edge[E2y][E2x];
+
+        // update route for edge (n2, D1), (n2, D2) and (B1, B2)
+        bool route_ok = updateRouteType2(netID,
+                                         treenodes,
+                                         n2,
+                                         B1,
+                                         B2,
+                                         D1,
+                                         D2,
+                                         E2x,
+                                         E2y,
+                                         treeedges,
+                                         edge_n2B1,
+                                         edge_n2B2,
+                                         edge_D1D2);
+        if (!route_ok) {
+          debugPrint(logger_,
+                     utl::GRT,
+                     "maze_2d",
+                     1,
+                     "Net {} has errors during updateRouteType2.",
+                     nets_[netID]->getName());
+          return false;
+        }
+        // update position for n2
+        treenodes[n2].x = E2x;
+        treenodes[n2].y = E2y;
+        // update 3 edges (n2, B1)->(D1, n2), (n2, B2)->(n2, D2), (D1,
+        // D2)->(B1, B2)
+        const int edge_n2D1 = edge_n2B1;
+        treeedges[edge_n2D1].n1 = D1;
+        treeedges[edge_n2D1].n2 = n2;
+        const int edge_n2D2 = edge_n2B2;
+        treeedges[edge_n2D2].n1 = n2;
+        treeedges[edge_n2D2].n2 = D2;
+        const int edge_B1B2 = edge_D1D2;
+        treeedges[edge_B1B2].n1 = B1;
+        treeedges[edge_B1B2].n2 = B2;
+        // update nbr and edge for 5 nodes n2, B1, B2, D1, D2
+        // n1's nbr (n1, B1, B2)->(n1, D1, D2)
+        treenodes[n2].nbr[0] = n1;
+        treenodes[n2].edge[0] = edge_n1n2;
+        treenodes[n2].nbr[1] = D1;
+        treenodes[n2].edge[1] = edge_n2D1;
+        treenodes[n2].nbr[2] = D2;
+        treenodes[n2].edge[2] = edge_n2D2;
+        // B1's nbr n2->B2
+        for (int i = 0; i < 3; i++) {
+          if (treenodes[B1].nbr[i] == n2) {
+            treenodes[B1].nbr[i] = B2;
+            treenodes[B1].edge[i] = edge_B1B2;
             break;
           }
-
-          // update position for n2
-          treenodes[n2].x = E2x;
-          treenodes[n2].y = E2y;
-        }     // if E2 is on (n2, B1) or (n2, B2)
-        else  // E2 is not on (n2, B1) or (n2, B2), but on (D1, D2)
-        {
-          const int D1 = endpt1;
-          const int D2 = endpt2;
-          const int edge_D1D2 = corr_edge_[E2y][E2x];
-
-          // update route for edge (n2, D1), (n2, D2) and (B1, B2)
-          bool route_ok = updateRouteType2(netID,
-                                           treenodes,
-                                           n2,
-                                           B1,
-                                           B2,
-                                           D1,
-                                           D2,
-                                           E2x,
-                                           E2y,
-                                           treeedges,
-                                           edge_n2B1,
-                                           edge_n2B2,
-                                           edge_D1D2);
-          if (!route_ok) {
-            debugPrint(logger_,
-                       utl::GRT,
-                       "maze_2d",
-                       1,
-                       "Net {} has errors during updateRouteType2.",
-                       nets_[netID]->getName());
-            reInitTree(netID);
-            nidRPC--;
+        }
+        // B2's nbr n2->B1
+        for (int i = 0; i < 3; i++) {
+          if (treenodes[B2].nbr[i] == n2) {
+            treenodes[B2].nbr[i] = B1;
+            treenodes[B2].edge[i] = edge_B1B2;
             break;
           }
-          // update position for n2
-          treenodes[n2].x = E2x;
-          treenodes[n2].y = E2y;
-          // update 3 edges (n2, B1)->(D1, n2), (n2, B2)->(n2, D2), (D1,
-          // D2)->(B1, B2)
-          const int edge_n2D1 = edge_n2B1;
-          treeedges[edge_n2D1].n1 = D1;
-          treeedges[edge_n2D1].n2 = n2;
-          const int edge_n2D2 = edge_n2B2;
-          treeedges[edge_n2D2].n1 = n2;
-          treeedges[edge_n2D2].n2 = D2;
-          const int edge_B1B2 = edge_D1D2;
-          treeedges[edge_B1B2].n1 = B1;
-          treeedges[edge_B1B2].n2 = B2;
-          // update nbr and edge for 5 nodes n2, B1, B2, D1, D2
-          // n1's nbr (n1, B1, B2)->(n1, D1, D2)
-          treenodes[n2].nbr[0] = n1;
-          treenodes[n2].edge[0] = edge_n1n2;
-          treenodes[n2].nbr[1] = D1;
-          treenodes[n2].edge[1] = edge_n2D1;
-          treenodes[n2].nbr[2] = D2;
-          treenodes[n2].edge[2] = edge_n2D2;
-          // B1's nbr n2->B2
-          for (int i = 0; i < 3; i++) {
-            if (treenodes[B1].nbr[i] == n2) {
-              treenodes[B1].nbr[i] = B2;
-              treenodes[B1].edge[i] = edge_B1B2;
-              break;
-            }
-          }
-          // B2's nbr n2->B1
-          for (int i = 0; i < 3; i++) {
-            if (treenodes[B2].nbr[i] == n2) {
-              treenodes[B2].nbr[i] = B1;
-              treenodes[B2].edge[i] = edge_B1B2;
-              break;
-            }
-          }
-          // D1's nbr D2->n2
-          for (int i = 0; i < 3; i++) {
-            if (treenodes[D1].nbr[i] == D2) {
-              treenodes[D1].nbr[i] = n2;
-              treenodes[D1].edge[i] = edge_n2D1;
-              break;
-            }
+        }
+        // D1's nbr D2->n2
+        for (int i = 0; i < 3; i++) {
+          if (treenodes[D1].nbr[i] == D2) {
+            treenodes[D1].nbr[i] = n2;
+            treenodes[D1].edge[i] = edge_n2D1;
+            break;
           }
-          // D2's nbr D1->n2
-          for (int i = 0; i < 3; i++) {
-            if (treenodes[D2].nbr[i] == D1) {
-              treenodes[D2].nbr[i] = n2;
-              treenodes[D2].edge[i] = edge_n2D2;
-              break;
-            }
+        }
+        // D2's nbr D1->n2
+        for (int i = 0; i < 3; i++) {
+          if (treenodes[D2].nbr[i] == D1) {
+            treenodes[D2].nbr[i] = n2;
+            treenodes[D2].edge[i] = edge_n2D2;
+            break;
           }
-        }  // else E2 is not on (n2, B1) or (n2, B2), but on (D1, D2)
-      }    // n2 is not a pin and E2!=n2
+        }
+      }  // else E2 is not on (n2, B1) or (n2, B2), but on (D1, D2)
+    }    // n2 is not a pin and E2!=n2
 
-      // update route for edge (n1, n2) and edge usage
-      if (treeedges[edge_n1n2].route.type == RouteType::MazeRoute) {
-        treeedges[edge_n1n2].route.gridsX.clear();
-        treeedges[edge_n1n2].route.gridsY.clear();
-      }
-      treeedges[edge_n1n2].route.gridsX.resize(cnt_n1n2, 0);
-      treeedges[edge_n1n2].route.gridsY.resize(cnt_n1n2, 0);
-      treeedges[edge_n1n2].route.type = RouteType::MazeRoute;
-      treeedges[edge_n1n2].route.routelen = cnt_n1n2 - 1;
-      treeedges[edge_n1n2].len = abs(E1x - E2x) + abs(E1y - E2y);
-
-      for (int i = 0; i < cnt_n1n2; i++) {
-        treeedges[edge_n1n2].route.gridsX[i] = gridsX[i];
-        treeedges[edge_n1n2].route.gridsY[i] = gridsY[i];
-      }
+    // update route for edge (n1, n2) and edge usage
+    if (treeedges[edge_n1n2].route.type == RouteType::MazeRoute) {
+      treeedges[edge_n1n2].route.gridsX.clear();
+      treeedges[edge_n1n2].route.gridsY.clear();
+    }
+    treeedges[edge_n1n2].route.gridsX.resize(cnt_n1n2, 0);
+    treeedges[edge_n1n2].route.gridsY.resize(cnt_n1n2, 0);
+    treeedges[edge_n1n2].route.type = RouteType::MazeRoute;
+    treeedges[edge_n1n2].route.routelen = cnt_n1n2 - 1;
+    treeedges[edge_n1n2].len = abs(E1x - E2x) + abs(E1y - E2y);
 
-      int edgeCost = nets_[netID]->getEdgeCost();
+    for (int i = 0; i < cnt_n1n2; i++) {
+      treeedges[edge_n1n2].route.gridsX[i] = gridsX[i];
+      treeedges[edge_n1n2].route.gridsY[i] = gridsY[i];
+    }
 
-      // update edge usage
-      for (int i = 0; i < cnt_n1n2 - 1; i++) {
-        if (gridsX[i] == gridsX[i + 1])  // a vertical edge
-        {
-          const int min_y = std::min(gridsY[i], gridsY[i + 1]);
-          v_edges_[min_y][gridsX[i]].usage += edgeCost;
-          v_used_ggrid_.insert(std::make_pair(min_y, gridsX[i]));
-        } else  /// if(gridsY[i]==gridsY[i+1])// a horizontal edge
-        {
-          const int min_x = std::min(gridsX[i], gridsX[i + 1]);
-          h_edges_[gridsY[i]][min_x].usage += edgeCost;
-          h_used_ggrid_.insert(std::make_pair(gridsY[i], min_x));
-        }
+    int edgeCost = nets_[netID]->getEdgeCost();
+
+    // update edge usage
+    for (int i = 0; i < cnt_n1n2 - 1; i++) {
+      if (gridsX[i] == gridsX[i + 1])  // a vertical edge
+      {
+        const int min_y = std::min(gridsY[i], gridsY[i + 1]);
+        v_edges_[min_y][gridsX[i]].usage += edgeCost;
+        scratch.v_used_ggrid.emplace_back(min_y, gridsX[i]);
+      } else  /// if(gridsY[i]==gridsY[i+1])// a horizontal edge
+      {
+        const int min_x = std::min(gridsX[i], gridsX[i + 1]);
+        h_edges_[gridsY[i]][min_x].usage += edgeCost;
+        scratch.h_used_ggrid.emplace_back(gridsY[i], min_x);
       }
-    }  // loop edgeID
-  }    // loop netID
+    }
+  }  // loop edgeID
 
-  h_cost_table_.clear();
-  v_cost_table_.clear();
+  return true;
 }
 
 void FastRouteCore::findCongestedEdgesNets(
@@ -1159,6 +1159,7 @@ void FastRouteCore::routeMonotonic(int netID,
                                    int edgeID,
                                    multi_array<double, 2>& d1,
                                    multi_array<double, 2>& d2,
+                                   const std::vector<double>& cost_table,
                                    int threshold,
                                    int enlarge)
 {
@@ -1227,8 +1228,8 @@ void FastRouteCore::routeMonotonic(int netID,
   for (int j = ymin; j <= ymax; j++) {
     for (int i = xmin; i < xmax; i++) {
       size_t index = h_edges_[j][i].usage_red();
-      index = std::min(index, h_cost_table_.size() - 1);
-      const double tmp = h_cost_table_[index];
+      index = std::min(index, cost_table.size() - 1);
+      const double tmp = cost_table[index];
       d1[j][i + 1] = d1[j][i] + tmp;
     }
     // update the cost of a column of grids by v-edges
@@ -1238,8 +1239,8 @@ void FastRouteCore::routeMonotonic(int netID,
     // update the cost of a column of grids by h-edges
     for (int i = xmin; i <= xmax; i++) {
       size_t index = v_edges_[j][i].usage_red();
-      index = std::min(index, h_cost_table_.size() - 1);
-      const double tmp = h_cost_table_[index];
+      index = std::min(index, cost_table.size() - 1);
+      const double tmp = cost_table[index];
       d2[j + 1][i] = d2[j][i] + tmp;
     }
     // update the cost of a column of grids by v-edges
@@ -1469,11 +1470,11 @@ void FastRouteCore::routeMonotonicAll(int threshold,
              threshold,
              expand);
 
-  h_cost_table_.resize(10 * h_capacity_);
-
-  const int forange = 10 * h_capacity_;
-  for (int i = 0; i < forange; i++) {
-    h_cost_table_[i]
+  // Kept in double, unlike the maze tables, to match the costs it was
+  // tuned with.
+  std::vector<double> cost_table(10 * h_capacity_);
+  for (int i = 0; i < 10 * h_capacity_; i++) {
+    cost_table[i]
         = costheight_ / (exp((double) (h_capacity_ - i) * logis_cof) + 1) + 1;
   }
 
@@ -1487,11 +1488,11 @@ void FastRouteCore::routeMonotonicAll(int threshold,
                      edgeID,
                      d1,
                      d2,
+                     cost_table,
                      threshold,
                      expand);  // ripup previous route and do Monotonic routing
     }
   }
-  h_cost_table_.clear();
 }
 
 void FastRouteCore::newrouteLInMaze(int netID)
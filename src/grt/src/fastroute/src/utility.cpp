@@ -32,7 +32,12 @@
 
 #include <algorithm>
 #include <fstream>
+#include <istream>
+#include <ostream>
 #include <queue>
+#include <string>
+#include <tuple>
+#include <unordered_set>
 
 #include "DataType.h"
 #include "FastRoute.h"
@@ -1669,20 +1674,21 @@ static bool compareEdgeLen(const OrderNetEdge a, const OrderNetEdge b)
   return a.length > b.length;
 }
 
-void FastRouteCore::netedgeOrderDec(int netID)
+void FastRouteCore::netedgeOrderDec(int netID,
+                                    std::vector<OrderNetEdge>& net_eo)
 {
   const int numTreeedges = sttrees_[netID].num_edges();
 
-  net_eo_.clear();
+  net_eo.clear();
 
   for (int j = 0; j < numTreeedges; j++) {
     OrderNetEdge orderNet;
     orderNet.length = sttrees_[netID].edges[j].route.routelen;
     orderNet.edgeID = j;
-    net_eo_.push_back(orderNet);
+    net_eo.push_back(orderNet);
   }
 
-  std::stable_sort(net_eo_.begin(), net_eo_.end(), compareEdgeLen);
+  std::stable_sort(net_eo.begin(), net_eo.end(), compareEdgeLen);
 }
 
 void FastRouteCore::printEdge2D(int netID, int edgeID)
@@ -2777,6 +2783,338 @@ void FastRouteCore::setTreeNodesVariables(const int netID)
   }  // loop edges
 }
 
+// The route state is stored as whitespace separated text: a header with
+// the grid dimensions, the congestion history of the 2D edges and, for each
+// net, its pins and Steiner tree with the routes of the tree edges. Edge
+// usage is not stored; it is rebuilt from the restored routes.
+static const char* state_magic = "grt_state";
+static constexpr int state_version = 1;
+
+static void writeGrids(std::ostream& out, const std::vector<int16_t>& grids)
+{
+  out << " " << grids.size();
+  for (const int16_t grid : grids) {
+    out << " " << grid;
+  }
+}
+
+void FastRouteCore::writeState(std::ostream& out)
+{
+  out << state_magic << " " << state_version << "\n";
+  out << x_grid_ << " " << y_grid_ << " " << num_layers_ << " " << tile_size_
+      << " " << x_corner_ << " " << y_corner_ << "\n";
+  out << total_overflow_ << " " << has_2D_overflow_ << "\n";
+
+  for (int i = 0; i < y_grid_; i++) {
+    for (int j = 0; j < x_grid_ - 1; j++) {
+      out << h_edges_[i][j].congCNT << " " << h_edges_[i][j].last_usage
+          << " ";
+    }
+    out << "\n";
+  }
+  for (int i = 0; i < y_grid_ - 1; i++) {
+    for (int j = 0; j < x_grid_; j++) {
+      out << v_edges_[i][j].congCNT << " " << v_edges_[i][j].last_usage
+          << " ";
+    }
+    out << "\n";
+  }
+
+  std::vector<int> net_ids;
+  for (int netID = 0; netID < netCount(); netID++) {
+    if (nets_[netID] != nullptr && !sttrees_[netID].nodes.empty()) {
+      net_ids.push_back(netID);
+    }
+  }
+  out << net_ids.size() << "\n";
+
+  for (const int netID : net_ids) {
+    const FrNet* net = nets_[netID];
+    const StTree& stree = sttrees_[netID];
+    out << net->getName() << " " << net->getEdgeCost() << " "
+        << net->getMinLayer() << " " << net->getMaxLayer() << " "
+        << net->getNumPins();
+    for (int i = 0; i < net->getNumPins(); i++) {
+      out << " " << net->getPinX(i) << " " << net->getPinY(i) << " "
+          << net->getPinL(i);
+    }
+    out << "\n";
+
+    out << stree.num_terminals << " " << stree.num_nodes() << " "
+        << stree.num_edges() << "\n";
+    for (const TreeNode& node : stree.nodes) {
+      out << node.x << " " << node.y << " " << node.assigned << " "
+          << node.status << " " << node.botL << " " << node.topL << " "
+          << node.hID << " " << node.lID << " " << node.stackAlias << " "
+          << node.nbr_count;
+      for (int i = 0; i < 3; i++) {
+        out << " " << node.nbr[i] << " " << node.edge[i];
+      }
+      out << " " << node.conCNT;
+      for (int i = 0; i < node.conCNT; i++) {
+        out << " " << node.heights[i] << " " << node.eID[i];
+      }
+      out << "\n";
+    }
+    for (const TreeEdge& edge : stree.edges) {
+      const Route& route = edge.route;
+      out << edge.assigned << " " << edge.len << " " << edge.n1 << " "
+          << edge.n1a << " " << edge.n2 << " " << edge.n2a << " "
+          << static_cast<int>(route.type) << " " << route.xFirst << " "
+          << route.HVH << " " << route.Zpoint << " " << route.routelen << " "
+          << route.last_routelen;
+      writeGrids(out, route.gridsX);
+      writeGrids(out, route.gridsY);
+      writeGrids(out, route.gridsL);
+      out << "\n";
+    }
+  }
+}
+
+static void checkState(const bool valid, utl::Logger* logger)
+{
+  if (!valid) {
+    logger->error(GRT, 269, "Invalid global route state.");
+  }
+}
+
+template <typename T>
+static void readValue(std::istream& in, T& value, utl::Logger* logger)
+{
+  checkState(static_cast<bool>(in >> value), logger);
+}
+
+static int readSize(std::istream& in, utl::Logger* logger)
+{
+  int size;
+  readValue(in, size, logger);
+  checkState(size >= 0, logger);
+  return size;
+}
+
+static void readGrids(std::istream& in,
+                      std::vector<int16_t>& grids,
+                      utl::Logger* logger)
+{
+  grids.resize(readSize(in, logger));
+  for (int16_t& grid : grids) {
+    readValue(in, grid, logger);
+  }
+}
+
+static bool inRange(const int value, const int size)
+{
+  return value >= 0 && value < size;
+}
+
+// Checks that the tree indexes only its own nodes and edges, and that the
+// nodes and routes stay inside the grid.
+static bool isValidTree(const StTree& stree,
+                        const int x_grid,
+                        const int y_grid,
+                        const int num_layers)
+{
+  const int num_nodes = stree.num_nodes();
+  const int num_edges = stree.num_edges();
+  for (const TreeNode& node : stree.nodes) {
+    if (!inRange(node.x, x_grid) || !inRange(node.y, y_grid)
+        || node.conCNT < 0 || node.conCNT > TreeNode::max_connections
+        || node.nbr_count < 0 || node.nbr_count > 3) {
+      return false;
+    }
+    for (int i = 0; i < node.nbr_count; i++) {
+      if (!inRange(node.nbr[i], num_nodes)
+          || !inRange(node.edge[i], num_edges)) {
+        return false;
+      }
+    }
+    for (int i = 0; i < node.conCNT; i++) {
+      if (!inRange(node.eID[i], num_edges)
+          || !inRange(node.heights[i], num_layers)) {
+        return false;
+      }
+    }
+  }
+  for (const TreeEdge& edge : stree.edges) {
+    const Route& route = edge.route;
+    if (!inRange(edge.n1, num_nodes) || !inRange(edge.n2, num_nodes)
+        || !inRange(edge.n1a, num_nodes) || !inRange(edge.n2a, num_nodes)) {
+      return false;
+    }
+    if (route.routelen <= 0) {
+      continue;
+    }
+    const int num_grids = route.routelen + 1;
+    if (static_cast<int>(route.gridsX.size()) < num_grids
+        || static_cast<int>(route.gridsY.size()) < num_grids
+        || static_cast<int>(route.gridsL.size()) < num_grids) {
+      return false;
+    }
+    for (int i = 0; i < num_grids; i++) {
+      if (!inRange(route.gridsX[i], x_grid) || !inRange(route.gridsY[i], y_grid)
+          || !inRange(route.gridsL[i], num_layers)) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+NetRouteMap FastRouteCore::readState(std::istream& in,
+                                     std::vector<odb::dbNet*>& unrouted_nets)
+{
+  std::string magic;
+  int version;
+  readValue(in, magic, logger_);
+  readValue(in, version, logger_);
+  if (magic != state_magic || version != state_version) {
+    logger_->error(GRT, 270, "Unsupported global route state format.");
+  }
+
+  int x_grid, y_grid, num_layers, tile_size, x_corner, y_corner;
+  readValue(in, x_grid, logger_);
+  readValue(in, y_grid, logger_);
+  readValue(in, num_layers, logger_);
+  readValue(in, tile_size, logger_);
+  readValue(in, x_corner, logger_);
+  readValue(in, y_corner, logger_);
+  if (x_grid != x_grid_ || y_grid != y_grid_ || num_layers != num_layers_
+      || tile_size != tile_size_ || x_corner != x_corner_
+      || y_corner != y_corner_) {
+    logger_->error(GRT,
+                   271,
+                   "Global route state grid {}x{}x{} does not match the "
+                   "current grid {}x{}x{}.",
+                   x_grid,
+                   y_grid,
+                   num_layers,
+                   x_grid_,
+                   y_grid_,
+                   num_layers_);
+  }
+  readValue(in, total_overflow_, logger_);
+  readValue(in, has_2D_overflow_, logger_);
+
+  for (int i = 0; i < y_grid_; i++) {
+    for (int j = 0; j < x_grid_ - 1; j++) {
+      readValue(in, h_edges_[i][j].congCNT, logger_);
+      readValue(in, h_edges_[i][j].last_usage, logger_);
+    }
+  }
+  for (int i = 0; i < y_grid_ - 1; i++) {
+    for (int j = 0; j < x_grid_; j++) {
+      readValue(in, v_edges_[i][j].congCNT, logger_);
+      readValue(in, v_edges_[i][j].last_usage, logger_);
+    }
+  }
+
+  // Only the nets waiting to be routed are restored, and only when their
+  // pins and layer range did not change since the state was written.
+  std::unordered_set<int> pending(net_ids_.begin(), net_ids_.end());
+  std::vector<int> restored;
+  odb::dbBlock* block = db_->getChip()->getBlock();
+
+  int num_nets;
+  readValue(in, num_nets, logger_);
+  for (int n = 0; n < num_nets; n++) {
+    std::string name;
+    int edge_cost, min_layer, max_layer;
+    readValue(in, name, logger_);
+    readValue(in, edge_cost, logger_);
+    readValue(in, min_layer, logger_);
+    readValue(in, max_layer, logger_);
+    std::vector<std::tuple<int, int, int>> pins(readSize(in, logger_));
+    for (auto& [x, y, l] : pins) {
+      readValue(in, x, logger_);
+      readValue(in, y, logger_);
+      readValue(in, l, logger_);
+    }
+
+    StTree stree;
+    readValue(in, stree.num_terminals, logger_);
+    stree.nodes.resize(readSize(in, logger_));
+    stree.edges.resize(readSize(in, logger_));
+    for (TreeNode& node : stree.nodes) {
+      readValue(in, node.x, logger_);
+      readValue(in, node.y, logger_);
+      readValue(in, node.assigned, logger_);
+      readValue(in, node.status, logger_);
+      readValue(in, node.botL, logger_);
+      readValue(in, node.topL, logger_);
+      readValue(in, node.hID, logger_);
+      readValue(in, node.lID, logger_);
+      readValue(in, node.stackAlias, logger_);
+      readValue(in, node.nbr_count, logger_);
+      for (int i = 0; i < 3; i++) {
+        readValue(in, node.nbr[i], logger_);
+        readValue(in, node.edge[i], logger_);
+      }
+      readValue(in, node.conCNT, logger_);
+      checkState(node.conCNT <= TreeNode::max_connections, logger_);
+      for (int i = 0; i < node.conCNT; i++) {
+        readValue(in, node.heights[i], logger_);
+        readValue(in, node.eID[i], logger_);
+      }
+    }
+    for (TreeEdge& edge : stree.edges) {
+      Route& route = edge.route;
+      int type;
+      readValue(in, edge.assigned, logger_);
+      readValue(in, edge.len, logger_);
+      readValue(in, edge.n1, logger_);
+      readValue(in, edge.n1a, logger_);
+      readValue(in, edge.n2, logger_);
+      readValue(in, edge.n2a, logger_);
+      readValue(in, type, logger_);
+      route.type = static_cast<RouteType>(type);
+      readValue(in, route.xFirst, logger_);
+      readValue(in, route.HVH, logger_);
+      readValue(in, route.Zpoint, logger_);
+      readValue(in, route.routelen, logger_);
+      readValue(in, route.last_routelen, logger_);
+      readGrids(in, route.gridsX, logger_);
+      readGrids(in, route.gridsY, logger_);
+      readGrids(in, route.gridsL, logger_);
+    }
+    checkState(isValidTree(stree, x_grid_, y_grid_, num_layers_), logger_);
+
+    odb::dbNet* db_net = block->findNet(name.c_str());
+    auto itr = db_net_id_map_.find(db_net);
+    if (db_net == nullptr || itr == db_net_id_map_.end()
+        || pending.find(itr->second) == pending.end()) {
+      continue;
+    }
+    const int netID = itr->second;
+    const FrNet* net = nets_[netID];
+    std::vector<std::tuple<int, int, int>> net_pins;
+    for (int i = 0; i < net->getNumPins(); i++) {
+      net_pins.emplace_back(net->getPinX(i), net->getPinY(i), net->getPinL(i));
+    }
+    std::sort(pins.begin(), pins.end());
+    std::sort(net_pins.begin(), net_pins.end());
+    if (pins != net_pins || edge_cost != net->getEdgeCost()
+        || min_layer != net->getMinLayer() || max_layer != net->getMaxLayer()) {
+      continue;
+    }
+
+    sttrees_[netID] = std::move(stree);
+    reserveNetResources(netID);
+    restored.push_back(netID);
+    pending.erase(netID);
+  }
+
+  for (const int netID : net_ids_) {
+    if (pending.find(netID) != pending.end()) {
+      unrouted_nets.push_back(nets_[netID]->getDbNet());
+    }
+  }
+
+  net_ids_ = std::move(restored);
+  NetRouteMap routes = getRoutes();
+  net_ids_.clear();
+  return routes;
+}
+
 std::ostream& operator<<(std::ostream& os, RouteType type)
 {
   switch (type) {
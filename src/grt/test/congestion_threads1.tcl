@@ -0,0 +1,24 @@
+# congestion iterations of uart_i2c_usb_top on 1 and 4 threads give the
+# same guides
+source "helpers.tcl"
+read_lef "overlapping_edges.lef"
+read_def "overlapping_edges.def"
+
+set_global_routing_layer_adjustment * 0.3
+
+set_routing_layers -signal met1-met5
+
+set guide_files {}
+foreach threads {1 4} {
+  set_thread_count $threads
+  global_route
+  set guide_file [make_result_file congestion_threads1_$threads.guide]
+  write_guides $guide_file
+  lappend guide_files $guide_file
+}
+
+if { [diff_files {*}$guide_files] == 0 } {
+  puts "pass"
+} else {
+  puts "fail: the guides depend on the number of threads"
+}
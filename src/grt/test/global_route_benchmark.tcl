@@ -0,0 +1,59 @@
+# Times congested global routing of uart_i2c_usb_top and reports the peak
+# resident memory.  Not part of the regressions.  The environment variables
+# below set the thread counts, the runs per thread count, the layer
+# adjustment and the congestion iterations, e.g.
+#   GRT_BENCH_THREADS="1 2 4 8" openroad global_route_benchmark.tcl
+source "helpers.tcl"
+
+proc bench_param { name default } {
+  if { [info exists ::env($name)] } {
+    return $::env($name)
+  }
+  return $default
+}
+
+set thread_counts [bench_param GRT_BENCH_THREADS "1 4"]
+set runs [bench_param GRT_BENCH_RUNS 3]
+set adjustment [bench_param GRT_BENCH_ADJUSTMENT 0.3]
+set iterations [bench_param GRT_BENCH_ITERATIONS 100]
+
+proc peak_rss_kb { } {
+  if { [catch { open "/proc/self/status" r } stream] } {
+    return "unknown"
+  }
+  set peak "unknown"
+  while { [gets $stream line] >= 0 } {
+    if { [regexp {^VmHWM:\s+(\d+)} $line -> kb] } {
+      set peak $kb
+    }
+  }
+  close $stream
+  return $peak
+}
+
+read_lef "overlapping_edges.lef"
+read_def "overlapping_edges.def"
+
+set_global_routing_layer_adjustment * $adjustment
+
+set_routing_layers -signal met1-met5
+
+set ref_guide_file ""
+foreach threads $thread_counts {
+  set_thread_count $threads
+  set start [clock milliseconds]
+  for { set i 0 } { $i < $runs } { incr i } {
+    global_route -allow_congestion -congestion_iterations $iterations
+  }
+  set elapsed [expr { [clock milliseconds] - $start }]
+  puts "global_route $threads threads: [expr { $elapsed / $runs }] ms per run"
+
+  set guide_file [make_result_file global_route_benchmark_$threads.guide]
+  write_guides $guide_file
+  if { $ref_guide_file == "" } {
+    set ref_guide_file $guide_file
+  } elseif { [diff_files $ref_guide_file $guide_file] } {
+    puts "guides on $threads threads differ from [lindex $thread_counts 0]"
+  }
+}
+puts "peak rss: [peak_rss_kb] kB"
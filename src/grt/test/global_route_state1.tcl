@@ -0,0 +1,22 @@
+# write and restore the global route state of gcd_nangate45
+source "helpers.tcl"
+read_lef "Nangate45/Nangate45.lef"
+read_def "gcd.def"
+
+set state_file [make_result_file global_route_state1.state]
+set guide_file1 [make_result_file global_route_state1-1.guide]
+set guide_file2 [make_result_file global_route_state1-2.guide]
+
+global_route
+write_guides $guide_file1
+
+write_global_route_state $state_file
+read_global_route_state $state_file
+
+write_guides $guide_file2
+
+if { [diff_files $guide_file1 $guide_file2] == 0 } {
+  puts "pass"
+} else {
+  puts "fail: the restored routes differ"
+}
@@ -0,0 +1,73 @@
+# restore the global route state of gcd_nangate45 after read_db and moving
+# an instance
+source "helpers.tcl"
+read_lef "Nangate45/Nangate45.lef"
+read_def "gcd.def"
+
+set db_file [make_result_file global_route_state2.odb]
+set state_file [make_result_file global_route_state2.state]
+set guide_file1 [make_result_file global_route_state2-1.guide]
+set guide_file2 [make_result_file global_route_state2-2.guide]
+
+proc read_net_guides { file_name } {
+  set guides [dict create]
+  set stream [open $file_name r]
+  while { [gets $stream line] >= 0 } {
+    if { $line == "(" } {
+      continue
+    } elseif { $line == ")" } {
+      dict set guides $net $boxes
+    } elseif { [llength $line] == 1 } {
+      set net $line
+      set boxes {}
+    } else {
+      lappend boxes $line
+    }
+  }
+  close $stream
+  return $guides
+}
+
+global_route
+write_guides $guide_file1
+write_db $db_file
+write_global_route_state $state_file
+
+clear
+read_db $db_file
+
+set inst [[ord::get_db_block] findInst _438_]
+$inst setLocation 92720 106400
+set moved_nets {}
+foreach iterm [$inst getITerms] {
+  set net [$iterm getNet]
+  if { $net != "NULL" && [$net getSigType] == "SIGNAL" } {
+    lappend moved_nets [$net getName]
+  }
+}
+
+read_global_route_state $state_file
+write_guides $guide_file2
+
+# Only the nets of the moved instance are rerouted, the other nets keep
+# their routes.
+set guides1 [read_net_guides $guide_file1]
+set guides2 [read_net_guides $guide_file2]
+set errors {}
+dict for {net boxes} $guides1 {
+  if { ![dict exists $guides2 $net] } {
+    lappend errors "net $net has no guides"
+  } elseif { $boxes ne [dict get $guides2 $net]
+             && [lsearch -exact $moved_nets $net] == -1 } {
+    lappend errors "net $net was rerouted"
+  }
+}
+if { [llength $moved_nets] == 0 } {
+  lappend errors "_438_ has no signal nets"
+}
+
+if { [llength $errors] == 0 } {
+  puts "pass"
+} else {
+  puts "fail: [join $errors {, }]"
+}
@@ -77,3 +77,10 @@ record_tests {
   #grt_man_tcl_check
   #grt_readme_msgs_check
 }
+
+record_pass_fail_tests {
+  congestion_threads1
+  global_route_state1
+  global_route_state2
+  rudy_update1
+}
@@ -0,0 +1,41 @@
+# check that updating RUDY after moving instances matches a new calculation
+from openroad import Tech, Design
+import grt_aux
+
+tech = Tech()
+tech.readLef("Nangate45/Nangate45.lef")
+
+design = Design(tech)
+design.readDef("gcd.def")
+gr = design.getGlobalRouter()
+
+grt_aux.set_routing_layers(design, signal="metal2-metal10")
+
+rudy = gr.getRudy()
+rudy.calculateRudy()
+grid_size = rudy.getGridSize()
+x_grids = grid_size[0]
+y_grids = grid_size[1]
+
+block = design.getBlock()
+for name, dx, dy in [("_438_", 20000, 0), ("_439_", -14000, 8400)]:
+    inst = block.findInst(name)
+    bbox = inst.getBBox().getBox()
+    inst.setLocation(bbox.xMin() + dx, bbox.yMin() + dy)
+
+rudy.updateRudy()
+updated = [
+    [rudy.getTile(x, y).getRudy() for y in range(y_grids)] for x in range(x_grids)
+]
+
+rudy.calculateRudy()
+max_error = 0.0
+for x in range(x_grids):
+    for y in range(y_grids):
+        error = abs(updated[x][y] - rudy.getTile(x, y).getRudy())
+        max_error = max(max_error, error)
+
+if max_error < 1e-3:
+    print("pass")
+else:
+    print(f"fail: updated RUDY differs from the new calculation by {max_error}")
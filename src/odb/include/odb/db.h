@@ -95,6 +95,7 @@ class dbCapNode;
 class dbRSeg;
 class dbCCSeg;
 class dbBlockSearch;
+class dbSpatialIndex;
 class dbRow;
 class dbFill;
 class dbTechAntennaPinModel;
@@ -397,17 +398,20 @@ class dbDatabase : public dbObject
   uint getNumberOfMasters();
 
   ///
-  /// Read a database from this stream.
+  /// Read a database from this stream.  Compressed databases are detected
+  /// automatically.
   /// WARNING: This function destroys the data currently in the database.
   /// Throws ZIOError..
   ///
   void read(std::istream& f);
 
   ///
-  /// Write a database to this stream.
+  /// Write a database to this stream.  If compress is true the database is
+  /// written as block-compressed chunks, compressed on getThreadCount()
+  /// threads.
   /// Throws ZIOError..
   ///
-  void write(std::ostream& file);
+  void write(std::ostream& file, bool compress = false);
 
   ///
   /// ECO - The following methods implement a simple ECO mechanism for capturing
@@ -463,11 +467,53 @@ class dbDatabase : public dbObject
   ///
   static void undoEco(dbBlock* block);
 
+  ///
+  /// Incremental checkpoints - after beginCheckpoint() the edits made to
+  /// the block are journaled and each writeCheckpoint() writes only the
+  /// edits made since the previous checkpoint.  The block is restored by
+  /// reading the database written when checkpointing began and then
+  /// replaying each checkpoint in order with readCheckpoint().
+  ///
+  /// NOTE: Only the edits the ECO journal records are captured (netlist
+  ///       changes, instance placement and net/parasitic fields).  Any
+  ///       other edit (wires, pins, rows, tracks, blockages, regions,
+  ///       groups, properties, hierarchy, ...) makes writeCheckpoint()
+  ///       fail; checkpointMissesEdits() reports them so the caller can
+  ///       write a full database and begin again.
+  ///
+  static void beginCheckpoint(dbBlock* block);
+  static bool inCheckpoint(dbBlock* block);
+  static bool checkpointMissesEdits(dbBlock* block);
+  static void writeCheckpoint(dbBlock* block, std::ostream& file);
+  static void readCheckpoint(dbBlock* block, std::istream& file);
+
+  ///
+  /// Returns true if the stream holds a checkpoint rather than a database.
+  ///
+  static bool isCheckpoint(std::istream& file);
+
   ///
   /// links to utl::Logger
   ///
   void setLogger(utl::Logger* logger);
 
+  ///
+  /// Set the number of threads odb may use internally, e.g. to decode the
+  /// sections of a database file concurrently in read().
+  ///
+  void setThreadCount(int threads);
+  int getThreadCount();
+
+  ///
+  /// If lazy loading is enabled, read() leaves the wires and parasitics
+  /// (dbWire, dbRSeg, dbCapNode, dbCCSeg) of each block encoded and decodes
+  /// them the first time they are accessed.  Blocks whose wires and
+  /// parasitics are never accessed are written back out without decoding
+  /// them.
+  ///
+  void setLazyLoading(bool lazy);
+  bool getLazyLoading();
+
   ///
   /// Initializes the database to nothing.
   ///
@@ -1464,6 +1510,13 @@ class dbBlock : public dbObject
   ///
   dbBlockSearch* getSearchDb();
 
+  ///
+  /// Get the shared spatial index over the insts, special wires and wires
+  /// of this block (see dbSpatialIndex.h). It is created on first use and
+  /// kept up to date as the block is edited.
+  ///
+  dbSpatialIndex* getSpatialIndex();
+
   ///
   /// destroy coupling caps of nets
   ///
@@ -33,6 +33,7 @@
 #pragma once
 
 #include <list>
+#include <vector>
 
 #include "odb.h"
 
@@ -80,6 +81,20 @@ class dbBlockCallBackObj
   virtual void inDbInstSwapMasterAfter(dbInst*) {}
   virtual void inDbPreMoveInst(dbInst*) {}
   virtual void inDbPostMoveInst(dbInst*) {}
+  // Bulk moves (dbPlacementSnapshot::commit) call these instead of the
+  // per-instance move callbacks.  By default they call those for each inst.
+  virtual void inDbPreMoveInsts(const std::vector<dbInst*>& insts)
+  {
+    for (dbInst* inst : insts) {
+      inDbPreMoveInst(inst);
+    }
+  }
+  virtual void inDbPostMoveInsts(const std::vector<dbInst*>& insts)
+  {
+    for (dbInst* inst : insts) {
+      inDbPostMoveInst(inst);
+    }
+  }
   // dbInst End
 
   // dbNet Start
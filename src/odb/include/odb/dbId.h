@@ -87,4 +87,11 @@ class dbId
   }
 };
 
+// dbId<T> streams exactly as its underlying unsigned int.
+template <class T>
+struct dbBulkStreamable<dbId<T>> : std::true_type
+{
+  static_assert(sizeof(dbId<T>) == sizeof(unsigned int));
+};
+
 }  // namespace odb
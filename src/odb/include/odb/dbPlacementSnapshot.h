@@ -0,0 +1,106 @@
+///////////////////////////////////////////////////////////////////////////////
+// BSD 3-Clause License
+//
+// Copyright (c) 2024, The Regents of the University of California
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include <vector>
+
+#include "odb/dbTypes.h"
+
+namespace odb {
+
+class dbBlock;
+class dbInst;
+class dbITerm;
+class dbNet;
+
+//
+// dbPlacementSnapshot - Flat arrays of a block's placement data.
+//
+// Placers and sizers need instance locations and sizes, pin offsets and
+// net connectivity as arrays.  capture() builds them in one pass over the
+// block, computing each master's pin offsets once per orientation, instead
+// of every tool walking the instances and iterms itself.  Instance indices
+// follow block->getInsts() order and a pin's index is its position in
+// pins.
+//
+// commit() writes edited inst_x / inst_y back as one bulk move.
+//
+class dbPlacementSnapshot
+{
+ public:
+  void capture(dbBlock* block);
+
+  // Moves the instances whose inst_x / inst_y were changed since capture to
+  // their new location (see dbInst::setLocation).  The block's callbacks
+  // are notified once for all of them with inDbPreMoveInsts /
+  // inDbPostMoveInsts.  Returns the number of instances moved.
+  int commit();
+
+  // Instances
+  std::vector<dbInst*> insts;
+  // Lower left corner of the instance bounding box
+  std::vector<int> inst_x;
+  std::vector<int> inst_y;
+  // Size of the instance bounding box
+  std::vector<int> inst_width;
+  std::vector<int> inst_height;
+  std::vector<dbOrientType::Value> inst_orient;
+  std::vector<dbPlacementStatus::Value> inst_status;
+  // The pins of instance i are pins[inst_pin_begin[i]] up to
+  // pins[inst_pin_begin[i + 1]]
+  std::vector<int> inst_pin_begin;
+
+  // Pins (the instance iterms)
+  std::vector<dbITerm*> pins;
+  std::vector<int> pin_inst;
+  // Index into nets or -1 if the pin is not connected
+  std::vector<int> pin_net;
+  // Center of the pin's master terminal relative to (inst_x, inst_y)
+  std::vector<int> pin_offset_x;
+  std::vector<int> pin_offset_y;
+
+  // Nets connected to at least one pin, in block->getNets() order
+  std::vector<dbNet*> nets;
+  // The pins of net n are net_pins[net_pin_begin[n]] up to
+  // net_pins[net_pin_begin[n + 1]]
+  std::vector<int> net_pin_begin;
+  std::vector<int> net_pins;
+
+ private:
+  dbBlock* block_ = nullptr;
+  // Locations at capture, to find the instances commit has to move
+  std::vector<int> captured_x_;
+  std::vector<int> captured_y_;
+};
+
+}  // namespace odb
@@ -0,0 +1,136 @@
+///////////////////////////////////////////////////////////////////////////////
+// BSD 3-Clause License
+//
+// Copyright (c) 2024, The Regents of the University of California
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include <atomic>
+#include <boost/geometry.hpp>
+#include <boost/geometry/index/rtree.hpp>
+#include <map>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "odb/db.h"
+#include "odb/dbBlockCallBackObj.h"
+#include "odb/geom.h"
+#include "odb/geom_boost.h"
+
+namespace odb {
+
+class dbTechLayer;
+
+//
+// dbSpatialIndex - Region queries over the shapes of a block.
+//
+// The index is owned by its block (see dbBlock::getSpatialIndex) so every
+// tool shares one copy.  Each kind of object is indexed the first time it
+// is queried and from then on kept up to date from the dbBlockCallBackObj
+// notifications.  Queries may run concurrently with each other but not
+// with edits to the block.
+//
+class dbSpatialIndex : public dbBlockCallBackObj
+{
+ public:
+  dbSpatialIndex(dbBlock* block);
+
+  // Placed instances whose bounding box intersects region.
+  std::vector<dbInst*> findInsts(const Rect& region);
+
+  // Special wire boxes on layer that intersect region.  A via is found on
+  // each of its layers.
+  std::vector<dbSBox*> findSBoxes(dbTechLayer* layer, const Rect& region);
+
+  // Shapes of routed wires on layer that intersect region.
+  std::vector<std::pair<Rect, dbNet*>> findWireShapes(dbTechLayer* layer,
+                                                      const Rect& region);
+
+  // dbBlockCallBackObj
+  void inDbInstDestroy(dbInst* inst) override;
+  void inDbInstPlacementStatusBefore(dbInst* inst,
+                                     const dbPlacementStatus& status) override;
+  void inDbInstSwapMasterBefore(dbInst* inst, dbMaster* master) override;
+  void inDbInstSwapMasterAfter(dbInst* inst) override;
+  void inDbPreMoveInst(dbInst* inst) override;
+  void inDbPostMoveInst(dbInst* inst) override;
+  void inDbPreMoveInsts(const std::vector<dbInst*>& insts) override;
+  void inDbPostMoveInsts(const std::vector<dbInst*>& insts) override;
+  void inDbSWireAddSBox(dbSBox* box) override;
+  void inDbSWireRemoveSBox(dbSBox* box) override;
+  void inDbSWirePreDestroySBoxes(dbSWire* wire) override;
+  void inDbWireDestroy(dbWire* wire) override;
+  void inDbWirePostModify(dbWire* wire) override;
+  void inDbWirePostAppend(dbWire* src, dbWire* dst) override;
+
+ private:
+  template <typename T>
+  using Value = std::pair<Rect, T>;
+  template <typename T>
+  using RTree = boost::geometry::index::
+      rtree<Value<T>, boost::geometry::index::quadratic<16>>;
+  template <typename T>
+  using LayerTrees = std::map<dbTechLayer*, RTree<T>>;
+
+  void buildInsts();
+  void buildSBoxes();
+  void buildWires();
+
+  void addInst(dbInst* inst);
+  void removeInst(dbInst* inst);
+  void getSBoxShapes(dbSBox* box,
+                     std::vector<std::pair<dbTechLayer*, Rect>>& shapes);
+  void addSBox(dbSBox* box);
+  void removeSBox(dbSBox* box);
+  void getWireShapes(dbWire* wire,
+                     std::vector<std::pair<dbTechLayer*, Rect>>& shapes);
+  void addWire(dbWire* wire);
+  void removeWire(dbWire* wire);
+
+  dbBlock* block_;
+
+  RTree<dbInst*> insts_;
+  std::atomic_bool insts_built_{false};
+
+  LayerTrees<dbSBox*> sboxes_;
+  std::atomic_bool sboxes_built_{false};
+
+  LayerTrees<dbWire*> wires_;
+  // Wire shapes are only found by querying, so remember where each wire
+  // was to remove its shapes after the wire has changed.
+  std::unordered_map<dbWire*, Rect> wire_bboxes_;
+  std::atomic_bool wires_built_{false};
+
+  std::mutex build_mutex_;
+};
+
+}  // namespace odb
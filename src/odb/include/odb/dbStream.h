@@ -36,8 +36,10 @@
 #include <cstdint>
 #include <cstring>
 #include <istream>
+#include <memory>
 #include <ostream>
 #include <string>
+#include <type_traits>
 #include <unordered_map>
 #include <variant>
 
@@ -54,6 +56,22 @@ class _dbDatabase;
 
 inline constexpr size_t kTemplateRecursionLimit = 16;
 
+// Size of the staging buffer used by dbOStream/dbIStream.  Values are
+// accumulated here and handed to the underlying stream in large blocks
+// rather than one iostream call per scalar.
+inline constexpr size_t kStreamBufferSize = 1 << 16;
+
+//
+// Types whose in-memory representation is identical to the byte sequence
+// produced by streaming them one at a time.  Containers of such types are
+// copied to/from the stream in bulk instead of element by element.
+//
+template <typename T>
+struct dbBulkStreamable
+    : std::bool_constant<std::is_arithmetic_v<T> && !std::is_same_v<T, bool>>
+{
+};
+
 class dbOStream
 {
   using Position = std::ostream::pos_type;
@@ -68,6 +86,9 @@ class dbOStream
   double _lef_area_factor;
   double _lef_dist_factor;
   std::vector<Scope> _scopes;
+  std::unique_ptr<char[]> _buffer;
+  size_t _buffer_used;
+  uint64_t _flushed_bytes;
 
   // By default values are written as their string ("255" vs 0xFF)
   // representations when using the << stream method. In dbOstream we are
@@ -75,11 +96,38 @@ class dbOStream
   template <typename T>
   void writeValueAsBytes(T type)
   {
-    _f.write(reinterpret_cast<char*>(&type), sizeof(T));
+    writeBytes(&type, sizeof(T));
   }
 
+  void writeBytesSlow(const void* data, size_t size);
+
  public:
   dbOStream(_dbDatabase* db, std::ostream& f);
+  ~dbOStream();
+
+  // Copy size raw bytes to the stream.
+  void writeBytes(const void* data, size_t size)
+  {
+    if (_buffer_used + size <= kStreamBufferSize) {
+      std::memcpy(_buffer.get() + _buffer_used, data, size);
+      _buffer_used += size;
+    } else {
+      writeBytesSlow(data, size);
+    }
+  }
+
+  // Hand any buffered bytes to the underlying std::ostream.
+  void flush();
+
+  // Total number of bytes written through this stream.
+  uint64_t bytesWritten() const { return _flushed_bytes + _buffer_used; }
+
+  // True if the underlying std::ostream can seek, so patchBytes works.
+  bool canPatch();
+
+  // Overwrite size bytes written earlier at offset, a bytesWritten() value,
+  // and continue at the end.  Requires canPatch().
+  void patchBytes(uint64_t offset, const void* data, size_t size);
 
   _dbDatabase* getDatabase() { return _db; }
 
@@ -162,7 +210,7 @@ class dbOStream
     } else {
       int l = strlen(c) + 1;
       *this << l;
-      _f.write(c, l);
+      writeBytes(c, l);
     }
 
     return *this;
@@ -225,8 +273,12 @@ class dbOStream
   {
     uint sz = m.size();
     *this << sz;
-    for (auto val : m) {
-      *this << val;
+    if constexpr (dbBulkStreamable<T1>::value) {
+      writeBytes(m.data(), sz * sizeof(T1));
+    } else {
+      for (auto val : m) {
+        *this << val;
+      }
     }
     return *this;
   }
@@ -234,17 +286,21 @@ class dbOStream
   template <class T, std::size_t SIZE>
   dbOStream& operator<<(const std::array<T, SIZE>& a)
   {
-    for (auto& val : a) {
-      *this << val;
+    if constexpr (dbBulkStreamable<T>::value) {
+      writeBytes(a.data(), SIZE * sizeof(T));
+    } else {
+      for (auto& val : a) {
+        *this << val;
+      }
     }
     return *this;
   }
 
   dbOStream& operator<<(const std::string& s)
   {
-    char* tmp = strdup(s.c_str());
-    *this << tmp;
-    free((void*) tmp);
+    int l = s.size() + 1;
+    *this << l;
+    writeBytes(s.c_str(), l);
     return *this;
   }
 
@@ -268,7 +324,10 @@ class dbOStream
   double lefarea(int value) { return ((double) value * _lef_area_factor); }
   double lefdist(int value) { return ((double) value * _lef_dist_factor); }
 
-  Position pos() const { return _f.tellp(); }
+  Position pos() const
+  {
+    return _f.tellp() + static_cast<std::streamoff>(_buffer_used);
+  }
 
   void pushScope(const std::string& name);
   void popScope();
@@ -295,9 +354,41 @@ class dbIStream
   _dbDatabase* _db;
   double _lef_area_factor;
   double _lef_dist_factor;
+  std::unique_ptr<char[]> _buffer;
+  size_t _buffer_pos;
+  size_t _buffer_end;
+  uint64_t _fetched_bytes;
+
+  template <typename T>
+  void readValueAsBytes(T& type)
+  {
+    readBytes(&type, sizeof(T));
+  }
+
+  void readBytesSlow(void* data, size_t size);
 
  public:
   dbIStream(_dbDatabase* db, std::istream& f);
+  ~dbIStream();
+
+  // Copy size raw bytes from the stream.  A short read sets
+  // failbit|eofbit on the underlying std::istream (which throws if the
+  // caller enabled exceptions on it).
+  void readBytes(void* data, size_t size)
+  {
+    if (_buffer_end - _buffer_pos >= size) {
+      std::memcpy(data, _buffer.get() + _buffer_pos, size);
+      _buffer_pos += size;
+    } else {
+      readBytesSlow(data, size);
+    }
+  }
+
+  // Total number of bytes consumed through this stream.
+  uint64_t bytesRead() const
+  {
+    return _fetched_bytes - (_buffer_end - _buffer_pos);
+  }
 
   _dbDatabase* getDatabase() { return _db; }
 
@@ -311,67 +402,67 @@ class dbIStream
 
   dbIStream& operator>>(char& c)
   {
-    _f.read(reinterpret_cast<char*>(&c), sizeof(c));
+    readValueAsBytes(c);
     return *this;
   }
 
   dbIStream& operator>>(unsigned char& c)
   {
-    _f.read(reinterpret_cast<char*>(&c), sizeof(c));
+    readValueAsBytes(c);
     return *this;
   }
 
   dbIStream& operator>>(int16_t& c)
   {
-    _f.read(reinterpret_cast<char*>(&c), sizeof(c));
+    readValueAsBytes(c);
     return *this;
   }
 
   dbIStream& operator>>(uint16_t& c)
   {
-    _f.read(reinterpret_cast<char*>(&c), sizeof(c));
+    readValueAsBytes(c);
     return *this;
   }
 
   dbIStream& operator>>(int& c)
   {
-    _f.read(reinterpret_cast<char*>(&c), sizeof(c));
+    readValueAsBytes(c);
     return *this;
   }
 
   dbIStream& operator>>(uint64_t& c)
   {
-    _f.read(reinterpret_cast<char*>(&c), sizeof(c));
+    readValueAsBytes(c);
     return *this;
   }
 
   dbIStream& operator>>(unsigned int& c)
   {
-    _f.read(reinterpret_cast<char*>(&c), sizeof(c));
+    readValueAsBytes(c);
     return *this;
   }
 
   dbIStream& operator>>(int8_t& c)
   {
-    _f.read(reinterpret_cast<char*>(&c), sizeof(c));
+    readValueAsBytes(c);
     return *this;
   }
 
   dbIStream& operator>>(float& c)
   {
-    _f.read(reinterpret_cast<char*>(&c), sizeof(c));
+    readValueAsBytes(c);
     return *this;
   }
 
   dbIStream& operator>>(double& c)
   {
-    _f.read(reinterpret_cast<char*>(&c), sizeof(c));
+    readValueAsBytes(c);
     return *this;
   }
 
   dbIStream& operator>>(long double& c)
   {
-    _f.read(reinterpret_cast<char*>(&c), sizeof(c));
+    readValueAsBytes(c);
     return *this;
   }
 
@@ -384,7 +475,7 @@ class dbIStream
       c = nullptr;
     } else {
       c = (char*) malloc(l);
-      _f.read(reinterpret_cast<char*>(c), l);
+      readBytes(c, l);
     }
 
     return *this;
@@ -392,7 +483,7 @@ class dbIStream
 
   dbIStream& operator>>(dbObjectType& c)
   {
-    _f.read(reinterpret_cast<char*>(&c), sizeof(c));
+    readValueAsBytes(c);
     return *this;
   }
 
@@ -437,11 +528,17 @@ class dbIStream
   {
     uint sz;
     *this >> sz;
-    m.reserve(sz);
-    for (uint i = 0; i < sz; i++) {
-      T1 val;
-      *this >> val;
-      m.push_back(val);
+    if constexpr (dbBulkStreamable<T1>::value) {
+      const size_t start = m.size();
+      m.resize(start + sz);
+      readBytes(m.data() + start, sz * sizeof(T1));
+    } else {
+      m.reserve(sz);
+      for (uint i = 0; i < sz; i++) {
+        T1 val;
+        *this >> val;
+        m.push_back(val);
+      }
     }
     return *this;
   }
@@ -449,8 +546,12 @@ class dbIStream
   template <class T, std::size_t SIZE>
   dbIStream& operator>>(std::array<T, SIZE>& a)
   {
-    for (std::size_t i = 0; i < SIZE; i++) {
-      *this >> a[i];
+    if constexpr (dbBulkStreamable<T>::value) {
+      readBytes(a.data(), SIZE * sizeof(T));
+    } else {
+      for (std::size_t i = 0; i < SIZE; i++) {
+        *this >> a[i];
+      }
     }
     return *this;
   }
@@ -0,0 +1,145 @@
+///////////////////////////////////////////////////////////////////////////////
+// BSD 3-Clause License
+//
+// Copyright (c) 2024, The Regents of the University of California
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "odb/dbBlockCallBackObj.h"
+#include "odb/dbShape.h"
+#include "odb/geom.h"
+
+namespace odb {
+
+class dbBlock;
+class dbNet;
+class dbTechLayer;
+class dbWire;
+
+//
+// dbWireShapeDecoder - Decodes the shapes of whole wires in one pass.
+//
+// The shapes are the ones dbWireShapeItr returns, in the same order.  The
+// decoder remembers layer widths and via boxes between wires and follows
+// junctions through a table of the points decoded so far instead of
+// walking the wire backwards, so decoding many wires with one decoder is
+// much cheaper than iterating them.
+//
+class dbWireShapeDecoder
+{
+ public:
+  dbWireShapeDecoder(dbBlock* block);
+
+  // Appends the shapes of wire.  If shape_ids is given the dbWire shape id
+  // of each shape is appended to it.
+  void decode(dbWire* wire,
+              std::vector<dbShape>& shapes,
+              std::vector<int>* shape_ids = nullptr);
+
+  // Decodes the wires of nets using the database thread count.  shapes[i]
+  // holds the shapes of nets[i], which is empty for nets without a wire.
+  static void decode(const std::vector<dbNet*>& nets,
+                     std::vector<std::vector<dbShape>>& shapes);
+
+ private:
+  struct LayerInfo
+  {
+    bool valid = false;
+    int half_width = 0;
+    // Half width of segments that run across the preferred direction
+    int wrong_way_half_width = 0;
+    bool horizontal = false;
+    bool vertical = false;
+  };
+
+  struct ViaInfo
+  {
+    bool valid = false;
+    bool has_box = false;
+    Rect box;
+    dbTechLayer* top = nullptr;
+    dbTechLayer* bottom = nullptr;
+  };
+
+  const LayerInfo& layerInfo(dbTechLayer* layer);
+  const ViaInfo& viaInfo(int id, bool tech_via);
+
+  dbBlock* block_;
+  std::vector<LayerInfo> layers_;
+  std::vector<ViaInfo> block_vias_;
+  std::vector<ViaInfo> tech_vias_;
+
+  // Point and layer as of each opcode of the wire being decoded
+  std::vector<int> xs_;
+  std::vector<int> ys_;
+  std::vector<dbTechLayer*> point_layers_;
+};
+
+//
+// dbWireShapeCache - Decoded wire shapes kept until the wire changes.
+//
+// Readers that look at the same wires again and again (DEF export,
+// extraction, rendering) can share the decoded geometry.  Entries are
+// dropped from the dbBlockCallBackObj notifications for wire edits.  The
+// cache may be read from several threads but not while the block is being
+// edited.
+//
+class dbWireShapeCache : public dbBlockCallBackObj
+{
+ public:
+  dbWireShapeCache(dbBlock* block);
+
+  // The shapes of wire, decoded on first use.  The reference is valid until
+  // the wire is changed or destroyed.
+  const std::vector<dbShape>& getShapes(dbWire* wire);
+
+  // Decodes the wires of nets that are not cached yet in parallel.
+  void prefetch(const std::vector<dbNet*>& nets);
+
+  void clear();
+
+  // dbBlockCallBackObj
+  void inDbWireDestroy(dbWire* wire) override;
+  void inDbWirePostModify(dbWire* wire) override;
+  void inDbWirePostAppend(dbWire* src, dbWire* dst) override;
+
+ private:
+  void invalidate(dbWire* wire);
+
+  dbBlock* block_;
+  std::unordered_map<dbWire*, std::vector<dbShape>> shapes_;
+  std::mutex mutex_;
+};
+
+}  // namespace odb
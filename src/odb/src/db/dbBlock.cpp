@@ -115,6 +115,7 @@
 #include "dbSBoxItr.h"
 #include "dbSWire.h"
 #include "dbSWireItr.h"
+#include "dbStreamSections.h"
 #include "dbTable.h"
 #include "dbTable.hpp"
 #include "dbTech.h"
@@ -129,6 +130,7 @@
 #include "odb/dbDiff.h"
 #include "odb/dbExtControl.h"
 #include "odb/dbShape.h"
+#include "odb/dbSpatialIndex.h"
 #include "odb/defout.h"
 #include "odb/lefout.h"
 #include "odb/parse.h"
@@ -419,9 +421,17 @@ _dbBlock::_dbBlock(_dbDatabase* db)
 
   _num_ext_dbs = 1;
   _searchDb = nullptr;
+  _spatial_index = nullptr;
   _extmi = nullptr;
   _journal = nullptr;
   _journal_pending = nullptr;
+  _deferred_wires = nullptr;
+  _deferred_parasitics = nullptr;
+  _checkpointing = false;
+  _checkpoint_seq = 0;
+  _checkpoint_wires_changed = false;
+  _checkpoint_digest = 0;
+  _checkpoint_tracker = nullptr;
 }
 
 _dbBlock::_dbBlock(_dbDatabase* db, const _dbBlock& block)
@@ -465,6 +475,9 @@ _dbBlock::_dbBlock(_dbDatabase* db, const _dbBlock& block)
       _currentCcAdjOrder(block._currentCcAdjOrder),
       _dft(block._dft)
 {
+  block.loadWires();
+  block.loadParasitics();
+
   if (block._name) {
     _name = strdup(block._name);
     ZALLOCATED(_name);
@@ -630,8 +643,16 @@ _dbBlock::_dbBlock(_dbDatabase* db, const _dbBlock& block)
 
   // ??? _ext?
   _extmi = block._extmi;
+  _spatial_index = nullptr;
   _journal = nullptr;
   _journal_pending = nullptr;
+  _deferred_wires = nullptr;
+  _deferred_parasitics = nullptr;
+  _checkpointing = false;
+  _checkpoint_seq = 0;
+  _checkpoint_wires_changed = false;
+  _checkpoint_digest = 0;
+  _checkpoint_tracker = nullptr;
 }
 
 _dbBlock::~_dbBlock()
@@ -716,6 +737,9 @@ _dbBlock::~_dbBlock()
   delete _prop_itr;
   delete _dft_tbl;
 
+  delete _spatial_index;
+  delete _checkpoint_tracker;
+
   std::list<dbBlockCallBackObj*>::iterator _cbitr;
   while (_callbacks.begin() != _callbacks.end()) {
     _cbitr = _callbacks.begin();
@@ -728,6 +752,9 @@ _dbBlock::~_dbBlock()
   {
     delete _journal_pending;
   }
+
+  delete _deferred_wires;
+  delete _deferred_parasitics;
 }
 
 void dbBlock::clear()
@@ -883,6 +910,7 @@ dbObjectTable* _dbBlock::getObjectTable(dbObjectType type)
       return _blockage_tbl;
 
     case dbWireObj:
+      loadWires();
       return _wire_tbl;
 
     case dbSWireObj:
@@ -892,12 +920,15 @@ dbObjectTable* _dbBlock::getObjectTable(dbObjectType type)
       return _sbox_tbl;
 
     case dbCapNodeObj:
+      loadParasitics();
       return _cap_node_tbl;
 
     case dbRSegObj:
+      loadParasitics();
       return _r_seg_tbl;
 
     case dbCCSegObj:
+      loadParasitics();
       return _cc_seg_tbl;
 
     case dbRowObj:
@@ -934,6 +965,79 @@ dbObjectTable* _dbBlock::getObjectTable(dbObjectType type)
   return getTable()->getObjectTable(type);
 }
 
+dbDeferredSections* _dbBlock::getDeferredSections(const char* section) const
+{
+  if (strcmp(section, "wire_tbl") == 0) {
+    return _deferred_wires;
+  }
+  for (const char* parasitic : {"r_val_tbl",
+                                "c_val_tbl",
+                                "cc_val_tbl",
+                                "cap_node_tbl",
+                                "r_seg_tbl",
+                                "cc_seg_tbl"}) {
+    if (strcmp(section, parasitic) == 0) {
+      return _deferred_parasitics;
+    }
+  }
+  return nullptr;
+}
+
+//
+// Visit the tables of a block that are streamed as independent sections,
+// in stream order.
+//
+template <typename Block, typename Visitor>
+static void visitSections(Block& block, Visitor&& visit)
+{
+  visit("bterm_tbl", *block._bterm_tbl);
+  visit("iterm_tbl", *block._iterm_tbl);
+  visit("net_tbl", *block._net_tbl);
+  visit("inst_hdr_tbl", *block._inst_hdr_tbl);
+  visit("inst_tbl", *block._inst_tbl);
+  visit("module_tbl", *block._module_tbl);
+  visit("modinst_tbl", *block._modinst_tbl);
+  visit("modbterm_tbl", *block._modbterm_tbl);
+  visit("moditerm_tbl", *block._moditerm_tbl);
+  visit("modnet_tbl", *block._modnet_tbl);
+  visit("powerdomain_tbl", *block._powerdomain_tbl);
+  visit("logicport_tbl", *block._logicport_tbl);
+  visit("powerswitch_tbl", *block._powerswitch_tbl);
+  visit("isolation_tbl", *block._isolation_tbl);
+  visit("levelshifter_tbl", *block._levelshifter_tbl);
+  visit("group_tbl", *block._group_tbl);
+  visit("ap_tbl", *block.ap_tbl_);
+  visit("global_connect_tbl", *block.global_connect_tbl_);
+  visit("guide_tbl", *block._guide_tbl);
+  visit("net_tracks_tbl", *block._net_tracks_tbl);
+  visit("box_tbl", *block._box_tbl);
+  visit("via_tbl", *block._via_tbl);
+  visit("gcell_grid_tbl", *block._gcell_grid_tbl);
+  visit("track_grid_tbl", *block._track_grid_tbl);
+  visit("obstruction_tbl", *block._obstruction_tbl);
+  visit("blockage_tbl", *block._blockage_tbl);
+  visit("wire_tbl", *block._wire_tbl);
+  visit("swire_tbl", *block._swire_tbl);
+  visit("sbox_tbl", *block._sbox_tbl);
+  visit("row_tbl", *block._row_tbl);
+  visit("fill_tbl", *block._fill_tbl);
+  visit("region_tbl", *block._region_tbl);
+  visit("hier_tbl", *block._hier_tbl);
+  visit("bpin_tbl", *block._bpin_tbl);
+  visit("non_default_rule_tbl", *block._non_default_rule_tbl);
+  visit("layer_rule_tbl", *block._layer_rule_tbl);
+  visit("prop_tbl", *block._prop_tbl);
+  visit("name_cache", *block._name_cache);
+  visit("r_val_tbl", *block._r_val_tbl);
+  visit("c_val_tbl", *block._c_val_tbl);
+  visit("cc_val_tbl", *block._cc_val_tbl);
+  visit("cap_node_tbl", *block._cap_node_tbl);
+  visit("r_seg_tbl", *block._r_seg_tbl);
+  visit("cc_seg_tbl", *block._cc_seg_tbl);
+  visit("ext_control", *block._extControl);
+  visit("dft_tbl", *block._dft_tbl);
+}
+
 dbOStream& operator<<(dbOStream& stream, const _dbBlock& block)
 {
   std::list<dbBlockCallBackObj*>::const_iterator cbitr;
@@ -991,56 +1095,20 @@ dbOStream& operator<<(dbOStream& stream, const _dbBlock& block)
   stream << block._component_mask_shift;
   stream << block._currentCcAdjOrder;
 
-  stream << *block._bterm_tbl;
-  stream << *block._iterm_tbl;
-  stream << *block._net_tbl;
-  stream << *block._inst_hdr_tbl;
-  stream << *block._inst_tbl;
-  stream << *block._module_tbl;
-  stream << *block._modinst_tbl;
-  if (db->isSchema(db_schema_update_hierarchy)) {
-    stream << *block._modbterm_tbl;
-    stream << *block._moditerm_tbl;
-    stream << *block._modnet_tbl;
-  }
-  stream << *block._powerdomain_tbl;
-  stream << *block._logicport_tbl;
-  stream << *block._powerswitch_tbl;
-  stream << *block._isolation_tbl;
-  stream << *block._levelshifter_tbl;
-  stream << *block._group_tbl;
-  stream << *block.ap_tbl_;
-  stream << *block.global_connect_tbl_;
-  stream << *block._guide_tbl;
-  stream << *block._net_tracks_tbl;
-  stream << *block._box_tbl;
-  stream << *block._via_tbl;
-  stream << *block._gcell_grid_tbl;
-  stream << *block._track_grid_tbl;
-  stream << *block._obstruction_tbl;
-  stream << *block._blockage_tbl;
-  stream << *block._wire_tbl;
-  stream << *block._swire_tbl;
-  stream << *block._sbox_tbl;
-  stream << *block._row_tbl;
-  stream << *block._fill_tbl;
-  stream << *block._region_tbl;
-  stream << *block._hier_tbl;
-  stream << *block._bpin_tbl;
-  stream << *block._non_default_rule_tbl;
-  stream << *block._layer_rule_tbl;
-  stream << *block._prop_tbl;
-
-  stream << *block._name_cache;
-  stream << *block._r_val_tbl;
-  stream << *block._c_val_tbl;
-  stream << *block._cc_val_tbl;
-  stream << NamedTable("cap_node_tbl", block._cap_node_tbl);
-  stream << NamedTable("r_seg_tbl", block._r_seg_tbl);
-  stream << NamedTable("cc_seg_tbl", block._cc_seg_tbl);
-  stream << *block._extControl;
+  dbSectionWriter sections(stream);
+  visitSections(block, [&block, &sections](const char* name, auto& table) {
+    // Tables that were never decoded go back out as they came in.
+    const dbDeferredSections* deferred = block.getDeferredSections(name);
+    const std::string* encoded
+        = deferred ? deferred->findEncoded(name) : nullptr;
+    if (encoded) {
+      sections.addEncoded(name, *encoded);
+    } else {
+      sections.add(name, [&table](dbOStream& stream) { stream << table; });
+    }
+  });
+  sections.write();
   stream << block._dft;
-  stream << *block._dft_tbl;
 
   //---------------------------------------------------------- stream out
   // properties
@@ -1059,6 +1127,79 @@ dbOStream& operator<<(dbOStream& stream, const _dbBlock& block)
   return stream;
 }
 
+//
+// Write-only streambuf that folds everything written to it into a 64-bit
+// FNV-1a hash.
+//
+class dbDigestBuf : public std::streambuf
+{
+ public:
+  uint64_t digest() const { return hash_; }
+
+ protected:
+  int_type overflow(int_type c) override
+  {
+    if (!traits_type::eq_int_type(c, traits_type::eof())) {
+      add(traits_type::to_char_type(c));
+    }
+    return traits_type::not_eof(c);
+  }
+  std::streamsize xsputn(const char* s, std::streamsize n) override
+  {
+    for (std::streamsize i = 0; i < n; ++i) {
+      add(s[i]);
+    }
+    return n;
+  }
+
+ private:
+  void add(char c)
+  {
+    hash_ = (hash_ ^ static_cast<unsigned char>(c)) * 1099511628211ULL;
+  }
+
+  uint64_t hash_ = 14695981039346656037ULL;
+};
+
+uint64_t _dbBlock::getUnjournaledDigest() const
+{
+  // The journal records these tables, module_tbl included as it only
+  // changes with the instances of a module.  The wires are left out too:
+  // they are too big to hash at every checkpoint, so _checkpoint_tracker
+  // watches them instead.  A journaled edit can still change a hashed
+  // table (destroying a net drops its guides), which only costs a full
+  // write.
+  static const std::set<std::string> journaled = {"bterm_tbl",
+                                                  "iterm_tbl",
+                                                  "net_tbl",
+                                                  "inst_hdr_tbl",
+                                                  "inst_tbl",
+                                                  "module_tbl",
+                                                  "wire_tbl",
+                                                  "swire_tbl",
+                                                  "sbox_tbl",
+                                                  "name_cache",
+                                                  "r_val_tbl",
+                                                  "c_val_tbl",
+                                                  "cc_val_tbl",
+                                                  "cap_node_tbl",
+                                                  "r_seg_tbl",
+                                                  "cc_seg_tbl"};
+  dbDigestBuf digest;
+  std::ostream out(&digest);
+  dbOStream stream(getImpl()->getDatabase(), out);
+  stream << _die_area;
+  stream << _blocked_regions_for_pins;
+  visitSections(*this, [&stream](const char* name, auto& table) {
+    if (journaled.find(name) == journaled.end()) {
+      stream << table;
+    }
+  });
+  stream << _dft;
+  stream.flush();
+  return digest.digest();
+}
+
 dbIStream& operator>>(dbIStream& stream, _dbBlock& block)
 {
   _dbDatabase* db = block.getImpl()->getDatabase();
@@ -1123,62 +1264,84 @@ dbIStream& operator>>(dbIStream& stream, _dbBlock& block)
     stream >> block._component_mask_shift;
   }
   stream >> block._currentCcAdjOrder;
-  stream >> *block._bterm_tbl;
-  stream >> *block._iterm_tbl;
-  stream >> *block._net_tbl;
-  stream >> *block._inst_hdr_tbl;
-  stream >> *block._inst_tbl;
-  stream >> *block._module_tbl;
-  stream >> *block._modinst_tbl;
-  if (db->isSchema(db_schema_update_hierarchy)) {
-    stream >> *block._modbterm_tbl;
-    stream >> *block._moditerm_tbl;
-    stream >> *block._modnet_tbl;
-  }
-  stream >> *block._powerdomain_tbl;
-  stream >> *block._logicport_tbl;
-  stream >> *block._powerswitch_tbl;
-  stream >> *block._isolation_tbl;
-  if (db->isSchema(db_schema_level_shifter)) {
-    stream >> *block._levelshifter_tbl;
-  }
-  stream >> *block._group_tbl;
-  stream >> *block.ap_tbl_;
-  if (db->isSchema(db_schema_add_global_connect)) {
-    stream >> *block.global_connect_tbl_;
-  }
-  stream >> *block._guide_tbl;
-  if (db->isSchema(db_schema_net_tracks)) {
-    stream >> *block._net_tracks_tbl;
-  }
-  stream >> *block._box_tbl;
-  stream >> *block._via_tbl;
-  stream >> *block._gcell_grid_tbl;
-  stream >> *block._track_grid_tbl;
-  stream >> *block._obstruction_tbl;
-  stream >> *block._blockage_tbl;
-  stream >> *block._wire_tbl;
-  stream >> *block._swire_tbl;
-  stream >> *block._sbox_tbl;
-  stream >> *block._row_tbl;
-  stream >> *block._fill_tbl;
-  stream >> *block._region_tbl;
-  stream >> *block._hier_tbl;
-  stream >> *block._bpin_tbl;
-  stream >> *block._non_default_rule_tbl;
-  stream >> *block._layer_rule_tbl;
-  stream >> *block._prop_tbl;
-  stream >> *block._name_cache;
-  stream >> *block._r_val_tbl;
-  stream >> *block._c_val_tbl;
-  stream >> *block._cc_val_tbl;
-  stream >> *block._cap_node_tbl;  // DKF
-  stream >> *block._r_seg_tbl;     // DKF
-  stream >> *block._cc_seg_tbl;
-  stream >> *block._extControl;
-  if (db->isSchema(db_schema_add_scan)) {
+  if (db->isSchema(db_schema_block_sections)) {
+    // Every table is self-contained so they can be decoded concurrently.
+    // The hash tables were read above, so there is nothing to fix up.
+    //
+    // A lazy read leaves the wire and parasitic tables encoded until first
+    // use.  That is only done for files of the current schema so the
+    // encoded bytes can be written back out verbatim.
+    if (db->_lazy_loading && db->_schema_minor == db_schema_minor) {
+      block._deferred_wires = new dbDeferredSections(db);
+      block._deferred_parasitics = new dbDeferredSections(db);
+    }
+    dbSectionReader sections(stream);
+    visitSections(block, [&block, &sections](const char* name, auto& table) {
+      sections.add(
+          name,
+          [&table](dbIStream& stream) { stream >> table; },
+          block.getDeferredSections(name));
+    });
+    sections.read(db->_thread_count);
     stream >> block._dft;
-    stream >> *block._dft_tbl;
+  } else {
+    stream >> *block._bterm_tbl;
+    stream >> *block._iterm_tbl;
+    stream >> *block._net_tbl;
+    stream >> *block._inst_hdr_tbl;
+    stream >> *block._inst_tbl;
+    stream >> *block._module_tbl;
+    stream >> *block._modinst_tbl;
+    if (db->isSchema(db_schema_update_hierarchy)) {
+      stream >> *block._modbterm_tbl;
+      stream >> *block._moditerm_tbl;
+      stream >> *block._modnet_tbl;
+    }
+    stream >> *block._powerdomain_tbl;
+    stream >> *block._logicport_tbl;
+    stream >> *block._powerswitch_tbl;
+    stream >> *block._isolation_tbl;
+    if (db->isSchema(db_schema_level_shifter)) {
+      stream >> *block._levelshifter_tbl;
+    }
+    stream >> *block._group_tbl;
+    stream >> *block.ap_tbl_;
+    if (db->isSchema(db_schema_add_global_connect)) {
+      stream >> *block.global_connect_tbl_;
+    }
+    stream >> *block._guide_tbl;
+    if (db->isSchema(db_schema_net_tracks)) {
+      stream >> *block._net_tracks_tbl;
+    }
+    stream >> *block._box_tbl;
+    stream >> *block._via_tbl;
+    stream >> *block._gcell_grid_tbl;
+    stream >> *block._track_grid_tbl;
+    stream >> *block._obstruction_tbl;
+    stream >> *block._blockage_tbl;
+    stream >> *block._wire_tbl;
+    stream >> *block._swire_tbl;
+    stream >> *block._sbox_tbl;
+    stream >> *block._row_tbl;
+    stream >> *block._fill_tbl;
+    stream >> *block._region_tbl;
+    stream >> *block._hier_tbl;
+    stream >> *block._bpin_tbl;
+    stream >> *block._non_default_rule_tbl;
+    stream >> *block._layer_rule_tbl;
+    stream >> *block._prop_tbl;
+    stream >> *block._name_cache;
+    stream >> *block._r_val_tbl;
+    stream >> *block._c_val_tbl;
+    stream >> *block._cc_val_tbl;
+    stream >> *block._cap_node_tbl;  // DKF
+    stream >> *block._r_seg_tbl;     // DKF
+    stream >> *block._cc_seg_tbl;
+    stream >> *block._extControl;
+    if (db->isSchema(db_schema_add_scan)) {
+      stream >> block._dft;
+      stream >> *block._dft_tbl;
+    }
   }
 
   //---------------------------------------------------------- stream in
@@ -1228,6 +1391,11 @@ void _dbBlock::remove_rect(const Rect& rect)
 
 bool _dbBlock::operator==(const _dbBlock& rhs) const
 {
+  loadWires();
+  loadParasitics();
+  rhs.loadWires();
+  rhs.loadParasitics();
+
   if (_flags._valid_bbox != rhs._flags._valid_bbox) {
     return false;
   }
@@ -1564,6 +1732,11 @@ void _dbBlock::differences(dbDiff& diff,
                            const char* field,
                            const _dbBlock& rhs) const
 {
+  loadWires();
+  loadParasitics();
+  rhs.loadWires();
+  rhs.loadParasitics();
+
   DIFF_BEGIN
   DIFF_FIELD(_flags._valid_bbox);
   DIFF_FIELD(_def_units);
@@ -1665,6 +1838,9 @@ void _dbBlock::differences(dbDiff& diff,
 
 void _dbBlock::out(dbDiff& diff, char side, const char* field) const
 {
+  loadWires();
+  loadParasitics();
+
   DIFF_OUT_BEGIN
   DIFF_OUT_FIELD(_flags._valid_bbox);
   DIFF_OUT_FIELD(_def_units);
@@ -1840,6 +2016,7 @@ void dbBlock::ComputeBBox()
     bbox->_shape._rect.merge(rect);
   }
 
+  block->loadWires();
   dbSet<dbWire> wires(block, block->_wire_tbl);
 
   for (dbWire* wire : wires) {
@@ -2151,6 +2328,7 @@ dbSet<dbNet> dbBlock::getNets()
 dbSet<dbCapNode> dbBlock::getCapNodes()
 {
   _dbBlock* block = (_dbBlock*) this;
+  block->loadParasitics();
   return dbSet<dbCapNode>(block, block->_cap_node_tbl);
 }
 
@@ -2516,12 +2694,14 @@ void dbBlock::getExtCornerNames(std::list<std::string>& ecl)
 dbSet<dbCCSeg> dbBlock::getCCSegs()
 {
   _dbBlock* block = (_dbBlock*) this;
+  block->loadParasitics();
   return dbSet<dbCCSeg>(block, block->_cc_seg_tbl);
 }
 
 dbSet<dbRSeg> dbBlock::getRSegs()
 {
   _dbBlock* block = (_dbBlock*) this;
+  block->loadParasitics();
   return dbSet<dbRSeg>(block, block->_r_seg_tbl);
 }
 
@@ -2558,6 +2738,7 @@ void dbBlock::copyExtDb(uint fr,
                         double gndcFactor)
 {
   _dbBlock* block = (_dbBlock*) this;
+  block->loadParasitics();
   uint j;
   if (resFactor != 1.0) {
     for (j = 1; j < block->_r_val_tbl->size(); j += extDbCnt) {
@@ -2657,6 +2838,7 @@ void dbBlock::undoAdjustedCC(std::vector<dbNet*>& nets,
 void dbBlock::adjustRC(double resFactor, double ccFactor, double gndcFactor)
 {
   _dbBlock* block = (_dbBlock*) this;
+  block->loadParasitics();
   uint j;
   if (resFactor != 1.0) {
     for (j = 1; j < block->_r_val_tbl->size(); j++) {
@@ -2681,6 +2863,7 @@ void dbBlock::getExtCount(int& numOfNet,
                           int& numOfCCSeg)
 {
   _dbBlock* block = (_dbBlock*) this;
+  block->loadParasitics();
   numOfNet = block->_net_tbl->size();
   numOfRSeg = block->_r_seg_tbl->size();
   numOfCapNode = block->_cap_node_tbl->size();
@@ -2735,6 +2918,7 @@ int dbBlock::getExtDbCount()
 void dbBlock::initParasiticsValueTables()
 {
   _dbBlock* block = (_dbBlock*) this;
+  block->loadParasitics();
   if ((block->_r_seg_tbl->size() > 0) || (block->_cap_node_tbl->size() > 0)
       || (block->_cc_seg_tbl->size() > 0)) {
     dbSet<dbNet> nets = getNets();
@@ -3133,6 +3317,15 @@ dbBlockSearch* dbBlock::getSearchDb()
   return block->_searchDb;
 }
 
+dbSpatialIndex* dbBlock::getSpatialIndex()
+{
+  _dbBlock* block = (_dbBlock*) this;
+  if (block->_spatial_index == nullptr) {
+    block->_spatial_index = new dbSpatialIndex(this);
+  }
+  return block->_spatial_index;
+}
+
 void dbBlock::getWireUpdatedNets(std::vector<dbNet*>& result)
 {
   dbSet<dbNet> nets = getNets();
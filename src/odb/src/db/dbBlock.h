@@ -39,6 +39,7 @@
 #include "dbHashTable.h"
 #include "dbIntHashTable.h"
 #include "dbPagedVector.h"
+#include "dbStreamSections.h"
 #include "dbVector.h"
 #include "odb/dbTransform.h"
 #include "odb/dbTypes.h"
@@ -134,6 +135,7 @@ class dbIStream;
 class dbOStream;
 class dbDiff;
 class dbBlockSearch;
+class dbSpatialIndex;
 class dbBlockCallBackObj;
 class dbGuideItr;
 class dbNetTrackItr;
@@ -286,6 +288,7 @@ class _dbBlock : public _dbObject
   dbBPinItr* _bpin_itr;
   dbPropertyItr* _prop_itr;
   dbBlockSearch* _searchDb;
+  dbSpatialIndex* _spatial_index;
 
   unsigned char _num_ext_dbs;
 
@@ -295,6 +298,23 @@ class _dbBlock : public _dbObject
   dbJournal* _journal;
   dbJournal* _journal_pending;
 
+  // Tables left encoded by a lazy read (see dbDatabase::setLazyLoading),
+  // or null if they were decoded with the rest of the block.
+  dbDeferredSections* _deferred_wires;
+  dbDeferredSections* _deferred_parasitics;
+
+  // Incremental checkpointing: _journal records the edits since the last
+  // checkpoint, _checkpoint_seq is the number of the last checkpoint
+  // written or read.  The journal does not record wires, so
+  // _checkpoint_tracker sets _checkpoint_wires_changed when a wire or
+  // special wire is edited.  _checkpoint_digest is getUnjournaledDigest()
+  // at the last checkpoint, it catches the other edits the journal misses.
+  bool _checkpointing;
+  uint _checkpoint_seq;
+  bool _checkpoint_wires_changed;
+  uint64_t _checkpoint_digest;
+  dbBlockCallBackObj* _checkpoint_tracker;
+
   _dbBlock(_dbDatabase* db);
   _dbBlock(_dbDatabase* db, const _dbBlock& block);
   ~_dbBlock();
@@ -317,6 +337,25 @@ class _dbBlock : public _dbObject
   _dbTech* getTech();
 
   dbObjectTable* getObjectTable(dbObjectType type);
+
+  // Must be called before the wire or parasitic tables are used from a
+  // path that doesn't already hold one of their objects.
+  void loadWires() const
+  {
+    if (_deferred_wires) {
+      _deferred_wires->load();
+    }
+  }
+  void loadParasitics() const
+  {
+    if (_deferred_parasitics) {
+      _deferred_parasitics->load();
+    }
+  }
+  dbDeferredSections* getDeferredSections(const char* section) const;
+  // Hash of the block data that neither the journal nor
+  // _checkpoint_tracker follows.
+  uint64_t getUnjournaledDigest() const;
 };
 
 dbOStream& operator<<(dbOStream& stream, const _dbBlock& block);
@@ -813,6 +813,7 @@ dbCapNode* dbCCSeg::getTheOtherCapn(dbCapNode* oneCap, uint& cid)
 dbCCSeg* dbCCSeg::getCCSeg(dbBlock* block_, uint dbid_)
 {
   _dbBlock* block = (_dbBlock*) block_;
+  block->loadParasitics();
   return (dbCCSeg*) block->_cc_seg_tbl->getPtr(dbid_);
 }
 
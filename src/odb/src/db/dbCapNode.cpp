@@ -988,6 +988,7 @@ dbCapNode* dbCapNode::create(dbNet* net_, uint node, bool foreign)
   _dbNet* net = (_dbNet*) net_;
   _dbBlock* block = (_dbBlock*) net->getOwner();
   uint cornerCnt = block->_corners_per_block;
+  block->loadParasitics();
   _dbCapNode* seg = block->_cap_node_tbl->create();
 
   if (block->_journal) {
@@ -1131,6 +1132,7 @@ bool dbCapNode::checkCC()
 dbCapNode* dbCapNode::getCapNode(dbBlock* block_, uint dbid_)
 {
   _dbBlock* block = (_dbBlock*) block_;
+  block->loadParasitics();
   return (dbCapNode*) block->_cap_node_tbl->getPtr(dbid_);
 }
 }  // namespace odb
@@ -0,0 +1,255 @@
+///////////////////////////////////////////////////////////////////////////////
+// BSD 3-Clause License
+//
+// Copyright (c) 2024, The Regents of the University of California
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#include "dbCompressedStream.h"
+
+#include <zlib.h>
+
+#include <algorithm>
+#include <cstring>
+
+#include "odb/ZException.h"
+
+namespace odb {
+
+// Chunks are compressed independently; larger chunks compress slightly
+// better while smaller ones give more parallelism.
+constexpr size_t kChunkSize = 4 << 20;
+constexpr int kCompressionLevel = Z_BEST_SPEED;
+
+static void readExact(std::istream& in, void* data, size_t size)
+{
+  if (in.rdbuf()->sgetn(static_cast<char*>(data), size)
+      != static_cast<std::streamsize>(size)) {
+    throw ZException("compressed database file is truncated");
+  }
+}
+
+static std::vector<char> deflateChunk(std::vector<char> raw)
+{
+  // Frame is raw size, compressed size, payload.
+  constexpr size_t header_size = 2 * sizeof(uint32_t);
+  uLongf compressed_size = compressBound(raw.size());
+  std::vector<char> frame(header_size + compressed_size);
+  const int status
+      = compress2(reinterpret_cast<Bytef*>(frame.data() + header_size),
+                  &compressed_size,
+                  reinterpret_cast<const Bytef*>(raw.data()),
+                  raw.size(),
+                  kCompressionLevel);
+  if (status != Z_OK) {
+    throw ZException("failed to compress database chunk (zlib error %d)",
+                     status);
+  }
+  const uint32_t header[2] = {static_cast<uint32_t>(raw.size()),
+                              static_cast<uint32_t>(compressed_size)};
+  std::memcpy(frame.data(), header, header_size);
+  frame.resize(header_size + compressed_size);
+  return frame;
+}
+
+static std::vector<char> inflateChunk(std::vector<char> compressed,
+                                      uint32_t raw_size)
+{
+  std::vector<char> raw(raw_size);
+  uLongf size = raw_size;
+  const int status
+      = uncompress(reinterpret_cast<Bytef*>(raw.data()),
+                   &size,
+                   reinterpret_cast<const Bytef*>(compressed.data()),
+                   compressed.size());
+  if (status != Z_OK || size != raw_size) {
+    throw ZException("compressed database file is corrupt (zlib error %d)",
+                     status);
+  }
+  return raw;
+}
+
+bool isCompressedStream(std::istream& in)
+{
+  // Uncompressed files start with 'O' too, so the whole magic is read and
+  // the stream is moved back to where it was.
+  std::streambuf* buf = in.rdbuf();
+  const std::streampos start = buf->pubseekoff(0, std::ios::cur, std::ios::in);
+  if (start == std::streampos(-1)) {
+    return false;
+  }
+  char magic[sizeof(kCompressedMagic)];
+  const std::streamsize size = buf->sgetn(magic, sizeof(magic));
+  buf->pubseekpos(start, std::ios::in);
+  return size == sizeof(magic)
+         && std::memcmp(magic, kCompressedMagic, sizeof(magic)) == 0;
+}
+
+////////////////////////////////////////////////////////////////////
+//
+// dbDeflateBuf - Methods
+//
+////////////////////////////////////////////////////////////////////
+
+dbDeflateBuf::dbDeflateBuf(std::ostream& out, int num_threads)
+    : out_(out), max_pending_(std::max(num_threads, 1)), chunk_(kChunkSize)
+{
+  out_.write(kCompressedMagic, sizeof(kCompressedMagic));
+  out_.write(reinterpret_cast<const char*>(&kCompressedVersion),
+             sizeof(kCompressedVersion));
+  setp(chunk_.data(), chunk_.data() + chunk_.size());
+}
+
+void dbDeflateBuf::submit()
+{
+  const size_t size = pptr() - pbase();
+  if (size == 0) {
+    return;
+  }
+  raw_bytes_ += size;
+
+  chunk_.resize(size);
+  pending_.push_back(
+      std::async(std::launch::async, deflateChunk, std::move(chunk_)));
+  chunk_ = std::vector<char>(kChunkSize);
+  setp(chunk_.data(), chunk_.data() + chunk_.size());
+
+  while (pending_.size() > max_pending_) {
+    writeFrame();
+  }
+}
+
+void dbDeflateBuf::writeFrame()
+{
+  std::vector<char> frame = pending_.front().get();
+  pending_.pop_front();
+  out_.write(frame.data(), frame.size());
+}
+
+dbDeflateBuf::int_type dbDeflateBuf::overflow(int_type c)
+{
+  submit();
+  if (!traits_type::eq_int_type(c, traits_type::eof())) {
+    *pptr() = traits_type::to_char_type(c);
+    pbump(1);
+  }
+  return traits_type::not_eof(c);
+}
+
+int dbDeflateBuf::sync()
+{
+  submit();
+  while (!pending_.empty()) {
+    writeFrame();
+  }
+  out_.flush();
+  return 0;
+}
+
+dbDeflateBuf::pos_type dbDeflateBuf::seekoff(off_type off,
+                                             std::ios_base::seekdir dir,
+                                             std::ios_base::openmode which)
+{
+  // Only reporting the current (uncompressed) position is supported.
+  if (off != 0 || dir != std::ios_base::cur || !(which & std::ios_base::out)) {
+    return pos_type(off_type(-1));
+  }
+  return pos_type(raw_bytes_ + (pptr() - pbase()));
+}
+
+void dbDeflateBuf::finish()
+{
+  sync();
+  const uint32_t end_marker = 0;
+  out_.write(reinterpret_cast<const char*>(&end_marker), sizeof(end_marker));
+  out_.flush();
+}
+
+////////////////////////////////////////////////////////////////////
+//
+// dbInflateBuf - Methods
+//
+////////////////////////////////////////////////////////////////////
+
+dbInflateBuf::dbInflateBuf(std::istream& in, int num_threads)
+    : in_(in), max_pending_(std::max(num_threads, 1))
+{
+  char magic[sizeof(kCompressedMagic)];
+  readExact(in_, magic, sizeof(magic));
+  if (std::memcmp(magic, kCompressedMagic, sizeof(magic)) != 0) {
+    throw ZException("database file is not a compressed OpenDB Database");
+  }
+
+  uint32_t version;
+  readExact(in_, &version, sizeof(version));
+  if (version != kCompressedVersion) {
+    throw ZException("unsupported compressed database version %u", version);
+  }
+}
+
+void dbInflateBuf::fill()
+{
+  while (!at_end_ && pending_.size() < max_pending_) {
+    uint32_t raw_size;
+    readExact(in_, &raw_size, sizeof(raw_size));
+    if (raw_size == 0) {
+      at_end_ = true;
+      break;
+    }
+
+    uint32_t compressed_size;
+    readExact(in_, &compressed_size, sizeof(compressed_size));
+    std::vector<char> compressed(compressed_size);
+    readExact(in_, compressed.data(), compressed_size);
+
+    pending_.push_back(std::async(
+        std::launch::async, inflateChunk, std::move(compressed), raw_size));
+  }
+}
+
+dbInflateBuf::int_type dbInflateBuf::underflow()
+{
+  if (gptr() < egptr()) {
+    return traits_type::to_int_type(*gptr());
+  }
+
+  fill();
+  if (pending_.empty()) {
+    return traits_type::eof();
+  }
+  chunk_ = pending_.front().get();
+  pending_.pop_front();
+
+  // Keep later chunks inflating while this one is consumed.
+  fill();
+
+  setg(chunk_.data(), chunk_.data(), chunk_.data() + chunk_.size());
+  return traits_type::to_int_type(*gptr());
+}
+
+}  // namespace odb
@@ -0,0 +1,119 @@
+///////////////////////////////////////////////////////////////////////////////
+// BSD 3-Clause License
+//
+// Copyright (c) 2024, The Regents of the University of California
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <future>
+#include <istream>
+#include <ostream>
+#include <streambuf>
+#include <vector>
+
+namespace odb {
+
+//
+// Block-compressed container for database files.
+//
+// The raw stream is cut into fixed size chunks that are deflated
+// independently so they can be compressed and inflated on several threads
+// at once.  The layout is:
+//
+//   char[4]   kCompressedMagic
+//   uint32_t  kCompressedVersion
+//   frames:   uint32_t raw size, uint32_t compressed size, payload
+//   uint32_t  0 (end marker)
+//
+inline constexpr char kCompressedMagic[4] = {'O', 'D', 'B', 'Z'};
+inline constexpr uint32_t kCompressedVersion = 1;
+
+// Returns true if the stream continues with a compressed container.  The
+// stream must be able to seek back over the magic; one that can't is taken
+// as uncompressed.
+bool isCompressedStream(std::istream& in);
+
+//
+// dbDeflateBuf - std::streambuf that compresses everything written to it
+// into out.  Up to num_threads chunks are compressed concurrently; finish()
+// must be called once all data has been written.
+//
+class dbDeflateBuf : public std::streambuf
+{
+ public:
+  dbDeflateBuf(std::ostream& out, int num_threads);
+  ~dbDeflateBuf() override = default;
+
+  void finish();
+
+ protected:
+  int_type overflow(int_type c) override;
+  int sync() override;
+  pos_type seekoff(off_type off,
+                   std::ios_base::seekdir dir,
+                   std::ios_base::openmode which) override;
+
+ private:
+  void submit();
+  void writeFrame();
+
+  std::ostream& out_;
+  const size_t max_pending_;
+  std::vector<char> chunk_;
+  std::deque<std::future<std::vector<char>>> pending_;
+  uint64_t raw_bytes_ = 0;
+};
+
+//
+// dbInflateBuf - std::streambuf that decompresses a container written by
+// dbDeflateBuf.  Reading and inflating of later chunks overlaps with the
+// consumer of the current one.
+//
+class dbInflateBuf : public std::streambuf
+{
+ public:
+  dbInflateBuf(std::istream& in, int num_threads);
+
+ protected:
+  int_type underflow() override;
+
+ private:
+  void fill();
+
+  std::istream& in_;
+  const size_t max_pending_;
+  bool at_end_ = false;
+  std::vector<char> chunk_;
+  std::deque<std::future<std::vector<char>>> pending_;
+};
+
+}  // namespace odb
@@ -43,6 +43,7 @@
 #include "dbCCSeg.h"
 #include "dbCapNode.h"
 #include "dbChip.h"
+#include "dbCompressedStream.h"
 #include "dbITerm.h"
 #include "dbJournal.h"
 #include "dbLib.h"
@@ -60,6 +61,7 @@
 #include "odb/dbExtControl.h"
 #include "odb/dbStream.h"
 #include "utl/Logger.h"
+#include "utl/timer.h"
 
 namespace odb {
 
@@ -68,6 +70,7 @@ namespace odb {
 //
 constexpr int DB_MAGIC1 = 0x41544845;  // ATHE
 constexpr int DB_MAGIC2 = 0x4E414442;  // NADB
+constexpr int DB_CHECKPOINT_MAGIC = 0x504B4344;  // DCKP
 
 template class dbTable<_dbDatabase>;
 
@@ -184,6 +187,8 @@ _dbDatabase::_dbDatabase(_dbDatabase* /* unused: db */)
   _schema_minor = db_schema_minor;
   _master_id = 0;
   _logger = nullptr;
+  _thread_count = 1;
+  _lazy_loading = false;
   _unique_id = db_unique_id++;
 
   _chip_tbl = new dbTable<_dbChip>(
@@ -216,6 +221,8 @@ _dbDatabase::_dbDatabase(_dbDatabase* /* unused: db */, int id)
   _schema_minor = db_schema_minor;
   _master_id = 0;
   _logger = nullptr;
+  _thread_count = 1;
+  _lazy_loading = false;
   _unique_id = id;
 
   _chip_tbl = new dbTable<_dbChip>(
@@ -244,7 +251,9 @@ _dbDatabase::_dbDatabase(_dbDatabase* /* unused: db */, const _dbDatabase& d)
       _master_id(d._master_id),
       _chip(d._chip),
       _unique_id(db_unique_id++),
-      _logger(nullptr)
+      _logger(nullptr),
+      _thread_count(d._thread_count),
+      _lazy_loading(d._lazy_loading)
 {
   _chip_tbl = new dbTable<_dbChip>(this, this, *d._chip_tbl);
 
@@ -366,6 +375,22 @@ dbIStream& operator>>(dbIStream& stream, _dbDatabase& db)
   return stream;
 }
 
+static void reportThroughput(utl::Logger* logger,
+                             const char* op,
+                             uint64_t bytes,
+                             double seconds)
+{
+  if (logger == nullptr || !logger->debugCheck(utl::ODB, "io_throughput", 1)) {
+    return;
+  }
+  const double mb = bytes / 1048576.0;
+  logger->report("{} {:.1f} MB in {:.3f} s ({:.1f} MB/s)",
+                 op,
+                 mb,
+                 seconds,
+                 seconds > 0 ? mb / seconds : 0.0);
+}
+
 ////////////////////////////////////////////////////////////////////
 //
 // dbDatabase - Methods
@@ -505,22 +530,100 @@ dbTech* dbDatabase::getTech()
 void dbDatabase::read(std::istream& file)
 {
   _dbDatabase* db = (_dbDatabase*) this;
+  utl::Timer timer;
+  if (isCompressedStream(file)) {
+    dbInflateBuf inflate(file, db->_thread_count);
+    std::istream raw(&inflate);
+    raw.exceptions(file.exceptions());
+    dbIStream stream(db, raw);
+    stream >> *db;
+    reportThroughput(
+        db->_logger, "read", stream.bytesRead(), timer.elapsed());
+    return;
+  }
+
   dbIStream stream(db, file);
   stream >> *db;
+  reportThroughput(db->_logger, "read", stream.bytesRead(), timer.elapsed());
 }
 
-void dbDatabase::write(std::ostream& file)
+void dbDatabase::write(std::ostream& file, bool compress)
 {
   _dbDatabase* db = (_dbDatabase*) this;
+  utl::Timer timer;
+  if (compress) {
+    dbDeflateBuf deflate(file, db->_thread_count);
+    std::ostream raw(&deflate);
+    raw.exceptions(std::ios::failbit | std::ios::badbit);
+    {
+      dbOStream stream(db, raw);
+      stream << *db;
+      stream.flush();
+      reportThroughput(
+          db->_logger, "write", stream.bytesWritten(), timer.elapsed());
+    }
+    deflate.finish();
+    return;
+  }
+
   dbOStream stream(db, file);
   stream << *db;
+  stream.flush();
   file.flush();
+  reportThroughput(
+      db->_logger, "write", stream.bytesWritten(), timer.elapsed());
+}
+
+//
+// The journal does not record wires, so edits of wires and special wires
+// made while checkpointing are tracked with a callback instead.  The other
+// data the journal misses is compared by digest, see checkpointMissesEdits.
+//
+class dbCheckpointTracker : public dbBlockCallBackObj
+{
+ public:
+  explicit dbCheckpointTracker(_dbBlock* block) : block_(block) {}
+
+  void inDbWireCreate(dbWire*) override { changed(); }
+  void inDbWireDestroy(dbWire*) override { changed(); }
+  void inDbWirePostModify(dbWire*) override { changed(); }
+  void inDbWirePostAttach(dbWire*) override { changed(); }
+  void inDbWirePostDetach(dbWire*, dbNet*) override { changed(); }
+  void inDbWirePostAppend(dbWire*, dbWire*) override { changed(); }
+  void inDbWirePostCopy(dbWire*, dbWire*) override { changed(); }
+  void inDbSWireCreate(dbSWire*) override { changed(); }
+  void inDbSWireDestroy(dbSWire*) override { changed(); }
+  void inDbSWireAddSBox(dbSBox*) override { changed(); }
+  void inDbSWireRemoveSBox(dbSBox*) override { changed(); }
+  void inDbSWirePostDestroySBoxes(dbSWire*) override { changed(); }
+
+ private:
+  void changed() { block_->_checkpoint_wires_changed = true; }
+
+  _dbBlock* block_;
+};
+
+static void endCheckpoint(_dbBlock* block)
+{
+  block->_checkpointing = false;
+  block->_checkpoint_wires_changed = false;
+  delete block->_checkpoint_tracker;
+  block->_checkpoint_tracker = nullptr;
 }
 
 void dbDatabase::beginEco(dbBlock* block_)
 {
   _dbBlock* block = (_dbBlock*) block_;
 
+  if (block->_checkpointing) {
+    block->getImpl()->getLogger()->warn(
+        utl::ODB,
+        447,
+        "Starting an ECO ends incremental checkpointing of block {}.",
+        block->_name);
+    endCheckpoint(block);
+  }
+
   {
     delete block->_journal;
   }
@@ -602,6 +705,7 @@ void dbDatabase::writeEco(dbBlock* block_, const char* filename)
   if (block->_journal_pending) {
     dbOStream stream(block->getDatabase(), file);
     stream << *block->_journal_pending;
+    stream.flush();
   }
 }
 
@@ -629,12 +733,187 @@ void dbDatabase::undoEco(dbBlock* block_)
   }
 }
 
+//
+// The checkpoint records the object counts of the block after the edits so
+// readCheckpoint can tell when the replay diverged from the original.
+//
+static std::vector<uint> checkpointCounts(_dbBlock* block)
+{
+  return {block->_inst_tbl->size(),
+          block->_net_tbl->size(),
+          block->_iterm_tbl->size(),
+          block->_bterm_tbl->size()};
+}
+
+void dbDatabase::beginCheckpoint(dbBlock* block_)
+{
+  _dbBlock* block = (_dbBlock*) block_;
+
+  {
+    delete block->_journal;
+  }
+
+  block->_journal = new dbJournal(block_);
+  block->_checkpointing = true;
+  block->_checkpoint_seq = 0;
+  block->_checkpoint_wires_changed = false;
+  block->_checkpoint_digest = block->getUnjournaledDigest();
+  if (block->_checkpoint_tracker == nullptr) {
+    block->_checkpoint_tracker = new dbCheckpointTracker(block);
+    block->_checkpoint_tracker->addOwner(block_);
+  }
+}
+
+bool dbDatabase::inCheckpoint(dbBlock* block_)
+{
+  _dbBlock* block = (_dbBlock*) block_;
+  return block->_checkpointing;
+}
+
+bool dbDatabase::checkpointMissesEdits(dbBlock* block_)
+{
+  _dbBlock* block = (_dbBlock*) block_;
+  if (!block->_checkpointing) {
+    return false;
+  }
+  return block->_checkpoint_wires_changed
+         || block->getUnjournaledDigest() != block->_checkpoint_digest;
+}
+
+void dbDatabase::writeCheckpoint(dbBlock* block_, std::ostream& file)
+{
+  _dbBlock* block = (_dbBlock*) block_;
+  _dbDatabase* db = block->getDatabase();
+
+  if (!block->_checkpointing) {
+    block->getImpl()->getLogger()->error(
+        utl::ODB,
+        448,
+        "Incremental checkpointing of block {} has not been started.",
+        block->_name);
+  }
+  if (checkpointMissesEdits(block_)) {
+    block->getImpl()->getLogger()->error(
+        utl::ODB,
+        453,
+        "Block {} has edits since the last checkpoint that a checkpoint can "
+        "not hold. Write a full database instead.",
+        block->_name);
+  }
+
+  dbOStream stream(db, file);
+  stream << DB_CHECKPOINT_MAGIC;
+  stream << db->_schema_major;
+  stream << db->_schema_minor;
+  stream << block->_checkpoint_seq + 1;
+  stream << *block->_journal;
+  stream << checkpointCounts(block);
+  stream.flush();
+
+  debugPrint(block->getImpl()->getLogger(),
+             utl::ODB,
+             "checkpoint",
+             1,
+             "wrote checkpoint {} of block {}, {} bytes",
+             block->_checkpoint_seq + 1,
+             block->_name,
+             stream.bytesWritten());
+
+  block->_journal->clear();
+  ++block->_checkpoint_seq;
+}
+
+bool dbDatabase::isCheckpoint(std::istream& file)
+{
+  return file.rdbuf()->sgetc() == (DB_CHECKPOINT_MAGIC & 0xff);
+}
+
+void dbDatabase::readCheckpoint(dbBlock* block_, std::istream& file)
+{
+  _dbBlock* block = (_dbBlock*) block_;
+  _dbDatabase* db = block->getDatabase();
+  utl::Logger* logger = block->getImpl()->getLogger();
+
+  dbIStream stream(db, file);
+
+  int magic;
+  stream >> magic;
+  if (magic != DB_CHECKPOINT_MAGIC) {
+    throw ZException("not an OpenDB checkpoint");
+  }
+
+  uint schema_major;
+  uint schema_minor;
+  stream >> schema_major;
+  stream >> schema_minor;
+  if (schema_major != db->_schema_major || schema_minor != db->_schema_minor) {
+    throw ZException(
+        "checkpoint schema revision %u.%u does not match the database "
+        "revision %u.%u",
+        schema_major,
+        schema_minor,
+        db->_schema_major,
+        db->_schema_minor);
+  }
+
+  uint seq;
+  stream >> seq;
+  if (seq != block->_checkpoint_seq + 1) {
+    logger->error(utl::ODB,
+                  449,
+                  "Checkpoint {} is out of sequence, expected checkpoint {}.",
+                  seq,
+                  block->_checkpoint_seq + 1);
+  }
+
+  dbJournal journal(block_);
+  stream >> journal;
+  std::vector<uint> expected;
+  stream >> expected;
+
+  journal.redo();
+
+  if (checkpointCounts(block) != expected) {
+    logger->error(utl::ODB,
+                  450,
+                  "Block {} does not match checkpoint {} after replaying it.",
+                  block->_name,
+                  seq);
+  }
+
+  block->_checkpoint_seq = seq;
+}
+
 void dbDatabase::setLogger(utl::Logger* logger)
 {
   _dbDatabase* _db = (_dbDatabase*) this;
   _db->_logger = logger;
 }
 
+void dbDatabase::setThreadCount(int threads)
+{
+  _dbDatabase* db = (_dbDatabase*) this;
+  db->_thread_count = std::max(threads, 1);
+}
+
+int dbDatabase::getThreadCount()
+{
+  _dbDatabase* db = (_dbDatabase*) this;
+  return db->_thread_count;
+}
+
+void dbDatabase::setLazyLoading(bool lazy)
+{
+  _dbDatabase* db = (_dbDatabase*) this;
+  db->_lazy_loading = lazy;
+}
+
+bool dbDatabase::getLazyLoading()
+{
+  _dbDatabase* db = (_dbDatabase*) this;
+  return db->_lazy_loading;
+}
+
 dbDatabase* dbDatabase::create()
 {
   if (db_tbl == nullptr) {
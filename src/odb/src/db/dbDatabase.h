@@ -70,7 +70,10 @@ namespace odb {
 const uint db_schema_major = 0;  // Not used...
 const uint db_schema_initial = 57;
 
-const uint db_schema_minor = 89;  // Current revision number
+const uint db_schema_minor = 90;  // Current revision number
+
+// Revision where dbBlock tables are streamed as independent sections
+const uint db_schema_block_sections = 90;
 
 // Revision where blocked regions for IO pins were added to dbBlock
 const uint db_schema_dbblock_blocked_regions_for_pins = 89;
@@ -196,6 +199,8 @@ class _dbDatabase : public _dbObject
   int _unique_id;
 
   utl::Logger* _logger;
+  int _thread_count;
+  bool _lazy_loading;
 
   _dbDatabase(_dbDatabase* db);
   _dbDatabase(_dbDatabase* db, int id);
@@ -911,6 +911,8 @@ void dbJournal::redo_updateInstField()
       _log.pop(prev_flags);
       uint* flags = (uint*) &inst->_flags;
       _log.pop(*flags);
+      // The orientation is part of the flags
+      _dbInst::setInstBBox(inst);
       debugPrint(_logger,
                  utl::ODB,
                  "DB_ECO",
@@ -1772,6 +1774,8 @@ void dbJournal::undo_updateInstField()
       _log.pop(*flags);
       uint new_flags;
       _log.pop(new_flags);
+      // The orientation is part of the flags
+      _dbInst::setInstBBox(inst);
       break;
     }
 
@@ -1757,6 +1757,7 @@ dbWire* dbNet::getWire()
     return nullptr;
   }
 
+  block->loadWires();
   return (dbWire*) block->_wire_tbl->getPtr(net->_wire);
 }
 
@@ -1769,6 +1770,7 @@ dbWire* dbNet::getGlobalWire()
     return nullptr;
   }
 
+  block->loadWires();
   return (dbWire*) block->_wire_tbl->getPtr(net->_global_wire);
 }
 
@@ -2016,6 +2018,7 @@ dbSet<dbRSeg> dbNet::getRSegs()
 {
   _dbNet* net = (_dbNet*) this;
   _dbBlock* block = (_dbBlock*) net->getOwner();
+  block->loadParasitics();
   return dbSet<dbRSeg>(net, block->_r_seg_itr);
 }
 
@@ -2437,6 +2440,7 @@ dbSet<dbCapNode> dbNet::getCapNodes()
 {
   _dbNet* net = (_dbNet*) this;
   _dbBlock* block = (_dbBlock*) net->getOwner();
+  block->loadParasitics();
   return dbSet<dbCapNode>(net, block->_cap_node_itr);
 }
 
@@ -3133,6 +3137,7 @@ void dbNet::destroy(dbNet* net_)
   }
 
   if (net->_wire != 0) {
+    block->loadWires();
     dbWire* wire = (dbWire*) block->_wire_tbl->getPtr(net->_wire);
     dbWire::destroy(wire);
   }
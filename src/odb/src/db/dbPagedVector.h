@@ -32,6 +32,8 @@
 
 #pragma once
 
+#include <algorithm>
+
 #include "odb/ZException.h"
 #include "odb/dbDiff.h"
 #include "odb/dbStream.h"
@@ -112,6 +114,12 @@ class dbPagedVector
                    const char* field,
                    const dbPagedVector<T, page_size, page_shift>& rhs) const;
   void out(dbDiff& diff, char side, const char* field) const;
+
+  template <class U, const uint PS, const uint SH>
+  friend dbOStream& operator<<(dbOStream& stream,
+                               const dbPagedVector<U, PS, SH>& v);
+  template <class U, const uint PS, const uint SH>
+  friend dbIStream& operator>>(dbIStream& stream, dbPagedVector<U, PS, SH>& v);
 };
 
 template <class T, const uint P, const uint S>
@@ -360,10 +368,18 @@ inline dbOStream& operator<<(dbOStream& stream, const dbPagedVector<T, P, S>& v)
   uint sz = v.size();
   stream << sz;
 
-  uint i;
-  for (i = 0; i < sz; ++i) {
-    const T& t = v[i];
-    stream << t;
+  if constexpr (dbBulkStreamable<T>::value) {
+    // Pages are contiguous so copy them whole.
+    for (uint start = 0; start < sz; start += P) {
+      const uint n = std::min(P, sz - start);
+      stream.writeBytes(v._pages[start >> S], n * sizeof(T));
+    }
+  } else {
+    uint i;
+    for (i = 0; i < sz; ++i) {
+      const T& t = v[i];
+      stream << t;
+    }
   }
 
   return stream;
@@ -376,12 +392,23 @@ inline dbIStream& operator>>(dbIStream& stream, dbPagedVector<T, P, S>& v)
 
   uint sz;
   stream >> sz;
-  T t;
-  uint i;
 
-  for (i = 0; i < sz; ++i) {
-    stream >> t;
-    v.push_back(t);
+  if constexpr (dbBulkStreamable<T>::value) {
+    // Read straight into freshly allocated pages.
+    for (uint start = 0; start < sz; start += P) {
+      const uint n = std::min(P, sz - start);
+      v.newPage();
+      stream.readBytes(v._pages[v._page_cnt - 1], n * sizeof(T));
+      v._next_idx += n;
+    }
+  } else {
+    T t;
+    uint i;
+
+    for (i = 0; i < sz; ++i) {
+      stream >> t;
+      v.push_back(t);
+    }
   }
 
   return stream;
@@ -0,0 +1,252 @@
+///////////////////////////////////////////////////////////////////////////////
+// BSD 3-Clause License
+//
+// Copyright (c) 2024, The Regents of the University of California
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#include "odb/dbPlacementSnapshot.h"
+
+#include <map>
+#include <utility>
+
+#include "dbBlock.h"
+#include "dbInst.h"
+#include "odb/db.h"
+#include "odb/dbBlockCallBackObj.h"
+#include "odb/dbTransform.h"
+#include "utl/Logger.h"
+
+namespace odb {
+
+namespace {
+
+// What capture needs from a master in one orientation.
+struct MasterView
+{
+  // Lower left of the transformed placement boundary, which is where the
+  // instance origin is relative to its location
+  Point boundary_min;
+  Point size;
+  // Pin centers relative to the instance location by mterm index
+  std::vector<Point> pin_offsets;
+};
+
+MasterView makeMasterView(dbMaster* master, const dbOrientType& orient)
+{
+  const dbTransform transform(orient);
+  Rect boundary;
+  master->getPlacementBoundary(boundary);
+  transform.apply(boundary);
+
+  MasterView view;
+  view.boundary_min = boundary.ll();
+  view.size = Point(boundary.dx(), boundary.dy());
+  view.pin_offsets.resize(master->getMTermCount());
+  for (dbMTerm* mterm : master->getMTerms()) {
+    Rect bbox = mterm->getBBox();
+    Point center;
+    if (bbox.xMin() <= bbox.xMax()) {
+      transform.apply(bbox);
+      center = Point(bbox.xCenter() - boundary.xMin(),
+                     bbox.yCenter() - boundary.yMin());
+    } else {
+      // No pin shapes; use the middle of the instance.
+      center = Point(boundary.dx() / 2, boundary.dy() / 2);
+    }
+    view.pin_offsets[mterm->getIndex()] = center;
+  }
+  return view;
+}
+
+}  // namespace
+
+void dbPlacementSnapshot::capture(dbBlock* block)
+{
+  block_ = block;
+  dbSet<dbInst> block_insts = block->getInsts();
+  const int num_insts = block_insts.size();
+
+  insts.clear();
+  insts.reserve(num_insts);
+  inst_x.resize(num_insts);
+  inst_y.resize(num_insts);
+  inst_width.resize(num_insts);
+  inst_height.resize(num_insts);
+  inst_orient.resize(num_insts);
+  inst_status.resize(num_insts);
+  inst_pin_begin.resize(num_insts + 1);
+  pins.clear();
+  pin_inst.clear();
+  pin_net.clear();
+  pin_offset_x.clear();
+  pin_offset_y.clear();
+
+  std::map<std::pair<dbMaster*, int>, MasterView> views;
+  // Pins of each net by net id, to order the nets as the block does
+  std::vector<int> net_pin_count;
+
+  for (dbInst* inst : block_insts) {
+    const int i = insts.size();
+    insts.push_back(inst);
+
+    const dbOrientType orient = inst->getOrient();
+    dbMaster* master = inst->getMaster();
+    auto view_itr = views.find({master, orient.getValue()});
+    if (view_itr == views.end()) {
+      view_itr = views
+                     .emplace(std::make_pair(master, orient.getValue()),
+                              makeMasterView(master, orient))
+                     .first;
+    }
+    const MasterView& view = view_itr->second;
+
+    const Rect bbox = inst->getBBox()->getBox();
+    inst_x[i] = bbox.xMin();
+    inst_y[i] = bbox.yMin();
+    inst_width[i] = view.size.x();
+    inst_height[i] = view.size.y();
+    inst_orient[i] = orient.getValue();
+    inst_status[i] = inst->getPlacementStatus().getValue();
+
+    inst_pin_begin[i] = pins.size();
+    for (dbITerm* iterm : inst->getITerms()) {
+      const Point& offset = view.pin_offsets[iterm->getMTerm()->getIndex()];
+      pins.push_back(iterm);
+      pin_inst.push_back(i);
+      pin_offset_x.push_back(offset.x());
+      pin_offset_y.push_back(offset.y());
+      dbNet* net = iterm->getNet();
+      if (net == nullptr) {
+        pin_net.push_back(-1);
+        continue;
+      }
+      // Holds the net id until the nets are numbered below.
+      const uint id = net->getId();
+      pin_net.push_back(id);
+      if (id >= net_pin_count.size()) {
+        net_pin_count.resize(id + 1);
+      }
+      net_pin_count[id]++;
+    }
+  }
+  inst_pin_begin[num_insts] = pins.size();
+
+  // Number the nets in block order and lay out their pin lists.
+  std::vector<int> net_index(net_pin_count.size(), -1);
+  nets.clear();
+  net_pin_begin.assign(1, 0);
+  for (dbNet* net : block->getNets()) {
+    const uint id = net->getId();
+    if (id < net_pin_count.size() && net_pin_count[id] > 0) {
+      net_index[id] = nets.size();
+      nets.push_back(net);
+      net_pin_begin.push_back(net_pin_begin.back() + net_pin_count[id]);
+    }
+  }
+
+  net_pins.resize(net_pin_begin.back());
+  std::vector<int> fill(net_pin_begin.begin(), net_pin_begin.end() - 1);
+  for (size_t pin = 0; pin < pins.size(); ++pin) {
+    if (pin_net[pin] >= 0) {
+      const int net = net_index[pin_net[pin]];
+      pin_net[pin] = net;
+      net_pins[fill[net]++] = pin;
+    }
+  }
+
+  captured_x_ = inst_x;
+  captured_y_ = inst_y;
+}
+
+int dbPlacementSnapshot::commit()
+{
+  std::vector<dbInst*> moved;
+  std::vector<int> moved_index;
+  for (size_t i = 0; i < insts.size(); ++i) {
+    if (inst_x[i] == captured_x_[i] && inst_y[i] == captured_y_[i]) {
+      continue;
+    }
+    dbInst* inst = insts[i];
+    if (inst->getPlacementStatus().isFixed()) {
+      block_->getImpl()->getLogger()->error(
+          utl::ODB,
+          359,
+          "Attempt to change the origin of {} instance {}",
+          inst->getPlacementStatus().getString(),
+          inst->getName());
+    }
+    moved.push_back(inst);
+    moved_index.push_back(i);
+  }
+  if (moved.empty()) {
+    return 0;
+  }
+
+  _dbBlock* block = (_dbBlock*) block_;
+  if (block->_journal) {
+    // Let the instances journal their own moves.
+    for (int i : moved_index) {
+      insts[i]->setLocation(inst_x[i], inst_y[i]);
+    }
+  } else {
+    for (auto callback : block->_callbacks) {
+      callback->inDbPreMoveInsts(moved);
+    }
+
+    std::map<std::pair<dbMaster*, int>, Point> boundary_mins;
+    for (int i : moved_index) {
+      _dbInst* inst = (_dbInst*) insts[i];
+      dbMaster* master = insts[i]->getMaster();
+      const int orient = inst->_flags._orient;
+      auto [itr, inserted] = boundary_mins.try_emplace({master, orient});
+      if (inserted) {
+        Rect boundary;
+        master->getPlacementBoundary(boundary);
+        dbTransform(dbOrientType::Value(orient)).apply(boundary);
+        itr->second = boundary.ll();
+      }
+      inst->_x = inst_x[i] - itr->second.x();
+      inst->_y = inst_y[i] - itr->second.y();
+      _dbInst::setInstBBox(inst);
+    }
+    block->_flags._valid_bbox = 0;
+
+    for (auto callback : block->_callbacks) {
+      callback->inDbPostMoveInsts(moved);
+    }
+  }
+
+  for (int i : moved_index) {
+    captured_x_[i] = inst_x[i];
+    captured_y_[i] = inst_y[i];
+  }
+  return moved.size();
+}
+
+}  // namespace odb
@@ -770,6 +770,7 @@ dbRSeg* dbRSeg::create(dbNet* net_,
     block->_journal->endAction();
   }
 
+  block->loadParasitics();
   _dbRSeg* seg = block->_r_seg_tbl->create();
   uint valueMem = 0;
 
@@ -965,6 +966,7 @@ dbSet<dbRSeg>::iterator dbRSeg::destroy(dbSet<dbRSeg>::iterator& itr)
 dbRSeg* dbRSeg::getRSeg(dbBlock* block_, uint dbid_)
 {
   _dbBlock* block = (_dbBlock*) block_;
+  block->loadParasitics();
   return (dbRSeg*) block->_r_seg_tbl->getPtr(dbid_);
 }
 
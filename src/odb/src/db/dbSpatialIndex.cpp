@@ -0,0 +1,380 @@
+///////////////////////////////////////////////////////////////////////////////
+// BSD 3-Clause License
+//
+// Copyright (c) 2024, The Regents of the University of California
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#include "odb/dbSpatialIndex.h"
+
+#include "odb/dbShape.h"
+
+namespace odb {
+
+namespace bgi = boost::geometry::index;
+
+dbSpatialIndex::dbSpatialIndex(dbBlock* block) : block_(block)
+{
+  addOwner(block);
+}
+
+std::vector<dbInst*> dbSpatialIndex::findInsts(const Rect& region)
+{
+  if (!insts_built_) {
+    buildInsts();
+  }
+  std::vector<dbInst*> insts;
+  for (auto it = insts_.qbegin(bgi::intersects(region)); it != insts_.qend();
+       ++it) {
+    insts.push_back(it->second);
+  }
+  return insts;
+}
+
+std::vector<dbSBox*> dbSpatialIndex::findSBoxes(dbTechLayer* layer,
+                                                const Rect& region)
+{
+  if (!sboxes_built_) {
+    buildSBoxes();
+  }
+  std::vector<dbSBox*> boxes;
+  auto tree = sboxes_.find(layer);
+  if (tree == sboxes_.end()) {
+    return boxes;
+  }
+  for (auto it = tree->second.qbegin(bgi::intersects(region));
+       it != tree->second.qend();
+       ++it) {
+    boxes.push_back(it->second);
+  }
+  return boxes;
+}
+
+std::vector<std::pair<Rect, dbNet*>> dbSpatialIndex::findWireShapes(
+    dbTechLayer* layer,
+    const Rect& region)
+{
+  if (!wires_built_) {
+    buildWires();
+  }
+  std::vector<std::pair<Rect, dbNet*>> shapes;
+  auto tree = wires_.find(layer);
+  if (tree == wires_.end()) {
+    return shapes;
+  }
+  for (auto it = tree->second.qbegin(bgi::intersects(region));
+       it != tree->second.qend();
+       ++it) {
+    shapes.emplace_back(it->first, it->second->getNet());
+  }
+  return shapes;
+}
+
+void dbSpatialIndex::buildInsts()
+{
+  std::lock_guard<std::mutex> lock(build_mutex_);
+  if (insts_built_) {
+    return;
+  }
+  std::vector<Value<dbInst*>> values;
+  for (dbInst* inst : block_->getInsts()) {
+    if (inst->isPlaced()) {
+      values.emplace_back(inst->getBBox()->getBox(), inst);
+    }
+  }
+  // Use the packing constructor for a better balanced tree.
+  insts_ = RTree<dbInst*>(values.begin(), values.end());
+  insts_built_ = true;
+}
+
+void dbSpatialIndex::buildSBoxes()
+{
+  std::lock_guard<std::mutex> lock(build_mutex_);
+  if (sboxes_built_) {
+    return;
+  }
+  std::map<dbTechLayer*, std::vector<Value<dbSBox*>>> values;
+  std::vector<std::pair<dbTechLayer*, Rect>> shapes;
+  for (dbNet* net : block_->getNets()) {
+    for (dbSWire* swire : net->getSWires()) {
+      for (dbSBox* box : swire->getWires()) {
+        getSBoxShapes(box, shapes);
+        for (const auto& [layer, rect] : shapes) {
+          values[layer].emplace_back(rect, box);
+        }
+      }
+    }
+  }
+  for (auto& [layer, layer_values] : values) {
+    sboxes_[layer]
+        = RTree<dbSBox*>(layer_values.begin(), layer_values.end());
+  }
+  sboxes_built_ = true;
+}
+
+void dbSpatialIndex::buildWires()
+{
+  std::lock_guard<std::mutex> lock(build_mutex_);
+  if (wires_built_) {
+    return;
+  }
+  std::map<dbTechLayer*, std::vector<Value<dbWire*>>> values;
+  std::vector<std::pair<dbTechLayer*, Rect>> shapes;
+  for (dbNet* net : block_->getNets()) {
+    dbWire* wire = net->getWire();
+    if (wire == nullptr) {
+      continue;
+    }
+    getWireShapes(wire, shapes);
+    if (shapes.empty()) {
+      continue;
+    }
+    Rect bbox;
+    bbox.mergeInit();
+    for (const auto& [layer, rect] : shapes) {
+      values[layer].emplace_back(rect, wire);
+      bbox.merge(rect);
+    }
+    wire_bboxes_[wire] = bbox;
+  }
+  for (auto& [layer, layer_values] : values) {
+    wires_[layer] = RTree<dbWire*>(layer_values.begin(), layer_values.end());
+  }
+  wires_built_ = true;
+}
+
+void dbSpatialIndex::addInst(dbInst* inst)
+{
+  if (insts_built_ && inst->isPlaced()) {
+    insts_.insert({inst->getBBox()->getBox(), inst});
+  }
+}
+
+void dbSpatialIndex::removeInst(dbInst* inst)
+{
+  if (insts_built_ && inst->isPlaced()) {
+    insts_.remove({inst->getBBox()->getBox(), inst});
+  }
+}
+
+void dbSpatialIndex::getSBoxShapes(
+    dbSBox* box,
+    std::vector<std::pair<dbTechLayer*, Rect>>& shapes)
+{
+  shapes.clear();
+  if (!box->isVia()) {
+    shapes.emplace_back(box->getTechLayer(), box->getBox());
+    return;
+  }
+  std::vector<dbShape> via_boxes;
+  box->getViaBoxes(via_boxes);
+  for (const dbShape& via_box : via_boxes) {
+    if (via_box.getTechLayer() != nullptr) {
+      shapes.emplace_back(via_box.getTechLayer(), via_box.getBox());
+    }
+  }
+}
+
+void dbSpatialIndex::addSBox(dbSBox* box)
+{
+  if (!sboxes_built_) {
+    return;
+  }
+  std::vector<std::pair<dbTechLayer*, Rect>> shapes;
+  getSBoxShapes(box, shapes);
+  for (const auto& [layer, rect] : shapes) {
+    sboxes_[layer].insert({rect, box});
+  }
+}
+
+void dbSpatialIndex::removeSBox(dbSBox* box)
+{
+  if (!sboxes_built_) {
+    return;
+  }
+  std::vector<std::pair<dbTechLayer*, Rect>> shapes;
+  getSBoxShapes(box, shapes);
+  for (const auto& [layer, rect] : shapes) {
+    sboxes_[layer].remove({rect, box});
+  }
+}
+
+void dbSpatialIndex::getWireShapes(
+    dbWire* wire,
+    std::vector<std::pair<dbTechLayer*, Rect>>& shapes)
+{
+  shapes.clear();
+  dbWireShapeItr itr;
+  dbShape shape;
+  std::vector<dbShape> via_boxes;
+  for (itr.begin(wire); itr.next(shape);) {
+    if (!shape.isVia()) {
+      shapes.emplace_back(shape.getTechLayer(), shape.getBox());
+      continue;
+    }
+    dbShape::getViaBoxes(shape, via_boxes);
+    for (const dbShape& via_box : via_boxes) {
+      if (via_box.getTechLayer() != nullptr) {
+        shapes.emplace_back(via_box.getTechLayer(), via_box.getBox());
+      }
+    }
+  }
+}
+
+void dbSpatialIndex::addWire(dbWire* wire)
+{
+  if (!wires_built_) {
+    return;
+  }
+  std::vector<std::pair<dbTechLayer*, Rect>> shapes;
+  getWireShapes(wire, shapes);
+  if (shapes.empty()) {
+    return;
+  }
+  Rect bbox;
+  bbox.mergeInit();
+  for (const auto& [layer, rect] : shapes) {
+    wires_[layer].insert({rect, wire});
+    bbox.merge(rect);
+  }
+  wire_bboxes_[wire] = bbox;
+}
+
+void dbSpatialIndex::removeWire(dbWire* wire)
+{
+  if (!wires_built_) {
+    return;
+  }
+  auto bbox = wire_bboxes_.find(wire);
+  if (bbox == wire_bboxes_.end()) {
+    return;
+  }
+  std::vector<Value<dbWire*>> stale;
+  for (auto& [layer, tree] : wires_) {
+    stale.clear();
+    tree.query(bgi::intersects(bbox->second)
+                   && bgi::satisfies([wire](const Value<dbWire*>& value) {
+                        return value.second == wire;
+                      }),
+               std::back_inserter(stale));
+    for (const Value<dbWire*>& value : stale) {
+      tree.remove(value);
+    }
+  }
+  wire_bboxes_.erase(bbox);
+}
+
+void dbSpatialIndex::inDbInstDestroy(dbInst* inst)
+{
+  removeInst(inst);
+}
+
+void dbSpatialIndex::inDbInstPlacementStatusBefore(
+    dbInst* inst,
+    const dbPlacementStatus& status)
+{
+  if (inst->isPlaced() == status.isPlaced()) {
+    return;
+  }
+  if (status.isPlaced()) {
+    if (insts_built_) {
+      insts_.insert({inst->getBBox()->getBox(), inst});
+    }
+  } else {
+    removeInst(inst);
+  }
+}
+
+void dbSpatialIndex::inDbInstSwapMasterBefore(dbInst* inst, dbMaster* master)
+{
+  removeInst(inst);
+}
+
+void dbSpatialIndex::inDbInstSwapMasterAfter(dbInst* inst)
+{
+  addInst(inst);
+}
+
+void dbSpatialIndex::inDbPreMoveInst(dbInst* inst)
+{
+  removeInst(inst);
+}
+
+void dbSpatialIndex::inDbPostMoveInst(dbInst* inst)
+{
+  addInst(inst);
+}
+
+void dbSpatialIndex::inDbPreMoveInsts(
+    const std::vector<dbInst*>& /* insts */)
+{
+  // Repacking on the next query is cheaper than many single updates.
+  insts_.clear();
+  insts_built_ = false;
+}
+
+void dbSpatialIndex::inDbPostMoveInsts(
+    const std::vector<dbInst*>& /* insts */)
+{
+}
+
+void dbSpatialIndex::inDbSWireAddSBox(dbSBox* box)
+{
+  addSBox(box);
+}
+
+void dbSpatialIndex::inDbSWireRemoveSBox(dbSBox* box)
+{
+  removeSBox(box);
+}
+
+void dbSpatialIndex::inDbSWirePreDestroySBoxes(dbSWire* wire)
+{
+  for (dbSBox* box : wire->getWires()) {
+    removeSBox(box);
+  }
+}
+
+void dbSpatialIndex::inDbWireDestroy(dbWire* wire)
+{
+  removeWire(wire);
+}
+
+void dbSpatialIndex::inDbWirePostModify(dbWire* wire)
+{
+  removeWire(wire);
+  addWire(wire);
+}
+
+void dbSpatialIndex::inDbWirePostAppend(dbWire* src, dbWire* dst)
+{
+  removeWire(dst);
+  addWire(dst);
+}
+
+}  // namespace odb
@@ -32,6 +32,8 @@
 
 #include "odb/dbStream.h"
 
+#include <algorithm>
+#include <cstring>
 #include <iostream>
 #include <sstream>
 
@@ -125,7 +127,11 @@ dbIStream& operator>>(dbIStream& stream, Oct& o)
   return stream;
 }
 
-dbOStream::dbOStream(_dbDatabase* db, std::ostream& f) : _f(f)
+dbOStream::dbOStream(_dbDatabase* db, std::ostream& f)
+    : _f(f),
+      _buffer(new char[kStreamBufferSize]),
+      _buffer_used(0),
+      _flushed_bytes(0)
 {
   _db = db;
   _lef_dist_factor = 0.001;
@@ -139,7 +145,12 @@ dbOStream::dbOStream(_dbDatabase* db, std::ostream& f) : _f(f)
   }
 }
 
-dbIStream::dbIStream(_dbDatabase* db, std::istream& f) : _f(f)
+dbIStream::dbIStream(_dbDatabase* db, std::istream& f)
+    : _f(f),
+      _buffer(new char[kStreamBufferSize]),
+      _buffer_pos(0),
+      _buffer_end(0),
+      _fetched_bytes(0)
 {
   _db = db;
 
@@ -154,6 +165,94 @@ dbIStream::dbIStream(_dbDatabase* db, std::istream& f) : _f(f)
   }
 }
 
+dbOStream::~dbOStream()
+{
+  // Callers are expected to flush() explicitly so that write errors are
+  // reported; this is only a safety net.
+  try {
+    flush();
+  } catch (const std::ios_base::failure&) {
+  }
+}
+
+void dbOStream::flush()
+{
+  if (_buffer_used > 0) {
+    _f.write(_buffer.get(), _buffer_used);
+    _flushed_bytes += _buffer_used;
+    _buffer_used = 0;
+  }
+}
+
+bool dbOStream::canPatch()
+{
+  flush();
+  return _f.tellp() != Position(-1);
+}
+
+void dbOStream::patchBytes(uint64_t offset, const void* data, size_t size)
+{
+  flush();
+  const Position end = _f.tellp();
+  _f.seekp(end - std::streamoff(_flushed_bytes - offset));
+  _f.write(static_cast<const char*>(data), size);
+  _f.seekp(end);
+}
+
+void dbOStream::writeBytesSlow(const void* data, size_t size)
+{
+  flush();
+  if (size >= kStreamBufferSize) {
+    // Large blocks (eg whole pages) bypass the staging buffer.
+    _f.write(static_cast<const char*>(data), size);
+    _flushed_bytes += size;
+  } else {
+    std::memcpy(_buffer.get(), data, size);
+    _buffer_used = size;
+  }
+}
+
+dbIStream::~dbIStream()
+{
+  // Return any read-ahead to the underlying stream so the caller sees the
+  // same position as if every value had been read individually.
+  const size_t unread = _buffer_end - _buffer_pos;
+  if (unread > 0) {
+    _f.rdbuf()->pubseekoff(
+        -static_cast<std::streamoff>(unread), std::ios::cur, std::ios::in);
+  }
+}
+
+void dbIStream::readBytesSlow(void* data, size_t size)
+{
+  char* dst = static_cast<char*>(data);
+
+  const size_t avail = _buffer_end - _buffer_pos;
+  std::memcpy(dst, _buffer.get() + _buffer_pos, avail);
+  dst += avail;
+  size -= avail;
+  _buffer_pos = _buffer_end = 0;
+
+  std::streambuf* buf = _f.rdbuf();
+  std::streamsize got;
+  if (size >= kStreamBufferSize) {
+    // Large blocks are read directly into their destination.
+    got = buf->sgetn(dst, size);
+    _fetched_bytes += got;
+  } else {
+    _buffer_end = buf->sgetn(_buffer.get(), kStreamBufferSize);
+    _fetched_bytes += _buffer_end;
+    got = std::min(size, _buffer_end);
+    std::memcpy(dst, _buffer.get(), got);
+    _buffer_pos = got;
+  }
+
+  if (got < static_cast<std::streamsize>(size)) {
+    std::memset(dst + got, 0, size - got);
+    _f.setstate(std::ios::eofbit | std::ios::failbit);
+  }
+}
+
 std::ostream& operator<<(std::ostream& os, const Rect& box)
 {
   os << "( " << box.xMin() << " " << box.yMin() << " ) ( " << box.xMax() << " "
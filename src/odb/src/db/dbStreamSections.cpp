@@ -0,0 +1,319 @@
+///////////////////////////////////////////////////////////////////////////////
+// BSD 3-Clause License
+//
+// Copyright (c) 2024, The Regents of the University of California
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#include "dbStreamSections.h"
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <istream>
+#include <memory>
+#include <ostream>
+#include <thread>
+
+#include "dbDatabase.h"
+#include "odb/ZException.h"
+#include "odb/dbStream.h"
+#include "utl/Logger.h"
+
+namespace odb {
+
+namespace {
+
+// Read-only streambuf over a range of memory owned by someone else.
+class dbMemoryBuf : public std::streambuf
+{
+ public:
+  dbMemoryBuf(const char* data, uint64_t size)
+  {
+    char* begin = const_cast<char*>(data);
+    setg(begin, begin, begin + size);
+  }
+};
+
+// Write-only streambuf that drops everything; used to size a section.
+class dbCountingBuf : public std::streambuf
+{
+ protected:
+  int_type overflow(int_type c) override { return traits_type::not_eof(c); }
+  std::streamsize xsputn(const char*, std::streamsize n) override { return n; }
+};
+
+// Run decoder over a section's bytes, which it must consume exactly.
+void decodeSection(_dbDatabase* db,
+                   const std::string& name,
+                   const std::function<void(dbIStream&)>& decoder,
+                   const char* data,
+                   uint64_t size)
+{
+  dbMemoryBuf buffer(data, size);
+  std::istream in(&buffer);
+  in.exceptions(std::ios::failbit | std::ios::badbit | std::ios::eofbit);
+
+  dbIStream section_stream(db, in);
+  decoder(section_stream);
+
+  if (section_stream.bytesRead() != size) {
+    throw ZException("database section %s is corrupt", name.c_str());
+  }
+}
+
+}  // namespace
+
+////////////////////////////////////////////////////////////////////
+//
+// dbSectionWriter - Methods
+//
+////////////////////////////////////////////////////////////////////
+
+dbSectionWriter::dbSectionWriter(dbOStream& stream) : stream_(stream)
+{
+}
+
+void dbSectionWriter::add(const char* name, Encoder encoder)
+{
+  sections_.push_back({name, std::move(encoder)});
+}
+
+void dbSectionWriter::addEncoded(const char* name, const std::string& data)
+{
+  sections_.push_back({name, nullptr, &data});
+}
+
+void dbSectionWriter::write()
+{
+  stream_ << (uint) sections_.size();
+  if (stream_.canPatch()) {
+    // Reserve the size index and fill it in as the sections are streamed.
+    const uint64_t index_offset = stream_.bytesWritten();
+    for (size_t i = 0; i < sections_.size(); ++i) {
+      stream_ << (uint64_t) 0;
+    }
+    for (size_t i = 0; i < sections_.size(); ++i) {
+      const uint64_t size = writeSection(sections_[i]);
+      stream_.patchBytes(
+          index_offset + i * sizeof(uint64_t), &size, sizeof(size));
+    }
+    return;
+  }
+
+  // The stream can't seek back (e.g. it is compressed), so size the
+  // sections with a dry run first.
+  for (Section& section : sections_) {
+    if (section.data) {
+      stream_ << (uint64_t) section.data->size();
+      continue;
+    }
+    dbCountingBuf counter;
+    std::ostream null_stream(&counter);
+    dbOStream count_stream(stream_.getDatabase(), null_stream);
+    section.encoder(count_stream);
+    stream_ << count_stream.bytesWritten();
+  }
+  for (Section& section : sections_) {
+    writeSection(section);
+  }
+}
+
+uint64_t dbSectionWriter::writeSection(Section& section)
+{
+  if (section.data) {
+    stream_.writeBytes(section.data->data(), section.data->size());
+    return section.data->size();
+  }
+  const uint64_t start = stream_.bytesWritten();
+  {
+    dbOStreamScope scope(stream_, section.name);
+    section.encoder(stream_);
+  }
+  return stream_.bytesWritten() - start;
+}
+
+////////////////////////////////////////////////////////////////////
+//
+// dbSectionReader - Methods
+//
+////////////////////////////////////////////////////////////////////
+
+dbSectionReader::dbSectionReader(dbIStream& stream) : stream_(stream)
+{
+}
+
+void dbSectionReader::add(const char* name,
+                          Decoder decoder,
+                          dbDeferredSections* deferred)
+{
+  sections_.push_back({name, std::move(decoder), deferred});
+}
+
+void dbSectionReader::read(int num_threads)
+{
+  uint count;
+  stream_ >> count;
+  if (count != sections_.size()) {
+    throw ZException("database file has %u sections where %zu are expected",
+                     count,
+                     sections_.size());
+  }
+
+  uint64_t total = 0;
+  for (Section& section : sections_) {
+    stream_ >> section.size;
+    total += section.size;
+  }
+
+  // Pull all the payloads in with one bulk read; the decoders then work
+  // from memory.
+  std::unique_ptr<char[]> data(new char[total]);
+  stream_.readBytes(data.get(), total);
+
+  std::vector<Section*> order;
+  order.reserve(sections_.size());
+  uint64_t offset = 0;
+  for (Section& section : sections_) {
+    section.data = data.get() + offset;
+    offset += section.size;
+    if (section.deferred) {
+      section.deferred->add(section.name.c_str(),
+                            std::move(section.decoder),
+                            std::string(section.data, section.size));
+    } else {
+      order.push_back(&section);
+    }
+  }
+  if (order.empty()) {
+    return;
+  }
+
+  // Start the biggest sections first so they don't end up as the tail.
+  std::stable_sort(order.begin(), order.end(), [](Section* a, Section* b) {
+    return a->size > b->size;
+  });
+
+  std::atomic<size_t> next = 0;
+  std::vector<std::exception_ptr> errors(order.size());
+  auto work = [&]() {
+    for (size_t i = next++; i < order.size(); i = next++) {
+      try {
+        const Section& section = *order[i];
+        decodeSection(stream_.getDatabase(),
+                      section.name,
+                      section.decoder,
+                      section.data,
+                      section.size);
+      } catch (...) {
+        errors[i] = std::current_exception();
+      }
+    }
+  };
+
+  const int num_workers
+      = std::clamp(num_threads, 1, static_cast<int>(order.size()));
+  std::vector<std::thread> workers;
+  for (int i = 1; i < num_workers; ++i) {
+    workers.emplace_back(work);
+  }
+  work();
+  for (std::thread& worker : workers) {
+    worker.join();
+  }
+
+  for (const std::exception_ptr& error : errors) {
+    if (error) {
+      std::rethrow_exception(error);
+    }
+  }
+}
+
+////////////////////////////////////////////////////////////////////
+//
+// dbDeferredSections - Methods
+//
+////////////////////////////////////////////////////////////////////
+
+dbDeferredSections::dbDeferredSections(_dbDatabase* db) : db_(db)
+{
+}
+
+void dbDeferredSections::add(const char* name,
+                             Decoder decoder,
+                             std::string data)
+{
+  sections_.push_back({name, std::move(decoder), std::move(data)});
+}
+
+const std::string* dbDeferredSections::findEncoded(const char* name) const
+{
+  if (isLoaded()) {
+    return nullptr;
+  }
+  for (const Section& section : sections_) {
+    if (section.name == name) {
+      return &section.data;
+    }
+  }
+  return nullptr;
+}
+
+void dbDeferredSections::loadSlow()
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (isLoaded()) {
+    return;
+  }
+
+  uint64_t bytes = 0;
+  for (Section& section : sections_) {
+    decodeSection(db_,
+                  section.name,
+                  section.decoder,
+                  section.data.data(),
+                  section.data.size());
+    bytes += section.data.size();
+    // The decoded table is the only copy from here on.
+    std::string().swap(section.data);
+  }
+  loaded_.store(true, std::memory_order_release);
+
+  utl::Logger* logger = db_->_logger;
+  if (logger) {
+    debugPrint(logger,
+               utl::ODB,
+               "lazy_load",
+               1,
+               "decoded {} deferred sections ({} bytes)",
+               sections_.size(),
+               bytes);
+  }
+}
+
+}  // namespace odb
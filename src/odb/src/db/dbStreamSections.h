@@ -0,0 +1,180 @@
+///////////////////////////////////////////////////////////////////////////////
+// BSD 3-Clause License
+//
+// Copyright (c) 2024, The Regents of the University of California
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace odb {
+
+class _dbDatabase;
+class dbDeferredSections;
+class dbIStream;
+class dbOStream;
+
+//
+// dbSectionWriter - Streams a fixed sequence of independent sections.
+//
+// Each section is streamed straight to the output, without being buffered,
+// as:
+//
+//   uint          number of sections
+//   uint64_t[n]   size in bytes of each section
+//   char[...]     section payloads in order
+//
+// The size index lets dbSectionReader locate every section before decoding
+// any of them, so the sections can be decoded concurrently.  It is
+// back-patched once the sections are written, or computed by a dry run of
+// the encoders if the output can not seek.
+//
+class dbSectionWriter
+{
+ public:
+  using Encoder = std::function<void(dbOStream&)>;
+
+  dbSectionWriter(dbOStream& stream);
+
+  void add(const char* name, Encoder encoder);
+
+  // Add a section that is already encoded, e.g. one that was never
+  // decoded after a lazy read.
+  void addEncoded(const char* name, const std::string& data);
+
+  void write();
+
+ private:
+  struct Section
+  {
+    std::string name;
+    Encoder encoder;
+    const std::string* data = nullptr;
+  };
+
+  // Stream one section's payload and return its size in bytes.
+  uint64_t writeSection(Section& section);
+
+  dbOStream& stream_;
+  std::vector<Section> sections_;
+};
+
+//
+// dbSectionReader - Reads sections written by dbSectionWriter.
+//
+// Decoders must be added in the same order as the encoders were on the
+// writing side.  Each decoder gets a private dbIStream over its section's
+// bytes and must consume exactly that many bytes.  Decoders may run on
+// different threads and so must not touch state shared with another
+// section.
+//
+class dbSectionReader
+{
+ public:
+  using Decoder = std::function<void(dbIStream&)>;
+
+  dbSectionReader(dbIStream& stream);
+
+  // If deferred is not null the section is not decoded by read() but
+  // handed to deferred, which decodes it on demand.
+  void add(const char* name,
+           Decoder decoder,
+           dbDeferredSections* deferred = nullptr);
+
+  // Decode all sections using up to num_threads threads.
+  void read(int num_threads);
+
+ private:
+  struct Section
+  {
+    std::string name;
+    Decoder decoder;
+    dbDeferredSections* deferred;
+    const char* data = nullptr;
+    uint64_t size = 0;
+  };
+
+  dbIStream& stream_;
+  std::vector<Section> sections_;
+};
+
+//
+// dbDeferredSections - A group of sections kept encoded after a read.
+//
+// The group is decoded as a whole the first time load() is called.  Until
+// then the encoded bytes can be written back out unchanged, so a database
+// that is read and written without touching the group never decodes it.
+//
+class dbDeferredSections
+{
+ public:
+  using Decoder = std::function<void(dbIStream&)>;
+
+  dbDeferredSections(_dbDatabase* db);
+
+  void add(const char* name, Decoder decoder, std::string data);
+
+  bool isLoaded() const { return loaded_.load(std::memory_order_acquire); }
+
+  // Decode the group unless that has already been done.  Safe to call
+  // from several threads.
+  void load()
+  {
+    if (!isLoaded()) {
+      loadSlow();
+    }
+  }
+
+  // The encoded bytes of the named section, or null if the group has been
+  // loaded or holds no such section.
+  const std::string* findEncoded(const char* name) const;
+
+ private:
+  struct Section
+  {
+    std::string name;
+    Decoder decoder;
+    std::string data;
+  };
+
+  void loadSlow();
+
+  _dbDatabase* db_;
+  std::vector<Section> sections_;
+  std::mutex mutex_;
+  std::atomic<bool> loaded_ = false;
+};
+
+}  // namespace odb
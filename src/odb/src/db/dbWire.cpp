@@ -1788,6 +1788,7 @@ dbWire* dbWire::create(dbNet* net_, bool global_wire)
   }
 
   _dbBlock* block = (_dbBlock*) net->getOwner();
+  block->loadWires();
   _dbWire* wire = block->_wire_tbl->create();
   wire->_net = net->getOID();
 
@@ -1809,6 +1810,7 @@ dbWire* dbWire::create(dbNet* net_, bool global_wire)
 dbWire* dbWire::create(dbBlock* block_, bool /* unused: global_wire */)
 {
   _dbBlock* block = (_dbBlock*) block_;
+  block->loadWires();
   _dbWire* wire = block->_wire_tbl->create();
   for (auto callback : block->_callbacks) {
     callback->inDbWireCreate((dbWire*) wire);
@@ -1819,6 +1821,7 @@ dbWire* dbWire::create(dbBlock* block_, bool /* unused: global_wire */)
 dbWire* dbWire::getWire(dbBlock* block_, uint dbid_)
 {
   _dbBlock* block = (_dbBlock*) block_;
+  block->loadWires();
   return (dbWire*) block->_wire_tbl->getPtr(dbid_);
 }
 
@@ -0,0 +1,473 @@
+///////////////////////////////////////////////////////////////////////////////
+// BSD 3-Clause License
+//
+// Copyright (c) 2024, The Regents of the University of California
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#include "odb/dbWireShapes.h"
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+#include "dbWire.h"
+#include "dbWireOpcode.h"
+#include "odb/db.h"
+
+namespace odb {
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+// dbWireShapeDecoder
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+dbWireShapeDecoder::dbWireShapeDecoder(dbBlock* block) : block_(block)
+{
+}
+
+const dbWireShapeDecoder::LayerInfo& dbWireShapeDecoder::layerInfo(
+    dbTechLayer* layer)
+{
+  const uint id = layer->getId();
+  if (id >= layers_.size()) {
+    layers_.resize(id + 1);
+  }
+  LayerInfo& info = layers_[id];
+  if (!info.valid) {
+    info.valid = true;
+    info.half_width = layer->getWidth() >> 1;
+    info.wrong_way_half_width = layer->getWrongWayWidth() / 2;
+    info.horizontal = layer->getDirection() == dbTechLayerDir::HORIZONTAL;
+    info.vertical = layer->getDirection() == dbTechLayerDir::VERTICAL;
+  }
+  return info;
+}
+
+const dbWireShapeDecoder::ViaInfo& dbWireShapeDecoder::viaInfo(int id,
+                                                               bool tech_via)
+{
+  std::vector<ViaInfo>& vias = tech_via ? tech_vias_ : block_vias_;
+  if (id >= (int) vias.size()) {
+    vias.resize(id + 1);
+  }
+  ViaInfo& info = vias[id];
+  if (!info.valid) {
+    info.valid = true;
+    dbBox* box;
+    if (tech_via) {
+      dbTechVia* via = dbTechVia::getTechVia(block_->getTech(), id);
+      info.top = via->getTopLayer();
+      info.bottom = via->getBottomLayer();
+      box = via->getBBox();
+    } else {
+      dbVia* via = dbVia::getVia(block_, id);
+      info.top = via->getTopLayer();
+      info.bottom = via->getBottomLayer();
+      box = via->getBBox();
+    }
+    if (box) {
+      info.has_box = true;
+      info.box = box->getBox();
+    }
+  }
+  return info;
+}
+
+// This follows dbWireShapeItr::next opcode for opcode.
+void dbWireShapeDecoder::decode(dbWire* wire_,
+                                std::vector<dbShape>& shapes,
+                                std::vector<int>* shape_ids)
+{
+  _dbWire* wire = (_dbWire*) wire_;
+  dbTech* tech = block_->getTech();
+  const auto& opcodes = wire->_opcodes;
+  const auto& data = wire->_data;
+  const int length = opcodes.size();
+
+  // The point and layer that getPrevPoint would find from each opcode.
+  xs_.resize(length);
+  ys_.resize(length);
+  point_layers_.resize(length);
+  int point_x = 0;
+  int point_y = 0;
+  dbTechLayer* point_layer = nullptr;
+
+  int idx = 0;
+  // Returns the next opcode and its operand, updating the point table.
+  auto nextOp = [&](int& value) {
+    const unsigned char opcode = opcodes[idx];
+    value = data[idx];
+    switch (opcode & WOP_OPCODE_MASK) {
+      case WOP_PATH:
+      case WOP_SHORT:
+        point_layer = dbTechLayer::getTechLayer(tech, value);
+        break;
+      case WOP_JUNCTION:
+        point_x = xs_[value];
+        point_y = ys_[value];
+        point_layer = point_layers_[value];
+        break;
+      case WOP_X:
+        point_x = value;
+        break;
+      case WOP_Y:
+        point_y = value;
+        break;
+      case WOP_VIA:
+      case WOP_TECH_VIA: {
+        const ViaInfo& via
+            = viaInfo(value, (opcode & WOP_OPCODE_MASK) == WOP_TECH_VIA);
+        point_layer = (opcode & WOP_VIA_EXIT_TOP) ? via.top : via.bottom;
+        break;
+      }
+      default:
+        break;
+    }
+    xs_[idx] = point_x;
+    ys_[idx] = point_y;
+    point_layers_[idx] = point_layer;
+    ++idx;
+    return opcode;
+  };
+
+  int prev_x = 0;
+  int prev_y = 0;
+  int prev_ext = 0;
+  bool has_prev_ext = false;
+  dbTechLayer* layer = nullptr;
+  const LayerInfo* layer_info = nullptr;
+  int dw = 0;
+  int point_cnt = 0;
+  bool has_width = false;
+
+  auto addShape = [&](int shape_id) -> dbShape& {
+    if (shape_ids) {
+      shape_ids->push_back(shape_id);
+    }
+    return shapes.emplace_back();
+  };
+
+  while (idx < length) {
+    const int shape_id = idx;
+    int operand;
+    unsigned char opcode = nextOp(operand);
+
+    switch (opcode & WOP_OPCODE_MASK) {
+      case WOP_PATH:
+      case WOP_SHORT:
+      case WOP_VWIRE: {
+        layer = (opcode & WOP_OPCODE_MASK) == WOP_VWIRE
+                    ? dbTechLayer::getTechLayer(tech, operand)
+                    : point_layer;
+        layer_info = &layerInfo(layer);
+        point_cnt = 0;
+        dw = layer_info->half_width;
+        break;
+      }
+
+      case WOP_JUNCTION: {
+        layer = point_layers_[operand];
+        layer_info = &layerInfo(layer);
+        prev_x = xs_[operand];
+        prev_y = ys_[operand];
+        prev_ext = 0;
+        has_prev_ext = false;
+        point_cnt = 0;
+        dw = layer_info->half_width;
+        break;
+      }
+
+      case WOP_RULE: {
+        dbTechLayerRule* rule
+            = (opcode & WOP_BLOCK_RULE)
+                  ? dbTechLayerRule::getTechLayerRule(block_, operand)
+                  : dbTechLayerRule::getTechLayerRule(tech, operand);
+        dw = rule->getWidth() >> 1;
+        has_width = true;
+        break;
+      }
+
+      case WOP_X: {
+        const int cur_x = operand;
+        int cur_y;
+        if (point_cnt == 0) {
+          opcode = nextOp(cur_y);
+        } else {
+          cur_y = prev_y;
+        }
+
+        int cur_ext = 0;
+        bool has_cur_ext = false;
+        if (opcode & WOP_EXTENSION) {
+          nextOp(cur_ext);
+          has_cur_ext = true;
+        }
+
+        if (point_cnt++ != 0) {
+          const int width
+              = layer_info->vertical ? layer_info->wrong_way_half_width : dw;
+          addShape(shape_id).setSegment(prev_x,
+                                        prev_y,
+                                        prev_ext,
+                                        has_prev_ext,
+                                        cur_x,
+                                        cur_y,
+                                        cur_ext,
+                                        has_cur_ext,
+                                        width,
+                                        dw,
+                                        layer);
+        }
+        prev_x = cur_x;
+        prev_y = cur_y;
+        prev_ext = cur_ext;
+        has_prev_ext = has_cur_ext;
+        break;
+      }
+
+      case WOP_Y: {
+        point_cnt++;
+        const int cur_y = operand;
+        int cur_ext = 0;
+        bool has_cur_ext = false;
+        if (opcode & WOP_EXTENSION) {
+          nextOp(cur_ext);
+          has_cur_ext = true;
+        }
+
+        const int width
+            = layer_info->horizontal ? layer_info->wrong_way_half_width : dw;
+        addShape(shape_id).setSegment(prev_x,
+                                      prev_y,
+                                      prev_ext,
+                                      has_prev_ext,
+                                      prev_x,
+                                      cur_y,
+                                      cur_ext,
+                                      has_cur_ext,
+                                      width,
+                                      dw,
+                                      layer);
+        prev_y = cur_y;
+        prev_ext = cur_ext;
+        has_prev_ext = has_cur_ext;
+        break;
+      }
+
+      case WOP_COLINEAR: {
+        point_cnt++;
+
+        // A colinear-point with an extension begins a new path-segment
+        if (opcode & WOP_EXTENSION) {
+          prev_ext = operand;
+          has_prev_ext = true;
+          break;
+        }
+
+        // A colinear-point following an extension cancels the ext
+        if (has_prev_ext) {
+          prev_ext = 0;
+          has_prev_ext = false;
+          break;
+        }
+
+        if (point_cnt > 1) {
+          addShape(shape_id).setSegment(prev_x,
+                                        prev_y,
+                                        prev_ext,
+                                        has_prev_ext,
+                                        prev_x,
+                                        prev_y,
+                                        0,
+                                        false,
+                                        dw,
+                                        dw,
+                                        layer);
+        }
+        has_prev_ext = false;
+        break;
+      }
+
+      case WOP_VIA:
+      case WOP_TECH_VIA: {
+        const bool tech_via = (opcode & WOP_OPCODE_MASK) == WOP_TECH_VIA;
+        const ViaInfo& via = viaInfo(operand, tech_via);
+        layer = (opcode & WOP_VIA_EXIT_TOP) ? via.top : via.bottom;
+        layer_info = &layerInfo(layer);
+        if (!has_width) {
+          dw = layer_info->half_width;
+        }
+        prev_ext = 0;
+        has_prev_ext = false;
+
+        if (!via.has_box) {
+          break;
+        }
+        Rect r = via.box;
+        r.moveDelta(prev_x, prev_y);
+        if (tech_via) {
+          addShape(shape_id).setVia(
+              dbTechVia::getTechVia(tech, operand), r);
+        } else {
+          addShape(shape_id).setVia(dbVia::getVia(block_, operand), r);
+        }
+        break;
+      }
+
+      case WOP_RECT: {
+        int delta_y1;
+        int delta_x2;
+        int delta_y2;
+        nextOp(delta_y1);
+        nextOp(delta_x2);
+        nextOp(delta_y2);
+        addShape(shape_id).setSegmentFromRect(prev_x + operand,
+                                              prev_y + delta_y1,
+                                              prev_x + delta_x2,
+                                              prev_y + delta_y2,
+                                              layer);
+        break;
+      }
+
+      default:
+        break;
+    }
+  }
+}
+
+void dbWireShapeDecoder::decode(const std::vector<dbNet*>& nets,
+                                std::vector<std::vector<dbShape>>& shapes)
+{
+  shapes.clear();
+  shapes.resize(nets.size());
+  if (nets.empty()) {
+    return;
+  }
+
+  dbBlock* block = nets[0]->getBlock();
+  const int num_threads = std::clamp(
+      block->getDb()->getThreadCount(), 1, static_cast<int>(nets.size()));
+  std::atomic<size_t> next = 0;
+  auto work = [&]() {
+    dbWireShapeDecoder decoder(block);
+    for (size_t i = next++; i < nets.size(); i = next++) {
+      dbWire* wire = nets[i]->getWire();
+      if (wire) {
+        decoder.decode(wire, shapes[i]);
+      }
+    }
+  };
+
+  if (num_threads == 1) {
+    work();
+    return;
+  }
+  std::vector<std::thread> workers;
+  workers.reserve(num_threads);
+  for (int i = 0; i < num_threads; ++i) {
+    workers.emplace_back(work);
+  }
+  for (std::thread& worker : workers) {
+    worker.join();
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+// dbWireShapeCache
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+dbWireShapeCache::dbWireShapeCache(dbBlock* block) : block_(block)
+{
+  addOwner(block);
+}
+
+const std::vector<dbShape>& dbWireShapeCache::getShapes(dbWire* wire)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto [it, inserted] = shapes_.try_emplace(wire);
+  if (inserted) {
+    dbWireShapeDecoder decoder(block_);
+    decoder.decode(wire, it->second);
+  }
+  return it->second;
+}
+
+void dbWireShapeCache::prefetch(const std::vector<dbNet*>& nets)
+{
+  std::vector<dbNet*> missing;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (dbNet* net : nets) {
+      dbWire* wire = net->getWire();
+      if (wire && shapes_.find(wire) == shapes_.end()) {
+        missing.push_back(net);
+      }
+    }
+  }
+
+  std::vector<std::vector<dbShape>> shapes;
+  dbWireShapeDecoder::decode(missing, shapes);
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (size_t i = 0; i < missing.size(); ++i) {
+    shapes_.try_emplace(missing[i]->getWire(), std::move(shapes[i]));
+  }
+}
+
+void dbWireShapeCache::clear()
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  shapes_.clear();
+}
+
+void dbWireShapeCache::invalidate(dbWire* wire)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  shapes_.erase(wire);
+}
+
+void dbWireShapeCache::inDbWireDestroy(dbWire* wire)
+{
+  invalidate(wire);
+}
+
+void dbWireShapeCache::inDbWirePostModify(dbWire* wire)
+{
+  invalidate(wire);
+}
+
+void dbWireShapeCache::inDbWirePostAppend(dbWire* /* src */, dbWire* dst)
+{
+  invalidate(dst);
+}
+
+}  // namespace odb
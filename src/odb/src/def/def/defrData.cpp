@@ -498,6 +498,8 @@ defrContext::defrContext(int ownConf)
 {
 }
 
-defrContext defContext;
+// Each thread has its own reader context so that separate DEF texts can be
+// parsed concurrently (see odb/src/defin/definSections.h).
+thread_local defrContext defContext;
 
 END_LEFDEF_PARSER_NAMESPACE
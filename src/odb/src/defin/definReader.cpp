@@ -32,10 +32,13 @@
 
 #include "definReader.h"
 
+#include <algorithm>
 #include <cctype>
 #include <cstdio>
 #include <cstdlib>
+#include <fstream>
 #include <iostream>
+#include <memory>
 #include <string>
 
 #include "definBlockage.h"
@@ -49,9 +52,11 @@
 #include "definPin.h"
 #include "definPinProps.h"
 #include "definPropDefs.h"
+#include "definRecorder.h"
 #include "definRegion.h"
 #include "definRow.h"
 #include "definSNet.h"
+#include "definSections.h"
 #include "definTracks.h"
 #include "definVia.h"
 #include "defzlib.hpp"
@@ -179,6 +184,7 @@ definReader::definReader(dbDatabase* db, utl::Logger* logger, defin::MODE mode)
   hier_delimeter_ = 0;
   left_bus_delimeter_ = 0;
   right_bus_delimeter_ = 0;
+  sections_ = nullptr;
 
   definBase::setLogger(logger);
   definBase::setMode(mode);
@@ -374,6 +380,404 @@ static std::string renameBlock(dbBlock* parent, const char* old_name)
   }
 }
 
+template <typename READER, typename COMPONENT>
+int definReader::translateComponent(READER* reader,
+                                    defiComponent* comp,
+                                    COMPONENT* componentR)
+{
+  if (comp->hasEEQ()) {
+    UNSUPPORTED("EEQMASTER on component is unsupported");
+  }
+
+  if (comp->maskShiftSize() > 0) {
+    UNSUPPORTED("MASKSHIFT on component is unsupported");
+  }
+
+  if (comp->hasRouteHalo() > 0) {
+    UNSUPPORTED("ROUTEHALO on component is unsupported");
+  }
+
+  componentR->begin(comp->id(), comp->name());
+  if (comp->hasSource()) {
+    componentR->source(dbSourceType(comp->source()));
+  }
+  if (comp->hasWeight()) {
+    componentR->weight(comp->weight());
+  }
+  if (comp->hasRegionName()) {
+    componentR->region(comp->regionName());
+  }
+  if (comp->hasHalo() > 0) {
+    int left, bottom, right, top;
+    comp->haloEdges(&left, &bottom, &right, &top);
+    componentR->halo(left, bottom, right, top);
+  }
+
+  componentR->placement(comp->placementStatus(),
+                        comp->placementX(),
+                        comp->placementY(),
+                        comp->placementOrient());
+
+  handle_props(comp, componentR);
+
+  componentR->end();
+
+  return PARSE_OK;
+}
+
+template <typename READER, typename NET>
+int definReader::translateNet(READER* reader, defiNet* net, NET* netR)
+{
+  if (net->numShieldNets() > 0) {
+    UNSUPPORTED("SHIELDNET on net is unsupported");
+  }
+
+  if (net->numVpins() > 0) {
+    UNSUPPORTED("VPIN on net is unsupported");
+  }
+
+  if (net->hasSubnets()) {
+    UNSUPPORTED("SUBNET on net is unsupported");
+  }
+
+  if (net->hasXTalk()) {
+    UNSUPPORTED("XTALK on net is unsupported");
+  }
+
+  if (net->hasFrequency()) {
+    UNSUPPORTED("FREQUENCY on net is unsupported");
+  }
+
+  if (net->hasOriginal()) {
+    UNSUPPORTED("ORIGINAL on net is unsupported");
+  }
+
+  if (net->hasPattern()) {
+    UNSUPPORTED("PATTERN on net is unsupported");
+  }
+
+  if (net->hasCap()) {
+    UNSUPPORTED("ESTCAP on net is unsupported");
+  }
+
+  netR->begin(net->name());
+
+  if (net->hasUse()) {
+    netR->use(net->use());
+  }
+
+  if (net->hasSource()) {
+    netR->source(net->source());
+  }
+
+  if (net->hasFixedbump()) {
+    netR->fixedbump();
+  }
+
+  if (net->hasWeight()) {
+    netR->weight(net->weight());
+  }
+
+  if (net->hasNonDefaultRule()) {
+    netR->nonDefaultRule(net->nonDefaultRule());
+  }
+
+  for (int i = 0; i < net->numConnections(); ++i) {
+    if (net->pinIsSynthesized(i)) {
+      UNSUPPORTED("SYNTHESIZED on net's connection is unsupported");
+    }
+
+    if (net->pinIsMustJoin(i)) {
+      netR->beginMustjoin(net->instance(i), net->pin(i));
+    } else {
+      netR->connection(net->instance(i), net->pin(i));
+    }
+  }
+
+  for (int i = 0; i < net->numWires(); ++i) {
+    defiWire* wire = net->wire(i);
+    netR->wire(wire->wireType());
+
+    for (int j = 0; j < wire->numPaths(); ++j) {
+      defiPath* path = wire->path(j);
+
+      path->initTraverse();
+
+      int pathId;
+      while ((pathId = path->next()) != DEFIPATH_DONE) {
+        switch (pathId) {
+          case DEFIPATH_LAYER: {
+            // We need to peek ahead to see if there is a taper next
+            const char* layer = path->getLayer();
+            int nextId = path->next();
+            if (nextId == DEFIPATH_TAPER) {
+              netR->pathTaper(layer);
+            } else if (nextId == DEFIPATH_TAPERRULE) {
+              netR->pathTaperRule(layer, path->getTaperRule());
+            } else {
+              netR->path(layer);
+              path->prev();  // put back the token
+            }
+            break;
+          }
+
+          case DEFIPATH_VIA: {
+            // We need to peek ahead to see if there is a rotation next
+            const char* viaName = path->getVia();
+            int nextId = path->next();
+            if (nextId == DEFIPATH_VIAROTATION) {
+              netR->pathVia(viaName,
+                            translate_orientation(path->getViaRotation()));
+            } else {
+              netR->pathVia(viaName);
+              path->prev();  // put back the token
+            }
+            break;
+          }
+
+          case DEFIPATH_POINT: {
+            int x;
+            int y;
+            path->getPoint(&x, &y);
+            netR->pathPoint(x, y);
+            break;
+          }
+
+          case DEFIPATH_FLUSHPOINT: {
+            int x;
+            int y;
+            int ext;
+            path->getFlushPoint(&x, &y, &ext);
+            netR->pathPoint(x, y, ext);
+            break;
+          }
+
+          case DEFIPATH_STYLE:
+            UNSUPPORTED("styles are not supported on wires");
+            break;
+
+          case DEFIPATH_RECT: {
+            int deltaX1;
+            int deltaY1;
+            int deltaX2;
+            int deltaY2;
+            path->getViaRect(&deltaX1, &deltaY1, &deltaX2, &deltaY2);
+            netR->pathRect(deltaX1, deltaY1, deltaX2, deltaY2);
+            break;
+          }
+
+          case DEFIPATH_VIRTUALPOINT:
+            UNSUPPORTED("VIRTUAL in net's routing is unsupported");
+            break;
+
+          case DEFIPATH_MASK:
+            netR->pathColor(path->getMask());
+            break;
+
+          case DEFIPATH_VIAMASK:
+            netR->pathViaColor(path->getViaBottomMask(),
+                               path->getViaCutMask(),
+                               path->getViaTopMask());
+            break;
+
+          default:
+            UNSUPPORTED("Unknown construct in net's routing is unsupported");
+            break;
+        }
+      }
+      netR->pathEnd();
+    }
+
+    netR->wireEnd();
+  }
+
+  handle_props(net, netR);
+
+  netR->end();
+
+  return PARSE_OK;
+}
+
+template <typename READER, typename SNET>
+int definReader::translateSpecialNet(READER* reader, defiNet* net, SNET* snetR)
+{
+  if (net->hasCap()) {
+    UNSUPPORTED("ESTCAP on special net is unsupported");
+  }
+
+  if (net->hasPattern()) {
+    UNSUPPORTED("PATTERN on special net is unsupported");
+  }
+
+  if (net->hasOriginal()) {
+    UNSUPPORTED("ORIGINAL on special net is unsupported");
+  }
+
+  if (net->numShieldNets() > 0) {
+    UNSUPPORTED("SHIELDNET on special net is unsupported");
+  }
+
+  if (net->hasVoltage()) {
+    UNSUPPORTED("VOLTAGE on special net is unsupported");
+  }
+
+  if (net->numPolygons() > 0) {
+    // The db does support polygons but the callback code seems incorrect to me
+    // (ignores layers!).  Delaying support until I can fix it.
+    UNSUPPORTED("polygons in special nets are not supported");
+  }
+
+  if (net->numViaSpecs() > 0) {
+    UNSUPPORTED("VIA in special net is unsupported");
+  }
+
+  snetR->begin(net->name());
+
+  if (net->hasUse()) {
+    snetR->use(net->use());
+  }
+
+  if (net->hasSource()) {
+    snetR->source(net->source());
+  }
+
+  if (net->hasFixedbump()) {
+    snetR->fixedbump();
+  }
+
+  if (net->hasWeight()) {
+    snetR->weight(net->weight());
+  }
+
+  for (int i = 0; i < net->numConnections(); ++i) {
+    snetR->connection(net->instance(i), net->pin(i), net->pinIsSynthesized(i));
+  }
+
+  if (net->numRectangles()) {
+    for (int i = 0; i < net->numRectangles(); i++) {
+      snetR->wire(net->rectRouteStatus(i), net->rectRouteStatusShieldName(i));
+      snetR->rect(net->rectName(i),
+                  net->xl(i),
+                  net->yl(i),
+                  net->xh(i),
+                  net->yh(i),
+                  net->rectShapeType(i),
+                  net->rectMask(i));
+      snetR->wireEnd();
+    }
+  }
+
+  for (int i = 0; i < net->numWires(); ++i) {
+    defiWire* wire = net->wire(i);
+    snetR->wire(wire->wireType(), wire->wireShieldNetName());
+
+    for (int j = 0; j < wire->numPaths(); ++j) {
+      defiPath* path = wire->path(j);
+
+      path->initTraverse();
+
+      std::string layerName;
+
+      int pathId;
+      uint next_mask = 0;
+      uint next_via_bottom_mask = 0;
+      uint next_via_cut_mask = 0;
+      uint next_via_top_mask = 0;
+      while ((pathId = path->next()) != DEFIPATH_DONE) {
+        switch (pathId) {
+          case DEFIPATH_LAYER:
+            layerName = path->getLayer();
+            break;
+
+          case DEFIPATH_VIA: {
+            // We need to peek ahead to see if there is a rotation next
+            const char* viaName = path->getVia();
+            int nextId = path->next();
+            if (nextId == DEFIPATH_VIAROTATION) {
+              UNSUPPORTED("Rotated via in special net is unsupported");
+              // TODO: Make this take and store rotation
+              // snetR->pathVia(viaName,
+              //                translate_orientation(path->getViaRotation()));
+            } else if (nextId == DEFIPATH_VIADATA) {
+              int numX, numY, stepX, stepY;
+              path->getViaData(&numX, &numY, &stepX, &stepY);
+              snetR->pathViaArray(viaName, numX, numY, stepX, stepY);
+            } else {
+              snetR->pathVia(viaName,
+                             next_via_bottom_mask,
+                             next_via_cut_mask,
+                             next_via_top_mask);
+              path->prev();  // put back the token
+            }
+            break;
+          }
+
+          case DEFIPATH_WIDTH:
+            assert(!layerName.empty());  // always "layerName routeWidth"
+            snetR->path(layerName.c_str(), path->getWidth());
+            break;
+
+          case DEFIPATH_POINT: {
+            int x;
+            int y;
+            path->getPoint(&x, &y);
+            snetR->pathPoint(x, y, next_mask);
+            break;
+          }
+
+          case DEFIPATH_FLUSHPOINT: {
+            int x;
+            int y;
+            int ext;
+            path->getFlushPoint(&x, &y, &ext);
+            snetR->pathPoint(x, y, ext, next_mask);
+            break;
+          }
+
+          case DEFIPATH_SHAPE:
+            snetR->pathShape(path->getShape());
+            break;
+
+          case DEFIPATH_STYLE:
+            UNSUPPORTED("styles are not supported on wires");
+            break;
+
+          case DEFIPATH_MASK:
+            next_mask = path->getMask();
+            break;
+
+          case DEFIPATH_VIAMASK:
+            next_via_bottom_mask = path->getViaBottomMask();
+            next_via_cut_mask = path->getViaCutMask();
+            next_via_top_mask = path->getViaTopMask();
+            break;
+
+          default:
+            UNSUPPORTED(
+                "Unknown construct in special net's routing is unsupported");
+        }
+        if (pathId != DEFIPATH_MASK) {
+          next_mask = 0;
+        }
+        if (pathId != DEFIPATH_VIAMASK) {
+          next_via_bottom_mask = 0;
+          next_via_cut_mask = 0;
+          next_via_top_mask = 0;
+        }
+      }
+      snetR->pathEnd();
+    }
+
+    snetR->wireEnd();
+  }
+
+  handle_props(net, snetR);
+
+  snetR->end();
+
+  return PARSE_OK;
+}
+
 int definReader::versionCallback(defrCallbackType_e /* unused: type */,
                                  const char* value,
                                  defiUserData data)
@@ -569,44 +973,7 @@ int definReader::componentsCallback(defrCallbackType_e /* unused: type */,
     return PARSE_OK;
   }
 
-  if (comp->hasEEQ()) {
-    UNSUPPORTED("EEQMASTER on component is unsupported");
-  }
-
-  if (comp->maskShiftSize() > 0) {
-    UNSUPPORTED("MASKSHIFT on component is unsupported");
-  }
-
-  if (comp->hasRouteHalo() > 0) {
-    UNSUPPORTED("ROUTEHALO on component is unsupported");
-  }
-
-  componentR->begin(comp->id(), comp->name());
-  if (comp->hasSource()) {
-    componentR->source(dbSourceType(comp->source()));
-  }
-  if (comp->hasWeight()) {
-    componentR->weight(comp->weight());
-  }
-  if (comp->hasRegionName()) {
-    componentR->region(comp->regionName());
-  }
-  if (comp->hasHalo() > 0) {
-    int left, bottom, right, top;
-    comp->haloEdges(&left, &bottom, &right, &top);
-    componentR->halo(left, bottom, right, top);
-  }
-
-  componentR->placement(comp->placementStatus(),
-                        comp->placementX(),
-                        comp->placementY(),
-                        comp->placementOrient());
-
-  handle_props(comp, componentR);
-
-  componentR->end();
-
-  return PARSE_OK;
+  return translateComponent(reader, comp, componentR);
 }
 
 int definReader::componentMaskShiftCallback(
@@ -796,190 +1163,24 @@ int definReader::historyCallback(defrCallbackType_e /* unused: type */,
   return PARSE_OK;
 }
 
-int definReader::netCallback(defrCallbackType_e /* unused: type */,
-                             defiNet* net,
-                             defiUserData data)
-{
-  definReader* reader = (definReader*) data;
-  CHECKBLOCK
-  definNet* netR = reader->_netR;
-  if (reader->_mode == defin::FLOORPLAN
-      && reader->_block->findNet(net->name()) == nullptr) {
-    reader->_logger->warn(
-        utl::ODB,
-        275,
-        "skipping undefined net {} encountered in FLOORPLAN DEF",
-        net->name());
-    return PARSE_OK;
-  }
-  if (net->numShieldNets() > 0) {
-    UNSUPPORTED("SHIELDNET on net is unsupported");
-  }
-
-  if (net->numVpins() > 0) {
-    UNSUPPORTED("VPIN on net is unsupported");
-  }
-
-  if (net->hasSubnets()) {
-    UNSUPPORTED("SUBNET on net is unsupported");
-  }
-
-  if (net->hasXTalk()) {
-    UNSUPPORTED("XTALK on net is unsupported");
-  }
-
-  if (net->hasFrequency()) {
-    UNSUPPORTED("FREQUENCY on net is unsupported");
-  }
-
-  if (net->hasOriginal()) {
-    UNSUPPORTED("ORIGINAL on net is unsupported");
-  }
-
-  if (net->hasPattern()) {
-    UNSUPPORTED("PATTERN on net is unsupported");
-  }
-
-  if (net->hasCap()) {
-    UNSUPPORTED("ESTCAP on net is unsupported");
-  }
-
-  netR->begin(net->name());
-
-  if (net->hasUse()) {
-    netR->use(net->use());
-  }
-
-  if (net->hasSource()) {
-    netR->source(net->source());
-  }
-
-  if (net->hasFixedbump()) {
-    netR->fixedbump();
-  }
-
-  if (net->hasWeight()) {
-    netR->weight(net->weight());
-  }
-
-  if (net->hasNonDefaultRule()) {
-    netR->nonDefaultRule(net->nonDefaultRule());
-  }
-
-  for (int i = 0; i < net->numConnections(); ++i) {
-    if (net->pinIsSynthesized(i)) {
-      UNSUPPORTED("SYNTHESIZED on net's connection is unsupported");
-    }
-
-    if (net->pinIsMustJoin(i)) {
-      netR->beginMustjoin(net->instance(i), net->pin(i));
-    } else {
-      netR->connection(net->instance(i), net->pin(i));
-    }
-  }
-
-  for (int i = 0; i < net->numWires(); ++i) {
-    defiWire* wire = net->wire(i);
-    netR->wire(wire->wireType());
-
-    for (int j = 0; j < wire->numPaths(); ++j) {
-      defiPath* path = wire->path(j);
-
-      path->initTraverse();
-
-      int pathId;
-      while ((pathId = path->next()) != DEFIPATH_DONE) {
-        switch (pathId) {
-          case DEFIPATH_LAYER: {
-            // We need to peek ahead to see if there is a taper next
-            const char* layer = path->getLayer();
-            int nextId = path->next();
-            if (nextId == DEFIPATH_TAPER) {
-              netR->pathTaper(layer);
-            } else if (nextId == DEFIPATH_TAPERRULE) {
-              netR->pathTaperRule(layer, path->getTaperRule());
-            } else {
-              netR->path(layer);
-              path->prev();  // put back the token
-            }
-            break;
-          }
-
-          case DEFIPATH_VIA: {
-            // We need to peek ahead to see if there is a rotation next
-            const char* viaName = path->getVia();
-            int nextId = path->next();
-            if (nextId == DEFIPATH_VIAROTATION) {
-              netR->pathVia(viaName,
-                            translate_orientation(path->getViaRotation()));
-            } else {
-              netR->pathVia(viaName);
-              path->prev();  // put back the token
-            }
-            break;
-          }
-
-          case DEFIPATH_POINT: {
-            int x;
-            int y;
-            path->getPoint(&x, &y);
-            netR->pathPoint(x, y);
-            break;
-          }
-
-          case DEFIPATH_FLUSHPOINT: {
-            int x;
-            int y;
-            int ext;
-            path->getFlushPoint(&x, &y, &ext);
-            netR->pathPoint(x, y, ext);
-            break;
-          }
-
-          case DEFIPATH_STYLE:
-            UNSUPPORTED("styles are not supported on wires");
-            break;
-
-          case DEFIPATH_RECT: {
-            int deltaX1;
-            int deltaY1;
-            int deltaX2;
-            int deltaY2;
-            path->getViaRect(&deltaX1, &deltaY1, &deltaX2, &deltaY2);
-            netR->pathRect(deltaX1, deltaY1, deltaX2, deltaY2);
-            break;
-          }
-
-          case DEFIPATH_VIRTUALPOINT:
-            UNSUPPORTED("VIRTUAL in net's routing is unsupported");
-            break;
-
-          case DEFIPATH_MASK:
-            netR->pathColor(path->getMask());
-            break;
-
-          case DEFIPATH_VIAMASK:
-            netR->pathViaColor(path->getViaBottomMask(),
-                               path->getViaCutMask(),
-                               path->getViaTopMask());
-            break;
-
-          default:
-            UNSUPPORTED("Unknown construct in net's routing is unsupported");
-            break;
-        }
-      }
-      netR->pathEnd();
-    }
-
-    netR->wireEnd();
-  }
-
-  handle_props(net, netR);
-
-  netR->end();
+int definReader::netCallback(defrCallbackType_e /* unused: type */,
+                             defiNet* net,
+                             defiUserData data)
+{
+  definReader* reader = (definReader*) data;
+  CHECKBLOCK
+  definNet* netR = reader->_netR;
+  if (reader->_mode == defin::FLOORPLAN
+      && reader->_block->findNet(net->name()) == nullptr) {
+    reader->_logger->warn(
+        utl::ODB,
+        275,
+        "skipping undefined net {} encountered in FLOORPLAN DEF",
+        net->name());
+    return PARSE_OK;
+  }
 
-  return PARSE_OK;
+  return translateNet(reader, net, netR);
 }
 
 int definReader::nonDefaultRuleCallback(defrCallbackType_e /* unused: type */,
@@ -1684,181 +1885,116 @@ int definReader::specialNetCallback(defrCallbackType_e /* unused: type */,
         net->name());
     return PARSE_OK;
   }
-  if (net->hasCap()) {
-    UNSUPPORTED("ESTCAP on special net is unsupported");
-  }
-
-  if (net->hasPattern()) {
-    UNSUPPORTED("PATTERN on special net is unsupported");
-  }
-
-  if (net->hasOriginal()) {
-    UNSUPPORTED("ORIGINAL on special net is unsupported");
-  }
-
-  if (net->numShieldNets() > 0) {
-    UNSUPPORTED("SHIELDNET on special net is unsupported");
-  }
-
-  if (net->hasVoltage()) {
-    UNSUPPORTED("VOLTAGE on special net is unsupported");
-  }
-
-  if (net->numPolygons() > 0) {
-    // The db does support polygons but the callback code seems incorrect to me
-    // (ignores layers!).  Delaying support until I can fix it.
-    UNSUPPORTED("polygons in special nets are not supported");
-  }
-
-  if (net->numViaSpecs() > 0) {
-    UNSUPPORTED("VIA in special net is unsupported");
-  }
-
-  snetR->begin(net->name());
-
-  if (net->hasUse()) {
-    snetR->use(net->use());
-  }
 
-  if (net->hasSource()) {
-    snetR->source(net->source());
-  }
+  return translateSpecialNet(reader, net, snetR);
+}
 
-  if (net->hasFixedbump()) {
-    snetR->fixedbump();
-  }
+int definReader::componentsEndCallback(defrCallbackType_e /* unused: type */,
+                                       void* /* unused: v */,
+                                       defiUserData data)
+{
+  definReader* reader = (definReader*) data;
+  return reader->replaySection(definSections::COMPONENTS);
+}
 
-  if (net->hasWeight()) {
-    snetR->weight(net->weight());
-  }
+int definReader::netsEndCallback(defrCallbackType_e /* unused: type */,
+                                 void* /* unused: v */,
+                                 defiUserData data)
+{
+  definReader* reader = (definReader*) data;
+  return reader->replaySection(definSections::NETS);
+}
 
-  for (int i = 0; i < net->numConnections(); ++i) {
-    snetR->connection(net->instance(i), net->pin(i), net->pinIsSynthesized(i));
-  }
+int definReader::specialNetsEndCallback(defrCallbackType_e /* unused: type */,
+                                        void* /* unused: v */,
+                                        defiUserData data)
+{
+  definReader* reader = (definReader*) data;
+  return reader->replaySection(definSections::SPECIALNETS);
+}
 
-  if (net->numRectangles()) {
-    for (int i = 0; i < net->numRectangles(); i++) {
-      snetR->wire(net->rectRouteStatus(i), net->rectRouteStatusShieldName(i));
-      snetR->rect(net->rectName(i),
-                  net->xl(i),
-                  net->yl(i),
-                  net->xh(i),
-                  net->yh(i),
-                  net->rectShapeType(i),
-                  net->rectMask(i));
-      snetR->wireEnd();
+int definReader::replaySection(definSections::Kind kind)
+{
+  definReader* reader = this;
+  for (definSections::Chunk* chunk : sections_->takeSection(kind)) {
+    CHECKBLOCK
+    sections_->wait(chunk);
+    switch (kind) {
+      case definSections::COMPONENTS:
+        chunk->components.replay(this, _componentR);
+        break;
+      case definSections::NETS:
+        chunk->nets.replay(this, _netR);
+        break;
+      case definSections::SPECIALNETS:
+        chunk->snets.replay(this, _snetR);
+        break;
+    }
+    const int status = chunk->status;
+    sections_->release(chunk);
+    if (status != PARSE_OK) {
+      // The chunk's parser has reported the error.
+      return STOP_PARSE;
     }
   }
+  return PARSE_OK;
+}
 
-  for (int i = 0; i < net->numWires(); ++i) {
-    defiWire* wire = net->wire(i);
-    snetR->wire(wire->wireType(), wire->wireShieldNetName());
-
-    for (int j = 0; j < wire->numPaths(); ++j) {
-      defiPath* path = wire->path(j);
-
-      path->initTraverse();
-
-      std::string layerName;
-
-      int pathId;
-      uint next_mask = 0;
-      uint next_via_bottom_mask = 0;
-      uint next_via_cut_mask = 0;
-      uint next_via_top_mask = 0;
-      while ((pathId = path->next()) != DEFIPATH_DONE) {
-        switch (pathId) {
-          case DEFIPATH_LAYER:
-            layerName = path->getLayer();
-            break;
-
-          case DEFIPATH_VIA: {
-            // We need to peek ahead to see if there is a rotation next
-            const char* viaName = path->getVia();
-            int nextId = path->next();
-            if (nextId == DEFIPATH_VIAROTATION) {
-              UNSUPPORTED("Rotated via in special net is unsupported");
-              // TODO: Make this take and store rotation
-              // snetR->pathVia(viaName,
-              //                translate_orientation(path->getViaRotation()));
-            } else if (nextId == DEFIPATH_VIADATA) {
-              int numX, numY, stepX, stepY;
-              path->getViaData(&numX, &numY, &stepX, &stepY);
-              snetR->pathViaArray(viaName, numX, numY, stepX, stepY);
-            } else {
-              snetR->pathVia(viaName,
-                             next_via_bottom_mask,
-                             next_via_cut_mask,
-                             next_via_top_mask);
-              path->prev();  // put back the token
-            }
-            break;
-          }
-
-          case DEFIPATH_WIDTH:
-            assert(!layerName.empty());  // always "layerName routeWidth"
-            snetR->path(layerName.c_str(), path->getWidth());
-            break;
-
-          case DEFIPATH_POINT: {
-            int x;
-            int y;
-            path->getPoint(&x, &y);
-            snetR->pathPoint(x, y, next_mask);
-            break;
-          }
-
-          case DEFIPATH_FLUSHPOINT: {
-            int x;
-            int y;
-            int ext;
-            path->getFlushPoint(&x, &y, &ext);
-            snetR->pathPoint(x, y, ext, next_mask);
-            break;
-          }
-
-          case DEFIPATH_SHAPE:
-            snetR->pathShape(path->getShape());
-            break;
-
-          case DEFIPATH_STYLE:
-            UNSUPPORTED("styles are not supported on wires");
-            break;
-
-          case DEFIPATH_MASK:
-            next_mask = path->getMask();
-            break;
+static definRecorder* chunkRecorder(definSections::Chunk* chunk)
+{
+  switch (chunk->kind) {
+    case definSections::COMPONENTS:
+      return &chunk->components;
+    case definSections::NETS:
+      return &chunk->nets;
+    case definSections::SPECIALNETS:
+      return &chunk->snets;
+  }
+  return nullptr;
+}
 
-          case DEFIPATH_VIAMASK:
-            next_via_bottom_mask = path->getViaBottomMask();
-            next_via_cut_mask = path->getViaCutMask();
-            next_via_top_mask = path->getViaTopMask();
-            break;
+int definReader::chunkStartCallback(defrCallbackType_e /* unused: type */,
+                                    int /* unused: count */,
+                                    defiUserData data)
+{
+  // The chunk's items follow the section start on the same line.
+  definSections::Chunk* chunk = (definSections::Chunk*) data;
+  defrSetNLines(chunk->first_line);
+  return PARSE_OK;
+}
 
-          default:
-            UNSUPPORTED(
-                "Unknown construct in special net's routing is unsupported");
-        }
-        if (pathId != DEFIPATH_MASK) {
-          next_mask = 0;
-        }
-        if (pathId != DEFIPATH_VIAMASK) {
-          next_via_bottom_mask = 0;
-          next_via_cut_mask = 0;
-          next_via_top_mask = 0;
-        }
-      }
-      snetR->pathEnd();
-    }
+int definReader::chunkComponentCallback(defrCallbackType_e /* unused: type */,
+                                        defiComponent* comp,
+                                        defiUserData data)
+{
+  definSections::Chunk* chunk = (definSections::Chunk*) data;
+  return translateComponent(&chunk->components, comp, &chunk->components);
+}
 
-    snetR->wireEnd();
-  }
+int definReader::chunkNetCallback(defrCallbackType_e /* unused: type */,
+                                  defiNet* net,
+                                  defiUserData data)
+{
+  definSections::Chunk* chunk = (definSections::Chunk*) data;
+  return translateNet(&chunk->nets, net, &chunk->nets);
+}
 
-  handle_props(net, snetR);
+int definReader::chunkSpecialNetCallback(defrCallbackType_e /* unused: type */,
+                                         defiNet* net,
+                                         defiUserData data)
+{
+  definSections::Chunk* chunk = (definSections::Chunk*) data;
+  return translateSpecialNet(&chunk->snets, net, &chunk->snets);
+}
 
-  snetR->end();
+void definReader::chunkErrorCallback(defiUserData data, const char* msg)
+{
+  chunkRecorder((definSections::Chunk*) data)->parserError(msg);
+}
 
-  return PARSE_OK;
+void definReader::chunkWarningCallback(defiUserData data, const char* msg)
+{
+  chunkRecorder((definSections::Chunk*) data)->parserWarning(msg);
 }
 
 void definReader::line(int line_num)
@@ -2096,8 +2232,11 @@ bool definReader::createBlock(const char* file)
   }
 
   bool isZipped = hasSuffix(file, ".gz");
+  std::unique_ptr<definSections> sections;
   int res;
-  if (!isZipped) {
+  if (!isZipped && (sections = splitSections(file))) {
+    res = readSections(file, *sections);
+  } else if (!isZipped) {
     FILE* f = fopen(file, "r");
     if (f == nullptr) {
       _logger->warn(utl::ODB, 148, "error: Cannot open DEF file {}", file);
@@ -2131,6 +2270,98 @@ bool definReader::createBlock(const char* file)
   // 1220 return errors() == 0;
 }
 
+// Sections smaller than this are parsed by the main thread.
+constexpr size_t kChunkSize = 256 << 10;
+
+std::unique_ptr<definSections> definReader::splitSections(const char* file)
+{
+  if (_mode != defin::DEFAULT || _db->getThreadCount() < 2) {
+    return nullptr;
+  }
+
+  std::ifstream stream(file, std::ios::binary);
+  if (!stream) {
+    return nullptr;
+  }
+  stream.seekg(0, std::ios::end);
+  std::string text(stream.tellg(), '\0');
+  stream.seekg(0);
+  if (!stream.read(text.data(), text.size())) {
+    return nullptr;
+  }
+
+  auto sections = std::make_unique<definSections>();
+  if (!sections->split(std::move(text), kChunkSize)) {
+    return nullptr;
+  }
+  return sections;
+}
+
+int definReader::readSections(const char* file, definSections& sections)
+{
+  // The main thread parses the rest of the file, so leave it a core.
+  const int threads = std::max(_db->getThreadCount() - 1, 1);
+  sections.start(threads,
+                 [this, file](const std::string& text,
+                              definSections::Chunk& chunk) {
+                   parseChunk(file, text, chunk);
+                 });
+
+  defrSetComponentEndCbk(componentsEndCallback);
+  defrSetNetEndCbk(netsEndCallback);
+  defrSetSNetEndCbk(specialNetsEndCallback);
+
+  const std::string& text = sections.mainText();
+  FILE* f = fmemopen((void*) text.data(), text.size(), "r");
+  if (f == nullptr) {
+    _logger->warn(
+        utl::ODB, 455, "error: Cannot read the split DEF file {}", file);
+    return 1;
+  }
+  sections_ = &sections;
+  const int res
+      = defrRead(f, file, (defiUserData) this, /* case sensitive */ 1);
+  sections_ = nullptr;
+  fclose(f);
+  return res;
+}
+
+// Runs on a worker thread with its own parser state.  Nothing may touch
+// the block here; the callbacks only record what the builders are to do.
+void definReader::parseChunk(const char* file,
+                             const std::string& text,
+                             definSections::Chunk& chunk) const
+{
+  defrInit();
+  defrReset();
+
+  defrInitSession();
+  defrSetContextLogFunction(chunkErrorCallback);
+  defrSetContextWarningLogFunction(chunkWarningCallback);
+  defrSetComponentStartCbk(chunkStartCallback);
+  defrSetNetStartCbk(chunkStartCallback);
+  defrSetSNetStartCbk(chunkStartCallback);
+  defrSetComponentCbk(chunkComponentCallback);
+  defrSetNetCbk(chunkNetCallback);
+  defrSetSNetCbk(chunkSpecialNetCallback);
+  defrSetAddPathToNet();
+
+  chunk.components._continue_on_errors = _continue_on_errors;
+  chunk.nets._continue_on_errors = _continue_on_errors;
+  chunk.snets._continue_on_errors = _continue_on_errors;
+
+  FILE* f = fmemopen((void*) text.data(), text.size(), "r");
+  if (f == nullptr) {
+    chunk.status = 1;
+  } else {
+    chunk.status
+        = defrRead(f, file, (defiUserData) &chunk, /* case sensitive */ 1);
+    fclose(f);
+  }
+
+  defrClear();
+}
+
 bool definReader::replaceWires(const char* file)
 {
   FILE* f = fopen(file, "r");
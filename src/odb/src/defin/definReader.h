@@ -32,7 +32,11 @@
 
 #pragma once
 
+#include <memory>
+#include <string>
+
 #include "definBase.h"
+#include "definSections.h"
 #include "defrReader.hpp"
 #include "odb/odb.h"
 
@@ -87,6 +91,8 @@ class definReader : public definBase
   char hier_delimeter_;
   char left_bus_delimeter_;
   char right_bus_delimeter_;
+  // Chunks of the file being read in parallel, if any
+  definSections* sections_;
 
   void init() override;
   void setLibs(std::vector<dbLib*>& lib_names);
@@ -98,10 +104,28 @@ class definReader : public definBase
   void setLogger(utl::Logger* logger);
 
   bool createBlock(const char* file);
+  std::unique_ptr<definSections> splitSections(const char* file);
+  int readSections(const char* file, definSections& sections);
+  void parseChunk(const char* file,
+                  const std::string& text,
+                  definSections::Chunk& chunk) const;
+  int replaySection(definSections::Kind kind);
   bool replaceWires(const char* file);
   void replaceWires();
   int errors();
 
+  // Translate the Si2 parser objects into calls on the definComponent,
+  // definNet and definSNet interfaces.  The reader and interface are
+  // recorders when parsing a chunk on a worker thread.
+  template <typename READER, typename COMPONENT>
+  static int translateComponent(READER* reader,
+                                defiComponent* comp,
+                                COMPONENT* componentR);
+  template <typename READER, typename NET>
+  static int translateNet(READER* reader, defiNet* net, NET* netR);
+  template <typename READER, typename SNET>
+  static int translateSpecialNet(READER* reader, defiNet* net, SNET* snetR);
+
   // Parser callbacks
   static int blockageCallback(defrCallbackType_e type,
                               defiBlockage* blockage,
@@ -245,6 +269,38 @@ class definReader : public definBase
                          defiVia* via,
                          defiUserData data);
 
+  static int componentsEndCallback(defrCallbackType_e type,
+                                   void* v,
+                                   defiUserData data);
+
+  static int netsEndCallback(defrCallbackType_e type,
+                             void* v,
+                             defiUserData data);
+
+  static int specialNetsEndCallback(defrCallbackType_e type,
+                                    void* v,
+                                    defiUserData data);
+
+  // Parser callbacks for chunks parsed on worker threads
+  static int chunkStartCallback(defrCallbackType_e type,
+                                int count,
+                                defiUserData data);
+
+  static int chunkComponentCallback(defrCallbackType_e type,
+                                    defiComponent* comp,
+                                    defiUserData data);
+
+  static int chunkNetCallback(defrCallbackType_e type,
+                              defiNet* net,
+                              defiUserData data);
+
+  static int chunkSpecialNetCallback(defrCallbackType_e type,
+                                     defiNet* net,
+                                     defiUserData data);
+
+  static void chunkErrorCallback(defiUserData data, const char* msg);
+  static void chunkWarningCallback(defiUserData data, const char* msg);
+
  public:
   definReader(dbDatabase* db,
               utl::Logger* logger,
@@ -0,0 +1,822 @@
+///////////////////////////////////////////////////////////////////////////////
+// BSD 3-Clause License
+//
+// Copyright (c) 2024, The Regents of the University of California
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#include "definRecorder.h"
+
+#include <cstring>
+
+#include "definComponent.h"
+#include "definNet.h"
+#include "definReader.h"
+#include "definSNet.h"
+#include "utl/Logger.h"
+
+namespace odb {
+
+void definRecorder::push(const char* str)
+{
+  if (str == nullptr) {
+    ops_.push_back(-1);
+    return;
+  }
+  ops_.push_back(strings_.size());
+  strings_.append(str);
+  strings_.push_back('\0');
+}
+
+void definRecorder::push(double value)
+{
+  int words[2];
+  static_assert(sizeof(words) == sizeof(value));
+  std::memcpy(words, &value, sizeof(value));
+  ops_.push_back(words[0]);
+  ops_.push_back(words[1]);
+}
+
+const char* definRecorder::Reader::nextString()
+{
+  const int offset = next();
+  if (offset < 0) {
+    return nullptr;
+  }
+  return recorder_.strings_.c_str() + offset;
+}
+
+double definRecorder::Reader::nextDouble()
+{
+  int words[2];
+  words[0] = next();
+  words[1] = next();
+  double value;
+  std::memcpy(&value, words, sizeof(value));
+  return value;
+}
+
+void definRecorder::error(std::string_view msg)
+{
+  push(ERROR);
+  push(std::string(msg).c_str());
+}
+
+void definRecorder::parserError(const char* msg)
+{
+  push(PARSER_ERROR);
+  push(msg);
+}
+
+void definRecorder::parserWarning(const char* msg)
+{
+  push(PARSER_WARNING);
+  push(msg);
+}
+
+bool definRecorder::replayMessage(int op,
+                                  Reader& reader,
+                                  definReader* def_reader) const
+{
+  switch (op) {
+    case ERROR:
+      def_reader->error(reader.nextString());
+      return true;
+    case PARSER_ERROR:
+    case PARSER_WARNING: {
+      // The Si2 parser ends its messages with a newline.
+      std::string msg = reader.nextString();
+      while (!msg.empty() && msg.back() == '\n') {
+        msg.pop_back();
+      }
+      if (op == PARSER_ERROR) {
+        // Not counted as an error: the parser status reports the failure.
+        def_reader->_logger->warn(utl::ODB, 454, "error: {}", msg);
+      } else {
+        def_reader->_logger->warn(utl::ODB, 451, "{}", msg);
+      }
+      return true;
+    }
+    default:
+      return false;
+  }
+}
+
+////////////////////////////////////////////////////////////////////
+//
+// definNetRecorder - Methods
+//
+////////////////////////////////////////////////////////////////////
+
+void definNetRecorder::begin(const char* name)
+{
+  push(BEGIN);
+  push(name);
+}
+
+void definNetRecorder::beginMustjoin(const char* iname, const char* pname)
+{
+  push(MUSTJOIN);
+  push(iname);
+  push(pname);
+}
+
+void definNetRecorder::connection(const char* iname, const char* pname)
+{
+  push(CONNECTION);
+  push(iname);
+  push(pname);
+}
+
+void definNetRecorder::nonDefaultRule(const char* rule)
+{
+  push(NON_DEFAULT_RULE);
+  push(rule);
+}
+
+void definNetRecorder::use(dbSigType type)
+{
+  push(USE);
+  push(type.getValue());
+}
+
+void definNetRecorder::wire(dbWireType type)
+{
+  push(WIRE);
+  push(type.getValue());
+}
+
+void definNetRecorder::path(const char* layer)
+{
+  push(PATH);
+  push(layer);
+}
+
+void definNetRecorder::pathTaper(const char* layer)
+{
+  push(PATH_TAPER);
+  push(layer);
+}
+
+void definNetRecorder::pathTaperRule(const char* layer, const char* rule)
+{
+  push(PATH_TAPER_RULE);
+  push(layer);
+  push(rule);
+}
+
+void definNetRecorder::pathPoint(int x, int y)
+{
+  push(PATH_POINT);
+  push(x);
+  push(y);
+}
+
+void definNetRecorder::pathPoint(int x, int y, int ext)
+{
+  push(PATH_POINT_EXT);
+  push(x);
+  push(y);
+  push(ext);
+}
+
+void definNetRecorder::pathVia(const char* via)
+{
+  push(PATH_VIA);
+  push(via);
+}
+
+void definNetRecorder::pathVia(const char* via, dbOrientType orient)
+{
+  push(PATH_VIA_ORIENT);
+  push(via);
+  push(orient.getValue());
+}
+
+void definNetRecorder::pathRect(int deltaX1,
+                                int deltaY1,
+                                int deltaX2,
+                                int deltaY2)
+{
+  push(PATH_RECT);
+  push(deltaX1);
+  push(deltaY1);
+  push(deltaX2);
+  push(deltaY2);
+}
+
+void definNetRecorder::pathColor(int color)
+{
+  push(PATH_COLOR);
+  push(color);
+}
+
+void definNetRecorder::pathViaColor(int bottom_color,
+                                    int cut_color,
+                                    int top_color)
+{
+  push(PATH_VIA_COLOR);
+  push(bottom_color);
+  push(cut_color);
+  push(top_color);
+}
+
+void definNetRecorder::pathEnd()
+{
+  push(PATH_END);
+}
+
+void definNetRecorder::wireEnd()
+{
+  push(WIRE_END);
+}
+
+void definNetRecorder::source(dbSourceType source)
+{
+  push(SOURCE);
+  push(source.getValue());
+}
+
+void definNetRecorder::weight(int weight)
+{
+  push(WEIGHT);
+  push(weight);
+}
+
+void definNetRecorder::fixedbump()
+{
+  push(FIXEDBUMP);
+}
+
+void definNetRecorder::property(const char* name, const char* value)
+{
+  push(PROPERTY_STRING);
+  push(name);
+  push(value);
+}
+
+void definNetRecorder::property(const char* name, int value)
+{
+  push(PROPERTY_INT);
+  push(name);
+  push(value);
+}
+
+void definNetRecorder::property(const char* name, double value)
+{
+  push(PROPERTY_DOUBLE);
+  push(name);
+  push(value);
+}
+
+void definNetRecorder::end()
+{
+  push(END);
+}
+
+void definNetRecorder::replay(definReader* reader, definNet* net) const
+{
+  Reader in(*this);
+  while (!in.done()) {
+    const int op = in.next();
+    switch (op) {
+      case BEGIN:
+        net->begin(in.nextString());
+        break;
+      case MUSTJOIN: {
+        const char* iname = in.nextString();
+        net->beginMustjoin(iname, in.nextString());
+        break;
+      }
+      case CONNECTION: {
+        const char* iname = in.nextString();
+        net->connection(iname, in.nextString());
+        break;
+      }
+      case NON_DEFAULT_RULE:
+        net->nonDefaultRule(in.nextString());
+        break;
+      case USE:
+        net->use(dbSigType((dbSigType::Value) in.next()));
+        break;
+      case WIRE:
+        net->wire(dbWireType((dbWireType::Value) in.next()));
+        break;
+      case PATH:
+        net->path(in.nextString());
+        break;
+      case PATH_TAPER:
+        net->pathTaper(in.nextString());
+        break;
+      case PATH_TAPER_RULE: {
+        const char* layer = in.nextString();
+        net->pathTaperRule(layer, in.nextString());
+        break;
+      }
+      case PATH_POINT: {
+        const int x = in.next();
+        net->pathPoint(x, in.next());
+        break;
+      }
+      case PATH_POINT_EXT: {
+        const int x = in.next();
+        const int y = in.next();
+        net->pathPoint(x, y, in.next());
+        break;
+      }
+      case PATH_VIA:
+        net->pathVia(in.nextString());
+        break;
+      case PATH_VIA_ORIENT: {
+        const char* via = in.nextString();
+        net->pathVia(via, dbOrientType((dbOrientType::Value) in.next()));
+        break;
+      }
+      case PATH_RECT: {
+        const int x1 = in.next();
+        const int y1 = in.next();
+        const int x2 = in.next();
+        net->pathRect(x1, y1, x2, in.next());
+        break;
+      }
+      case PATH_COLOR:
+        net->pathColor(in.next());
+        break;
+      case PATH_VIA_COLOR: {
+        const int bottom = in.next();
+        const int cut = in.next();
+        net->pathViaColor(bottom, cut, in.next());
+        break;
+      }
+      case PATH_END:
+        net->pathEnd();
+        break;
+      case WIRE_END:
+        net->wireEnd();
+        break;
+      case SOURCE:
+        net->source(dbSourceType((dbSourceType::Value) in.next()));
+        break;
+      case WEIGHT:
+        net->weight(in.next());
+        break;
+      case FIXEDBUMP:
+        net->fixedbump();
+        break;
+      case PROPERTY_STRING: {
+        const char* name = in.nextString();
+        net->property(name, in.nextString());
+        break;
+      }
+      case PROPERTY_INT: {
+        const char* name = in.nextString();
+        net->property(name, in.next());
+        break;
+      }
+      case PROPERTY_DOUBLE: {
+        const char* name = in.nextString();
+        net->property(name, in.nextDouble());
+        break;
+      }
+      case END:
+        net->end();
+        break;
+      default:
+        replayMessage(op, in, reader);
+        break;
+    }
+  }
+}
+
+////////////////////////////////////////////////////////////////////
+//
+// definSNetRecorder - Methods
+//
+////////////////////////////////////////////////////////////////////
+
+void definSNetRecorder::begin(const char* name)
+{
+  push(BEGIN);
+  push(name);
+}
+
+void definSNetRecorder::connection(const char* iname,
+                                   const char* pname,
+                                   bool synthesized)
+{
+  push(CONNECTION);
+  push(iname);
+  push(pname);
+  push(synthesized);
+}
+
+void definSNetRecorder::use(dbSigType type)
+{
+  push(USE);
+  push(type.getValue());
+}
+
+void definSNetRecorder::rect(const char* layer,
+                             int x1,
+                             int y1,
+                             int x2,
+                             int y2,
+                             const char* type,
+                             uint mask)
+{
+  push(RECT);
+  push(layer);
+  push(x1);
+  push(y1);
+  push(x2);
+  push(y2);
+  push(type);
+  push((int) mask);
+}
+
+void definSNetRecorder::wire(dbWireType type, const char* shield)
+{
+  push(WIRE);
+  push(type.getValue());
+  push(shield);
+}
+
+void definSNetRecorder::path(const char* layer, int width)
+{
+  push(PATH);
+  push(layer);
+  push(width);
+}
+
+void definSNetRecorder::pathShape(const char* type)
+{
+  push(PATH_SHAPE);
+  push(type);
+}
+
+void definSNetRecorder::pathPoint(int x, int y, uint mask)
+{
+  push(PATH_POINT);
+  push(x);
+  push(y);
+  push((int) mask);
+}
+
+void definSNetRecorder::pathPoint(int x, int y, int ext, uint mask)
+{
+  push(PATH_POINT_EXT);
+  push(x);
+  push(y);
+  push(ext);
+  push((int) mask);
+}
+
+void definSNetRecorder::pathVia(const char* via,
+                                uint bottom_mask,
+                                uint cut_mask,
+                                uint top_mask)
+{
+  push(PATH_VIA);
+  push(via);
+  push((int) bottom_mask);
+  push((int) cut_mask);
+  push((int) top_mask);
+}
+
+void definSNetRecorder::pathViaArray(const char* via,
+                                     int numX,
+                                     int numY,
+                                     int stepX,
+                                     int stepY)
+{
+  push(PATH_VIA_ARRAY);
+  push(via);
+  push(numX);
+  push(numY);
+  push(stepX);
+  push(stepY);
+}
+
+void definSNetRecorder::pathEnd()
+{
+  push(PATH_END);
+}
+
+void definSNetRecorder::wireEnd()
+{
+  push(WIRE_END);
+}
+
+void definSNetRecorder::source(dbSourceType source)
+{
+  push(SOURCE);
+  push(source.getValue());
+}
+
+void definSNetRecorder::weight(int weight)
+{
+  push(WEIGHT);
+  push(weight);
+}
+
+void definSNetRecorder::fixedbump()
+{
+  push(FIXEDBUMP);
+}
+
+void definSNetRecorder::property(const char* name, const char* value)
+{
+  push(PROPERTY_STRING);
+  push(name);
+  push(value);
+}
+
+void definSNetRecorder::property(const char* name, int value)
+{
+  push(PROPERTY_INT);
+  push(name);
+  push(value);
+}
+
+void definSNetRecorder::property(const char* name, double value)
+{
+  push(PROPERTY_DOUBLE);
+  push(name);
+  push(value);
+}
+
+void definSNetRecorder::end()
+{
+  push(END);
+}
+
+void definSNetRecorder::replay(definReader* reader, definSNet* snet) const
+{
+  Reader in(*this);
+  while (!in.done()) {
+    const int op = in.next();
+    switch (op) {
+      case BEGIN:
+        snet->begin(in.nextString());
+        break;
+      case CONNECTION: {
+        const char* iname = in.nextString();
+        const char* pname = in.nextString();
+        snet->connection(iname, pname, in.next());
+        break;
+      }
+      case USE:
+        snet->use(dbSigType((dbSigType::Value) in.next()));
+        break;
+      case RECT: {
+        const char* layer = in.nextString();
+        const int x1 = in.next();
+        const int y1 = in.next();
+        const int x2 = in.next();
+        const int y2 = in.next();
+        const char* type = in.nextString();
+        snet->rect(layer, x1, y1, x2, y2, type, in.next());
+        break;
+      }
+      case WIRE: {
+        const dbWireType type((dbWireType::Value) in.next());
+        snet->wire(type, in.nextString());
+        break;
+      }
+      case PATH: {
+        const char* layer = in.nextString();
+        snet->path(layer, in.next());
+        break;
+      }
+      case PATH_SHAPE:
+        snet->pathShape(in.nextString());
+        break;
+      case PATH_POINT: {
+        const int x = in.next();
+        const int y = in.next();
+        snet->pathPoint(x, y, (uint) in.next());
+        break;
+      }
+      case PATH_POINT_EXT: {
+        const int x = in.next();
+        const int y = in.next();
+        const int ext = in.next();
+        snet->pathPoint(x, y, ext, (uint) in.next());
+        break;
+      }
+      case PATH_VIA: {
+        const char* via = in.nextString();
+        const uint bottom = in.next();
+        const uint cut = in.next();
+        snet->pathVia(via, bottom, cut, in.next());
+        break;
+      }
+      case PATH_VIA_ARRAY: {
+        const char* via = in.nextString();
+        const int num_x = in.next();
+        const int num_y = in.next();
+        const int step_x = in.next();
+        snet->pathViaArray(via, num_x, num_y, step_x, in.next());
+        break;
+      }
+      case PATH_END:
+        snet->pathEnd();
+        break;
+      case WIRE_END:
+        snet->wireEnd();
+        break;
+      case SOURCE:
+        snet->source(dbSourceType((dbSourceType::Value) in.next()));
+        break;
+      case WEIGHT:
+        snet->weight(in.next());
+        break;
+      case FIXEDBUMP:
+        snet->fixedbump();
+        break;
+      case PROPERTY_STRING: {
+        const char* name = in.nextString();
+        snet->property(name, in.nextString());
+        break;
+      }
+      case PROPERTY_INT: {
+        const char* name = in.nextString();
+        snet->property(name, in.next());
+        break;
+      }
+      case PROPERTY_DOUBLE: {
+        const char* name = in.nextString();
+        snet->property(name, in.nextDouble());
+        break;
+      }
+      case END:
+        snet->end();
+        break;
+      default:
+        replayMessage(op, in, reader);
+        break;
+    }
+  }
+}
+
+////////////////////////////////////////////////////////////////////
+//
+// definComponentRecorder - Methods
+//
+////////////////////////////////////////////////////////////////////
+
+void definComponentRecorder::begin(const char* name, const char* cell)
+{
+  push(BEGIN);
+  push(name);
+  push(cell);
+}
+
+void definComponentRecorder::placement(int status, int x, int y, int orient)
+{
+  push(PLACEMENT);
+  push(status);
+  push(x);
+  push(y);
+  push(orient);
+}
+
+void definComponentRecorder::region(const char* region)
+{
+  push(REGION);
+  push(region);
+}
+
+void definComponentRecorder::halo(int left, int bottom, int right, int top)
+{
+  push(HALO);
+  push(left);
+  push(bottom);
+  push(right);
+  push(top);
+}
+
+void definComponentRecorder::source(dbSourceType source)
+{
+  push(SOURCE);
+  push(source.getValue());
+}
+
+void definComponentRecorder::weight(int weight)
+{
+  push(WEIGHT);
+  push(weight);
+}
+
+void definComponentRecorder::property(const char* name, const char* value)
+{
+  push(PROPERTY_STRING);
+  push(name);
+  push(value);
+}
+
+void definComponentRecorder::property(const char* name, int value)
+{
+  push(PROPERTY_INT);
+  push(name);
+  push(value);
+}
+
+void definComponentRecorder::property(const char* name, double value)
+{
+  push(PROPERTY_DOUBLE);
+  push(name);
+  push(value);
+}
+
+void definComponentRecorder::end()
+{
+  push(END);
+}
+
+void definComponentRecorder::replay(definReader* reader,
+                                    definComponent* component) const
+{
+  Reader in(*this);
+  while (!in.done()) {
+    const int op = in.next();
+    switch (op) {
+      case BEGIN: {
+        const char* name = in.nextString();
+        component->begin(name, in.nextString());
+        break;
+      }
+      case PLACEMENT: {
+        const int status = in.next();
+        const int x = in.next();
+        const int y = in.next();
+        component->placement(status, x, y, in.next());
+        break;
+      }
+      case REGION:
+        component->region(in.nextString());
+        break;
+      case HALO: {
+        const int left = in.next();
+        const int bottom = in.next();
+        const int right = in.next();
+        component->halo(left, bottom, right, in.next());
+        break;
+      }
+      case SOURCE:
+        component->source(dbSourceType((dbSourceType::Value) in.next()));
+        break;
+      case WEIGHT:
+        component->weight(in.next());
+        break;
+      case PROPERTY_STRING: {
+        const char* name = in.nextString();
+        component->property(name, in.nextString());
+        break;
+      }
+      case PROPERTY_INT: {
+        const char* name = in.nextString();
+        component->property(name, in.next());
+        break;
+      }
+      case PROPERTY_DOUBLE: {
+        const char* name = in.nextString();
+        component->property(name, in.nextDouble());
+        break;
+      }
+      case END:
+        component->end();
+        break;
+      default:
+        replayMessage(op, in, reader);
+        break;
+    }
+  }
+}
+
+}  // namespace odb
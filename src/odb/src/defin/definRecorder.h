@@ -0,0 +1,216 @@
+///////////////////////////////////////////////////////////////////////////////
+// BSD 3-Clause License
+//
+// Copyright (c) 2024, The Regents of the University of California
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "odb/dbTypes.h"
+
+namespace odb {
+
+class definComponent;
+class definNet;
+class definReader;
+class definSNet;
+
+//
+// definRecorder - Records the calls a parser callback makes on a definNet,
+// definSNet or definComponent so they can be replayed into the block later,
+// possibly from another thread. The recorders have the same interface as
+// the objects they stand in for so the callbacks can be written once.
+//
+class definRecorder
+{
+ public:
+  bool _continue_on_errors = false;
+
+  // Same as definReader::error
+  void error(std::string_view msg);
+
+  // Messages from the Si2 parser
+  void parserError(const char* msg);
+  void parserWarning(const char* msg);
+
+  bool empty() const { return ops_.empty(); }
+
+ protected:
+  enum Op
+  {
+    ERROR,
+    PARSER_ERROR,
+    PARSER_WARNING,
+    BEGIN,
+    END,
+    USE,
+    SOURCE,
+    WEIGHT,
+    FIXEDBUMP,
+    NON_DEFAULT_RULE,
+    CONNECTION,
+    MUSTJOIN,
+    REGION,
+    HALO,
+    PLACEMENT,
+    WIRE,
+    WIRE_END,
+    PATH,
+    PATH_TAPER,
+    PATH_TAPER_RULE,
+    PATH_SHAPE,
+    PATH_POINT,
+    PATH_POINT_EXT,
+    PATH_VIA,
+    PATH_VIA_ORIENT,
+    PATH_VIA_ARRAY,
+    PATH_RECT,
+    PATH_COLOR,
+    PATH_VIA_COLOR,
+    PATH_END,
+    RECT,
+    PROPERTY_STRING,
+    PROPERTY_INT,
+    PROPERTY_DOUBLE
+  };
+
+  // Cursor over the recorded calls
+  class Reader
+  {
+   public:
+    explicit Reader(const definRecorder& recorder) : recorder_(recorder) {}
+    bool done() const { return pos_ == recorder_.ops_.size(); }
+    int next() { return recorder_.ops_[pos_++]; }
+    const char* nextString();
+    double nextDouble();
+
+   private:
+    const definRecorder& recorder_;
+    size_t pos_ = 0;
+  };
+
+  void push(Op op) { ops_.push_back(op); }
+  void push(int value) { ops_.push_back(value); }
+  void push(const char* str);
+  void push(double value);
+
+  // Replays the messages and errors; returns false for any other op.
+  bool replayMessage(int op, Reader& reader, definReader* def_reader) const;
+
+  std::vector<int> ops_;
+  std::string strings_;
+};
+
+class definNetRecorder : public definRecorder
+{
+ public:
+  void begin(const char* name);
+  void beginMustjoin(const char* iname, const char* pname);
+  void connection(const char* iname, const char* pname);
+  void nonDefaultRule(const char* rule);
+  void use(dbSigType type);
+  void wire(dbWireType type);
+  void path(const char* layer);
+  void pathTaper(const char* layer);
+  void pathTaperRule(const char* layer, const char* rule);
+  void pathPoint(int x, int y);
+  void pathPoint(int x, int y, int ext);
+  void pathVia(const char* via);
+  void pathVia(const char* via, dbOrientType orient);
+  void pathRect(int deltaX1, int deltaY1, int deltaX2, int deltaY2);
+  void pathColor(int color);
+  void pathViaColor(int bottom_color, int cut_color, int top_color);
+  void pathEnd();
+  void wireEnd();
+  void source(dbSourceType source);
+  void weight(int weight);
+  void fixedbump();
+  void property(const char* name, const char* value);
+  void property(const char* name, int value);
+  void property(const char* name, double value);
+  void end();
+
+  void replay(definReader* reader, definNet* net) const;
+};
+
+class definSNetRecorder : public definRecorder
+{
+ public:
+  void begin(const char* name);
+  void connection(const char* iname, const char* pname, bool synthesized);
+  void use(dbSigType type);
+  void rect(const char* layer,
+            int x1,
+            int y1,
+            int x2,
+            int y2,
+            const char* type,
+            uint mask);
+  void wire(dbWireType type, const char* shield);
+  void path(const char* layer, int width);
+  void pathShape(const char* type);
+  void pathPoint(int x, int y, uint mask);
+  void pathPoint(int x, int y, int ext, uint mask);
+  void pathVia(const char* via, uint bottom_mask, uint cut_mask, uint top_mask);
+  void pathViaArray(const char* via, int numX, int numY, int stepX, int stepY);
+  void pathEnd();
+  void wireEnd();
+  void source(dbSourceType source);
+  void weight(int weight);
+  void fixedbump();
+  void property(const char* name, const char* value);
+  void property(const char* name, int value);
+  void property(const char* name, double value);
+  void end();
+
+  void replay(definReader* reader, definSNet* snet) const;
+};
+
+class definComponentRecorder : public definRecorder
+{
+ public:
+  void begin(const char* name, const char* cell);
+  void placement(int status, int x, int y, int orient);
+  void region(const char* region);
+  void halo(int left, int bottom, int right, int top);
+  void source(dbSourceType source);
+  void weight(int weight);
+  void property(const char* name, const char* value);
+  void property(const char* name, int value);
+  void property(const char* name, double value);
+  void end();
+
+  void replay(definReader* reader, definComponent* component) const;
+};
+
+}  // namespace odb
@@ -0,0 +1,363 @@
+///////////////////////////////////////////////////////////////////////////////
+// BSD 3-Clause License
+//
+// Copyright (c) 2024, The Regents of the University of California
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#include "definSections.h"
+
+#include <strings.h>
+
+#include <algorithm>
+#include <utility>
+
+namespace odb {
+
+namespace {
+
+// Splits text into tokens the way the Si2 DEF lexer does: tokens are
+// separated by blanks, a token starting with '"' runs to the closing quote
+// and a token starting with '#' comments out the rest of the line.
+class Scanner
+{
+ public:
+  explicit Scanner(std::string_view text) : text_(text) {}
+
+  bool next(std::string_view& token);
+  bool skipPast(char c);
+
+  // Offset of the last token and the line it is on
+  size_t begin() const { return begin_; }
+  int line() const { return line_; }
+  size_t pos() const { return pos_; }
+
+ private:
+  std::string_view text_;
+  size_t pos_ = 0;
+  size_t begin_ = 0;
+  int line_ = 1;
+};
+
+bool isBlank(char c)
+{
+  return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+bool Scanner::next(std::string_view& token)
+{
+  for (;;) {
+    while (pos_ < text_.size() && isBlank(text_[pos_])) {
+      if (text_[pos_] == '\n') {
+        ++line_;
+      }
+      ++pos_;
+    }
+    if (pos_ == text_.size()) {
+      return false;
+    }
+
+    begin_ = pos_;
+    if (text_[pos_] == '"') {
+      for (++pos_; pos_ < text_.size() && text_[pos_] != '"'; ++pos_) {
+        if (text_[pos_] == '\\') {
+          ++pos_;
+        }
+        if (pos_ < text_.size() && text_[pos_] == '\n') {
+          ++line_;
+        }
+      }
+      if (pos_ >= text_.size()) {
+        return false;
+      }
+      ++pos_;
+    } else if (text_[pos_] == '#') {
+      while (pos_ < text_.size() && text_[pos_] != '\n') {
+        ++pos_;
+      }
+      continue;
+    } else {
+      while (pos_ < text_.size() && !isBlank(text_[pos_])) {
+        ++pos_;
+      }
+    }
+    token = text_.substr(begin_, pos_ - begin_);
+    return true;
+  }
+}
+
+bool Scanner::skipPast(char c)
+{
+  while (pos_ < text_.size() && text_[pos_] != c) {
+    if (text_[pos_] == '\n') {
+      ++line_;
+    }
+    ++pos_;
+  }
+  if (pos_ == text_.size()) {
+    return false;
+  }
+  ++pos_;
+  return true;
+}
+
+bool is(std::string_view token, const char* keyword)
+{
+  return token.size() == strlen(keyword)
+         && strncasecmp(token.data(), keyword, token.size()) == 0;
+}
+
+const char* keyword(definSections::Kind kind)
+{
+  switch (kind) {
+    case definSections::COMPONENTS:
+      return "COMPONENTS";
+    case definSections::NETS:
+      return "NETS";
+    case definSections::SPECIALNETS:
+      return "SPECIALNETS";
+  }
+  return "";
+}
+
+}  // namespace
+
+bool definSections::split(std::string text, size_t chunk_size)
+{
+  text_ = std::move(text);
+  main_text_.clear();
+  header_.clear();
+  sections_.clear();
+  next_section_ = 0;
+
+  Scanner scanner(text_);
+  std::string_view token;
+  size_t copied = 0;
+  size_t split_bytes = 0;
+
+  // Copies the tokens of a statement to the chunk header.
+  auto copyStatement = [&](const char* end_keyword) {
+    header_.append(token).push_back(' ');
+    std::string_view prev;
+    while (scanner.next(token)) {
+      if (token.find('\n') != std::string_view::npos) {
+        return false;
+      }
+      header_.append(token).push_back(' ');
+      if (end_keyword ? is(prev, "END") && is(token, end_keyword)
+                      : token == ";") {
+        return true;
+      }
+      prev = token;
+    }
+    return false;
+  };
+
+  while (scanner.next(token)) {
+    if (token[0] == '&' || is(token, "BEGINEXT")) {
+      // Aliases and extensions are not worth handling here.
+      return false;
+    }
+    if (is(token, "HISTORY")) {
+      // History text is not tokenized
+      if (!scanner.skipPast(';')) {
+        return false;
+      }
+      continue;
+    }
+    if (is(token, "END")) {
+      if (!scanner.next(token)) {
+        return false;
+      }
+      if (is(token, "DESIGN")) {
+        break;
+      }
+      continue;
+    }
+    if (is(token, "VERSION") || is(token, "DESIGN") || is(token, "DIVIDERCHAR")
+        || is(token, "BUSBITCHARS") || is(token, "NAMESCASESENSITIVE")) {
+      if (!copyStatement(nullptr)) {
+        return false;
+      }
+      continue;
+    }
+    if (is(token, "PROPERTYDEFINITIONS")) {
+      // Needed to type the properties of the objects in the chunks
+      if (!copyStatement("PROPERTYDEFINITIONS")) {
+        return false;
+      }
+      continue;
+    }
+
+    Kind kind;
+    if (is(token, "COMPONENTS")) {
+      kind = COMPONENTS;
+    } else if (is(token, "NETS")) {
+      kind = NETS;
+    } else if (is(token, "SPECIALNETS")) {
+      kind = SPECIALNETS;
+    } else {
+      while (token != ";") {
+        if (!scanner.next(token)) {
+          return false;
+        }
+      }
+      continue;
+    }
+
+    // Section start: KEYWORD count ;
+    if (!scanner.next(token) || !scanner.next(token) || token != ";") {
+      return false;
+    }
+    const size_t body_begin = scanner.pos();
+    Section& section = sections_.emplace_back();
+    section.kind = kind;
+    Chunk* chunk = nullptr;
+    for (;;) {
+      if (!scanner.next(token)) {
+        return false;
+      }
+      if (token == "-") {
+        if (chunk == nullptr || scanner.begin() - chunk->begin >= chunk_size) {
+          if (chunk) {
+            chunk->end = scanner.begin();
+          }
+          chunk = section.chunks.emplace_back(std::make_unique<Chunk>()).get();
+          chunk->kind = kind;
+          chunk->begin = scanner.begin();
+          chunk->first_line = scanner.line();
+        }
+        do {
+          if (!scanner.next(token)) {
+            return false;
+          }
+        } while (token != ";");
+        continue;
+      }
+      if (!is(token, "END")) {
+        return false;
+      }
+      const size_t body_end = scanner.begin();
+      if (!scanner.next(token) || !is(token, keyword(kind))) {
+        return false;
+      }
+      if (chunk) {
+        chunk->end = body_end;
+      }
+
+      // Leave only the newlines of the body in the main text.
+      main_text_.append(text_, copied, body_begin - copied);
+      main_text_.append(
+          std::count(text_.begin() + body_begin, text_.begin() + body_end, '\n'),
+          '\n');
+      copied = body_end;
+      split_bytes += body_end - body_begin;
+      break;
+    }
+  }
+  main_text_.append(text_, copied);
+
+  for (Section& section : sections_) {
+    for (auto& chunk : section.chunks) {
+      queue_.push_back(chunk.get());
+    }
+  }
+
+  // A single chunk would only add overhead.
+  return split_bytes > chunk_size;
+}
+
+std::string definSections::chunkText(const Chunk& chunk) const
+{
+  // Keep the chunk's items on the line of the section start so the parser's
+  // line count can be set to the chunk's line in the file.
+  const char* name = keyword(chunk.kind);
+  std::string text = header_;
+  text.append(name).append(" 0 ; ");
+  text.append(text_, chunk.begin, chunk.end - chunk.begin);
+  text.append("\nEND ").append(name).append("\nEND DESIGN\n");
+  return text;
+}
+
+void definSections::start(int threads, ParseFunction parse)
+{
+  parse_ = std::move(parse);
+  threads = std::clamp(threads, 1, static_cast<int>(queue_.size()));
+  for (int i = 0; i < threads; ++i) {
+    workers_.emplace_back([this] { work(); });
+  }
+}
+
+void definSections::work()
+{
+  for (size_t i = next_++; i < queue_.size() && !cancel_; i = next_++) {
+    Chunk* chunk = queue_[i];
+    parse_(chunkText(*chunk), *chunk);
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      chunk->parsed = true;
+    }
+    parsed_.notify_all();
+  }
+}
+
+std::vector<definSections::Chunk*> definSections::takeSection(Kind kind)
+{
+  std::vector<Chunk*> chunks;
+  if (next_section_ == sections_.size()
+      || sections_[next_section_].kind != kind) {
+    return chunks;
+  }
+  for (auto& chunk : sections_[next_section_++].chunks) {
+    chunks.push_back(chunk.get());
+  }
+  return chunks;
+}
+
+void definSections::wait(Chunk* chunk)
+{
+  std::unique_lock<std::mutex> lock(mutex_);
+  parsed_.wait(lock, [chunk] { return chunk->parsed; });
+}
+
+void definSections::release(Chunk* chunk)
+{
+  chunk->components = definComponentRecorder();
+  chunk->nets = definNetRecorder();
+  chunk->snets = definSNetRecorder();
+}
+
+definSections::~definSections()
+{
+  cancel_ = true;
+  for (std::thread& worker : workers_) {
+    worker.join();
+  }
+}
+
+}  // namespace odb
@@ -0,0 +1,136 @@
+///////////////////////////////////////////////////////////////////////////////
+// BSD 3-Clause License
+//
+// Copyright (c) 2024, The Regents of the University of California
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "definRecorder.h"
+
+namespace odb {
+
+//
+// definSections - Splits the COMPONENTS, NETS and SPECIALNETS sections of a
+// DEF file into chunks that are parsed on worker threads while the main
+// thread parses the rest of the file.
+//
+// The main text is the file with the bodies of those sections blanked out
+// (newlines are kept so parser messages report the right line). When the
+// main parser reaches the end of one of the sections the reader takes its
+// chunks in file order and replays their recordings into the block, which
+// keeps all database edits on the main thread and in file order.
+//
+class definSections
+{
+ public:
+  enum Kind
+  {
+    COMPONENTS,
+    NETS,
+    SPECIALNETS
+  };
+
+  struct Chunk
+  {
+    Kind kind;
+    // Byte range of the chunk's items in the file and the line it starts on
+    size_t begin;
+    size_t end;
+    int first_line;
+
+    // Filled in by the parse function
+    definComponentRecorder components;
+    definNetRecorder nets;
+    definSNetRecorder snets;
+    int status = 0;
+
+    bool parsed = false;
+  };
+
+  using ParseFunction = std::function<void(const std::string& text, Chunk&)>;
+
+  // Returns false if the file is not worth splitting or has constructs
+  // (aliases, extensions) that can't be split safely.
+  bool split(std::string text, size_t chunk_size);
+
+  const std::string& mainText() const { return main_text_; }
+
+  // Starts parsing the chunks on threads.  Each chunk is parsed from a small
+  // DEF text holding the file's header statements, the section start and
+  // the chunk's items.
+  void start(int threads, ParseFunction parse);
+
+  // Chunks of the next section of this kind, in file order.
+  std::vector<Chunk*> takeSection(Kind kind);
+
+  // Waits until the chunk is parsed.
+  void wait(Chunk* chunk);
+
+  // Drops a replayed chunk's recordings.
+  void release(Chunk* chunk);
+
+  ~definSections();
+
+ private:
+  struct Section
+  {
+    Kind kind;
+    std::vector<std::unique_ptr<Chunk>> chunks;
+  };
+
+  void work();
+  std::string chunkText(const Chunk& chunk) const;
+
+  std::string text_;
+  std::string main_text_;
+  std::string header_;
+  std::vector<Section> sections_;
+  size_t next_section_ = 0;
+  std::vector<Chunk*> queue_;
+
+  ParseFunction parse_;
+  std::vector<std::thread> workers_;
+  std::atomic<size_t> next_ = 0;
+  std::atomic_bool cancel_ = false;
+  std::mutex mutex_;
+  std::condition_variable parsed_;
+};
+
+}  // namespace odb
@@ -35,11 +35,16 @@
 #include <stdio.h>
 #include <sys/stat.h>
 
+#include <algorithm>
+#include <atomic>
 #include <cstdint>
+#include <cstdlib>
 #include <limits>
 #include <optional>
 #include <set>
 #include <string>
+#include <thread>
+#include <vector>
 
 #include "odb/db.h"
 #include "odb/dbMap.h"
@@ -62,6 +67,9 @@ std::string getPinName(dbITerm* iterm)
 
 static const int max_name_length = 256;
 
+// Nets formatted per buffer when writing nets on several threads
+static const size_t nets_per_buffer = 512;
+
 template <typename T>
 std::vector<T*> sortedSet(dbSet<T>& to_sort)
 {
@@ -1447,33 +1455,94 @@ void defout_impl::writeNets(dbBlock* block)
   if (snet_cnt > 0) {
     fprintf(_out, "SPECIALNETS %d ;\n", snet_cnt);
 
+    std::vector<dbNet*> snets;
+    snets.reserve(snet_cnt);
     for (dbNet* net : sorted_nets) {
       if (_select_net_map && !(*_select_net_map)[net]) {
         continue;
       }
       if (net->isSpecial()) {
-        writeSNet(net);
+        snets.push_back(net);
       }
     }
+    writeNetList(block, snets, &defout_impl::writeSNet);
 
     fprintf(_out, "END SPECIALNETS\n");
   }
 
   fprintf(_out, "NETS %d ;\n", net_cnt);
 
+  std::vector<dbNet*> regular_nets;
+  regular_nets.reserve(net_cnt);
   for (dbNet* net : sorted_nets) {
     if (_select_net_map && !(*_select_net_map)[net]) {
       continue;
     }
 
     if (regular_net[net] == 1) {
-      writeNet(net);
+      regular_nets.push_back(net);
     }
   }
+  writeNetList(block, regular_nets, &defout_impl::writeNet);
 
   fprintf(_out, "END NETS\n");
 }
 
+void defout_impl::writeNetList(dbBlock* block,
+                               const std::vector<dbNet*>& nets,
+                               void (defout_impl::*write_net)(dbNet*))
+{
+  const size_t num_buffers
+      = (nets.size() + nets_per_buffer - 1) / nets_per_buffer;
+  const int num_threads = std::min<size_t>(
+      std::max(block->getDb()->getThreadCount(), 1), num_buffers);
+  if (num_threads <= 1) {
+    for (dbNet* net : nets) {
+      (this->*write_net)(net);
+    }
+    return;
+  }
+
+  // Each run of nets is formatted by a copy of this writer into its own
+  // memory stream.  The streams are written out in order so the file is the
+  // same whatever the thread count.
+  std::vector<FILE*> buffers(num_buffers);
+  std::vector<char*> data(num_buffers);
+  std::vector<size_t> sizes(num_buffers);
+  for (size_t i = 0; i < num_buffers; ++i) {
+    buffers[i] = open_memstream(&data[i], &sizes[i]);
+    if (buffers[i] == nullptr) {
+      _logger->error(utl::ODB, 452, "Cannot allocate a DEF output buffer");
+    }
+  }
+
+  std::atomic<size_t> next = 0;
+  auto work = [&]() {
+    defout_impl writer(*this);
+    for (size_t i = next++; i < num_buffers; i = next++) {
+      writer._out = buffers[i];
+      const size_t end = std::min((i + 1) * nets_per_buffer, nets.size());
+      for (size_t n = i * nets_per_buffer; n < end; ++n) {
+        (writer.*write_net)(nets[n]);
+      }
+    }
+  };
+  std::vector<std::thread> workers;
+  workers.reserve(num_threads);
+  for (int i = 0; i < num_threads; ++i) {
+    workers.emplace_back(work);
+  }
+  for (std::thread& worker : workers) {
+    worker.join();
+  }
+
+  for (size_t i = 0; i < num_buffers; ++i) {
+    fclose(buffers[i]);
+    fwrite(data[i], 1, sizes[i], _out);
+    free(data[i]);
+  }
+}
+
 void defout_impl::writeSNet(dbNet* net)
 {
   dbSet<dbITerm> iterms = net->getITerms();
@@ -35,6 +35,7 @@
 #include <list>
 #include <map>
 #include <string>
+#include <vector>
 
 #include "odb/db.h"
 #include "odb/dbMap.h"
@@ -106,6 +107,9 @@ class defout_impl
   void writeBlockages(dbBlock* block);
   void writeFills(dbBlock* block);
   void writeNets(dbBlock* block);
+  void writeNetList(dbBlock* block,
+                    const std::vector<dbNet*>& nets,
+                    void (defout_impl::*write_net)(dbNet*));
   void writeNet(dbNet* net);
   void writeSNet(dbNet* net);
   void writeWire(dbWire* wire);
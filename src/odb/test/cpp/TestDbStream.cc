@@ -0,0 +1,335 @@
+#include <chrono>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "helper.h"
+#include "odb/db.h"
+#include "odb/dbStream.h"
+#include "odb/dbWireCodec.h"
+#include "utl/Logger.h"
+
+namespace odb {
+namespace {
+
+class OdbStreamTest : public ::testing::Test
+{
+ protected:
+  void SetUp() override
+  {
+    db_ = createSimpleDB();
+    db_->setLogger(&logger_);
+    block_ = db_->getChip()->getBlock();
+  }
+
+  void TearDown() override { dbDatabase::destroy(db_); }
+
+  // Add num_nets two-pin nets, each with a short routed wire.
+  void populate(int num_nets)
+  {
+    dbTech* tech = db_->getTech();
+    dbTechLayer* m1 = dbTechLayer::create(tech, "M1", dbTechLayerType::ROUTING);
+    dbMaster* and2 = db_->findLib("lib1")->findMaster("and2");
+    for (int i = 0; i < num_nets; ++i) {
+      const std::string suffix = std::to_string(i);
+      dbInst* inst = dbInst::create(block_, and2, ("i" + suffix).c_str());
+      inst->setLocation(i * 1000, (i % 100) * 1000);
+      inst->setPlacementStatus(dbPlacementStatus::PLACED);
+      dbNet* net = dbNet::create(block_, ("n" + suffix).c_str());
+      inst->findITerm("o")->connect(net);
+
+      dbWireEncoder encoder;
+      encoder.begin(dbWire::create(net));
+      encoder.newPath(m1, dbWireType::ROUTED);
+      encoder.addPoint(i * 10, 0);
+      encoder.addPoint(i * 10, 500);
+      encoder.addPoint(i * 10 + 300, 500);
+      encoder.end();
+    }
+  }
+
+  utl::Logger logger_;
+  dbDatabase* db_;
+  dbBlock* block_;
+};
+
+TEST_F(OdbStreamTest, BulkVectorMatchesElementEncoding)
+{
+  const std::vector<int> values{1, -2, 3, 1 << 20};
+  std::stringstream bulk;
+  {
+    dbOStream stream((_dbDatabase*) db_, bulk);
+    stream << values;
+    stream.flush();
+  }
+
+  std::stringstream scalar;
+  {
+    dbOStream stream((_dbDatabase*) db_, scalar);
+    stream << (uint) values.size();
+    for (int v : values) {
+      stream << v;
+    }
+    stream.flush();
+  }
+
+  EXPECT_EQ(bulk.str(), scalar.str());
+
+  std::vector<int> read_back;
+  dbIStream stream((_dbDatabase*) db_, bulk);
+  stream >> read_back;
+  EXPECT_EQ(read_back, values);
+  EXPECT_EQ(stream.bytesRead(), bulk.str().size());
+}
+
+TEST_F(OdbStreamTest, ShortReadFails)
+{
+  std::stringstream data;
+  data.write("abc", 3);
+  data.exceptions(std::ios::failbit | std::ios::badbit | std::ios::eofbit);
+
+  dbIStream stream((_dbDatabase*) db_, data);
+  int value;
+  EXPECT_THROW(stream >> value, std::ios_base::failure);
+}
+
+TEST_F(OdbStreamTest, ReadLeavesTrailingData)
+{
+  std::stringstream data;
+  {
+    dbOStream stream((_dbDatabase*) db_, data);
+    stream << 42;
+    stream.flush();
+  }
+  data << "tail";
+
+  {
+    dbIStream stream((_dbDatabase*) db_, data);
+    int value;
+    stream >> value;
+    EXPECT_EQ(value, 42);
+  }
+
+  std::string tail;
+  data >> tail;
+  EXPECT_EQ(tail, "tail");
+}
+
+// Round trips a design with many wires and reports read_db / write_db
+// throughput.
+TEST_F(OdbStreamTest, RoundTripThroughput)
+{
+  populate(20000);
+
+  using Clock = std::chrono::steady_clock;
+  std::stringstream data;
+
+  auto start = Clock::now();
+  db_->write(data);
+  const double write_sec
+      = std::chrono::duration<double>(Clock::now() - start).count();
+
+  dbDatabase* db2 = dbDatabase::create();
+  db2->setLogger(&logger_);
+  start = Clock::now();
+  db2->read(data);
+  const double read_sec
+      = std::chrono::duration<double>(Clock::now() - start).count();
+
+  const double mb = data.str().size() / 1048576.0;
+  logger_.report("write_db {:.1f} MB/s, read_db {:.1f} MB/s",
+                 mb / write_sec,
+                 mb / read_sec);
+
+  EXPECT_FALSE(dbDatabase::diff(db_, db2, nullptr, 2));
+  EXPECT_EQ(db2->getChip()->getBlock()->getNets().size(), 20000);
+  dbDatabase::destroy(db2);
+}
+
+TEST_F(OdbStreamTest, ParallelSectionRead)
+{
+  populate(1000);
+
+  std::stringstream data;
+  db_->write(data);
+
+  dbDatabase* db2 = dbDatabase::create();
+  db2->setLogger(&logger_);
+  db2->setThreadCount(4);
+  db2->read(data);
+
+  EXPECT_FALSE(dbDatabase::diff(db_, db2, nullptr, 2));
+  dbDatabase::destroy(db2);
+}
+
+TEST_F(OdbStreamTest, CompressedRoundTrip)
+{
+  populate(20000);
+  db_->setThreadCount(4);
+
+  std::stringstream raw;
+  db_->write(raw);
+
+  std::stringstream compressed;
+  db_->write(compressed, /*compress=*/true);
+  EXPECT_LT(compressed.str().size(), raw.str().size());
+  logger_.report("compressed {} to {} bytes",
+                 raw.str().size(),
+                 compressed.str().size());
+
+  dbDatabase* db2 = dbDatabase::create();
+  db2->setLogger(&logger_);
+  db2->setThreadCount(4);
+  db2->read(compressed);
+
+  EXPECT_FALSE(dbDatabase::diff(db_, db2, nullptr, 2));
+  dbDatabase::destroy(db2);
+}
+
+TEST_F(OdbStreamTest, TruncatedCompressedFails)
+{
+  populate(100);
+
+  std::stringstream compressed;
+  db_->write(compressed, /*compress=*/true);
+  const std::string data = compressed.str();
+  std::stringstream truncated(data.substr(0, data.size() / 2));
+
+  dbDatabase* db2 = dbDatabase::create();
+  db2->setLogger(&logger_);
+  EXPECT_ANY_THROW(db2->read(truncated));
+  dbDatabase::destroy(db2);
+}
+
+TEST_F(OdbStreamTest, LazyLoading)
+{
+  populate(1000);
+
+  std::stringstream data;
+  db_->write(data);
+
+  dbDatabase* eager = dbDatabase::create();
+  eager->setLogger(&logger_);
+  std::stringstream eager_data(data.str());
+  eager->read(eager_data);
+  std::stringstream eager_out;
+  eager->write(eager_out);
+
+  // Untouched sections are written back out without being decoded.
+  dbDatabase* lazy = dbDatabase::create();
+  lazy->setLogger(&logger_);
+  lazy->setLazyLoading(true);
+  std::stringstream lazy_data(data.str());
+  lazy->read(lazy_data);
+  std::stringstream lazy_out;
+  lazy->write(lazy_out);
+  EXPECT_EQ(lazy_out.str(), eager_out.str());
+
+  dbWire* wire = lazy->getChip()->getBlock()->findNet("n7")->getWire();
+  ASSERT_NE(wire, nullptr);
+  EXPECT_EQ(wire->getLength(),
+            eager->getChip()->getBlock()->findNet("n7")->getWire()->getLength());
+  EXPECT_FALSE(dbDatabase::diff(db_, lazy, nullptr, 2));
+
+  dbDatabase::destroy(eager);
+  dbDatabase::destroy(lazy);
+}
+
+TEST_F(OdbStreamTest, IncrementalCheckpoints)
+{
+  populate(10);
+
+  std::stringstream base;
+  db_->write(base);
+  dbDatabase::beginCheckpoint(block_);
+
+  dbMaster* and2 = db_->findLib("lib1")->findMaster("and2");
+  dbInst* inst = dbInst::create(block_, and2, "eco1");
+  inst->setLocation(5000, 7000);
+  inst->setPlacementStatus(dbPlacementStatus::PLACED);
+  dbNet* net = dbNet::create(block_, "eco_net");
+  inst->findITerm("o")->connect(net);
+  block_->findInst("i3")->setOrient(dbOrientType::MX);
+  std::stringstream delta1;
+  dbDatabase::writeCheckpoint(block_, delta1);
+
+  dbInst::destroy(block_->findInst("i5"));
+  std::stringstream delta2;
+  dbDatabase::writeCheckpoint(block_, delta2);
+  EXPECT_LT(delta1.str().size() + delta2.str().size(), base.str().size());
+
+  dbDatabase* db2 = dbDatabase::create();
+  db2->setLogger(&logger_);
+  db2->read(base);
+  dbBlock* block2 = db2->getChip()->getBlock();
+
+  // Checkpoints must be replayed in order.
+  std::stringstream out_of_order(delta2.str());
+  EXPECT_ANY_THROW(dbDatabase::readCheckpoint(block2, out_of_order));
+
+  EXPECT_TRUE(dbDatabase::isCheckpoint(delta1));
+  dbDatabase::readCheckpoint(block2, delta1);
+  dbDatabase::readCheckpoint(block2, delta2);
+
+  EXPECT_FALSE(dbDatabase::diff(db_, db2, nullptr, 2));
+  dbDatabase::destroy(db2);
+}
+
+TEST_F(OdbStreamTest, CheckpointRejectsWireEdits)
+{
+  populate(4);
+  dbDatabase::beginCheckpoint(block_);
+
+  block_->findInst("i1")->setLocation(9000, 9000);
+  EXPECT_FALSE(dbDatabase::checkpointMissesEdits(block_));
+  std::stringstream delta1;
+  dbDatabase::writeCheckpoint(block_, delta1);
+
+  dbWire::destroy(block_->findNet("n2")->getWire());
+  EXPECT_TRUE(dbDatabase::checkpointMissesEdits(block_));
+  std::stringstream delta2;
+  EXPECT_ANY_THROW(dbDatabase::writeCheckpoint(block_, delta2));
+
+  // A new base clears the wire edits.
+  dbDatabase::beginCheckpoint(block_);
+  EXPECT_FALSE(dbDatabase::checkpointMissesEdits(block_));
+}
+
+TEST_F(OdbStreamTest, CheckpointRejectsUnjournaledEdits)
+{
+  populate(4);
+  dbDatabase::beginCheckpoint(block_);
+
+  dbTechLayer* m1 = db_->getTech()->findLayer("M1");
+  dbObstruction::create(block_, m1, 0, 0, 1000, 1000);
+  EXPECT_TRUE(dbDatabase::checkpointMissesEdits(block_));
+  std::stringstream delta;
+  EXPECT_ANY_THROW(dbDatabase::writeCheckpoint(block_, delta));
+
+  dbDatabase::beginCheckpoint(block_);
+  EXPECT_FALSE(dbDatabase::checkpointMissesEdits(block_));
+  block_->setDieArea(Rect(0, 0, 500000, 500000));
+  EXPECT_TRUE(dbDatabase::checkpointMissesEdits(block_));
+}
+
+TEST_F(OdbStreamTest, ReadsUnsectionedFormat)
+{
+  // design.odb predates sectioned blocks
+  std::ifstream file("data/design.odb", std::ios::binary);
+  file.exceptions(std::ios::failbit | std::ios::badbit | std::ios::eofbit);
+
+  dbDatabase* db2 = dbDatabase::create();
+  db2->setLogger(&logger_);
+  db2->setThreadCount(4);
+  db2->read(file);
+
+  dbBlock* block = db2->getChip()->getBlock();
+  EXPECT_GT(block->getInsts().size(), 0);
+  EXPECT_GT(block->getNets().size(), 0);
+  dbDatabase::destroy(db2);
+}
+
+}  // namespace
+}  // namespace odb
@@ -0,0 +1,192 @@
+#include <chrono>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "env.h"
+#include "gtest/gtest.h"
+#include "helper.h"
+#include "odb/db.h"
+#include "odb/dbWireCodec.h"
+#include "odb/defin.h"
+#include "odb/defout.h"
+#include "utl/Logger.h"
+
+namespace odb {
+namespace {
+
+class OdbDefinTest : public ::testing::Test
+{
+ protected:
+  void SetUp() override
+  {
+    db_ = createDB();
+    block_ = db_->getChip()->getBlock();
+    def_file_ = testTmpPath("results", "TestDefin.def");
+  }
+
+  void TearDown() override { dbDatabase::destroy(db_); }
+
+  dbDatabase* createDB()
+  {
+    dbDatabase* db = createSimpleDB();
+    db->setLogger(&logger_);
+    dbTechLayer::create(db->getTech(), "M1", dbTechLayerType::ROUTING);
+    return db;
+  }
+
+  // Add num_nets routed two-pin nets and a power net.
+  void populate(int num_nets)
+  {
+    dbTechLayer* m1 = db_->getTech()->findLayer("M1");
+    dbMaster* and2 = db_->findLib("lib1")->findMaster("and2");
+    block_->setDieArea(Rect(0, 0, num_nets * 1000, 100000));
+    dbInst* prev = nullptr;
+    for (int i = 0; i < num_nets; ++i) {
+      const std::string suffix = std::to_string(i);
+      dbInst* inst = dbInst::create(block_, and2, ("i" + suffix).c_str());
+      inst->setLocation(i * 1000, (i % 100) * 1000);
+      inst->setPlacementStatus(dbPlacementStatus::PLACED);
+      dbNet* net = dbNet::create(block_, ("n" + suffix).c_str());
+      inst->findITerm("o")->connect(net);
+      if (prev) {
+        prev->findITerm("a")->connect(net);
+      }
+      prev = inst;
+
+      dbWireEncoder encoder;
+      encoder.begin(dbWire::create(net));
+      encoder.newPath(m1, dbWireType::ROUTED);
+      encoder.addPoint(i * 1000, 0);
+      encoder.addPoint(i * 1000, 500);
+      encoder.addPoint(i * 1000 + 300, 500);
+      encoder.end();
+    }
+
+    dbNet* vdd = dbNet::create(block_, "VDD");
+    vdd->setSpecial();
+    vdd->setSigType(dbSigType::POWER);
+    dbSWire* swire = dbSWire::create(vdd, dbWireType::ROUTED);
+    for (int i = 0; i < 100; ++i) {
+      dbSBox::create(swire,
+                     m1,
+                     0,
+                     i * 1000,
+                     num_nets * 1000,
+                     i * 1000 + 100,
+                     dbWireShapeType::STRIPE);
+    }
+  }
+
+  void writeDef(dbBlock* block, const std::string& file)
+  {
+    defout writer(&logger_);
+    ASSERT_TRUE(writer.writeBlock(block, file.c_str()));
+  }
+
+  // Reads def_file_ into a new database with the given thread count.
+  dbDatabase* readDef(int threads)
+  {
+    dbDatabase* db = createDB();
+    db->setThreadCount(threads);
+    dbChip::destroy(db->getChip());
+    std::vector<dbLib*> libs{db->findLib("lib1")};
+    defin reader(db, &logger_);
+    EXPECT_NE(reader.createChip(libs, def_file_.c_str(), db->getTech()),
+              nullptr);
+    return db;
+  }
+
+  static std::string readFile(const std::string& file)
+  {
+    std::ifstream stream(file);
+    std::stringstream text;
+    text << stream.rdbuf();
+    return text.str();
+  }
+
+  utl::Logger logger_;
+  dbDatabase* db_;
+  dbBlock* block_;
+  std::string def_file_;
+};
+
+// Reads a DEF large enough to be split into chunks serially and in
+// parallel and reports the objects read per second.
+TEST_F(OdbDefinTest, ParallelRead)
+{
+  constexpr int num_nets = 20000;
+  populate(num_nets);
+  writeDef(block_, def_file_);
+  const std::string def = readFile(def_file_);
+  const int num_objects = block_->getInsts().size() + block_->getNets().size();
+
+  std::vector<std::string> results;
+  for (int threads : {1, 4}) {
+    auto start = std::chrono::steady_clock::now();
+    dbDatabase* db = readDef(threads);
+    const double sec = std::chrono::duration<double>(
+                           std::chrono::steady_clock::now() - start)
+                           .count();
+    logger_.report("read_def {} threads: {:.0f} objects/s",
+                   threads,
+                   num_objects / sec);
+
+    dbBlock* block = db->getChip()->getBlock();
+    EXPECT_EQ(block->getInsts().size(), num_nets);
+    EXPECT_EQ(block->getNets().size(), num_nets + 1);
+    const std::string file = testTmpPath("results", "TestDefinOut.def");
+    writeDef(block, file);
+    results.push_back(readFile(file));
+    dbDatabase::destroy(db);
+  }
+
+  EXPECT_EQ(results[0], def);
+  EXPECT_EQ(results[1], def);
+}
+
+// Nets formatted on several threads are written in the same order.
+TEST_F(OdbDefinTest, ParallelWrite)
+{
+  populate(20000);
+
+  std::vector<std::string> results;
+  for (int threads : {1, 4}) {
+    db_->setThreadCount(threads);
+    auto start = std::chrono::steady_clock::now();
+    writeDef(block_, def_file_);
+    const double sec = std::chrono::duration<double>(
+                           std::chrono::steady_clock::now() - start)
+                           .count();
+    logger_.report("write_def {} threads: {:.0f} nets/s",
+                   threads,
+                   block_->getNets().size() / sec);
+    results.push_back(readFile(def_file_));
+  }
+
+  EXPECT_EQ(results[0], results[1]);
+}
+
+// A syntax error in a chunk parsed on a worker fails the read.
+TEST_F(OdbDefinTest, ParallelReadError)
+{
+  populate(20000);
+  writeDef(block_, def_file_);
+  std::string def = readFile(def_file_);
+  const size_t pos = def.find("+ USE SIGNAL", def.find("- n15000 "));
+  ASSERT_NE(pos, std::string::npos);
+  def.replace(pos, 12, "+ USE BOGUS");
+  std::ofstream(def_file_) << def;
+
+  dbDatabase* db = createDB();
+  db->setThreadCount(4);
+  dbChip::destroy(db->getChip());
+  std::vector<dbLib*> libs{db->findLib("lib1")};
+  defin reader(db, &logger_);
+  EXPECT_ANY_THROW(reader.createChip(libs, def_file_.c_str(), db->getTech()));
+  dbDatabase::destroy(db);
+}
+
+}  // namespace
+}  // namespace odb
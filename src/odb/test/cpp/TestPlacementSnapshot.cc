@@ -0,0 +1,185 @@
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "helper.h"
+#include "odb/db.h"
+#include "odb/dbBlockCallBackObj.h"
+#include "odb/dbPlacementSnapshot.h"
+#include "odb/dbSpatialIndex.h"
+#include "utl/Logger.h"
+
+namespace odb {
+namespace {
+
+class MoveCounter : public dbBlockCallBackObj
+{
+ public:
+  void inDbPreMoveInst(dbInst*) override { pre_moves++; }
+  void inDbPostMoveInst(dbInst*) override { post_moves++; }
+  void inDbPostMoveInsts(const std::vector<dbInst*>& insts) override
+  {
+    bulk_moves++;
+    dbBlockCallBackObj::inDbPostMoveInsts(insts);
+  }
+
+  int pre_moves = 0;
+  int post_moves = 0;
+  int bulk_moves = 0;
+};
+
+class OdbPlacementSnapshotTest : public ::testing::Test
+{
+ protected:
+  void SetUp() override
+  {
+    db_ = createSimpleDB();
+    db_->setLogger(&logger_);
+    block_ = db_->getChip()->getBlock();
+    dbTechLayer* m1
+        = dbTechLayer::create(db_->getTech(), "M1", dbTechLayerType::ROUTING);
+
+    buf_ = dbMaster::create(db_->findLib("lib1"), "buf");
+    buf_->setWidth(2000);
+    buf_->setHeight(1000);
+    buf_->setType(dbMasterType::CORE);
+    dbMTerm* a = dbMTerm::create(buf_, "A", dbIoType::INPUT);
+    dbBox::create(dbMPin::create(a), m1, 100, 200, 300, 400);
+    dbMTerm* z = dbMTerm::create(buf_, "Z", dbIoType::OUTPUT);
+    dbBox::create(dbMPin::create(z), m1, 1500, 600, 1900, 800);
+    buf_->setFrozen();
+  }
+
+  void TearDown() override { dbDatabase::destroy(db_); }
+
+  dbInst* place(const std::string& name, int x, int y, dbOrientType orient)
+  {
+    dbInst* inst = dbInst::create(block_, buf_, name.c_str());
+    inst->setOrient(orient);
+    inst->setLocation(x, y);
+    inst->setPlacementStatus(dbPlacementStatus::PLACED);
+    return inst;
+  }
+
+  // A chain of buffers driving each other.
+  void populate(int count)
+  {
+    const dbOrientType orients[] = {dbOrientType::R0,
+                                    dbOrientType::MX,
+                                    dbOrientType::R180,
+                                    dbOrientType::MY};
+    dbInst* prev = nullptr;
+    for (int i = 0; i < count; ++i) {
+      dbInst* inst
+          = place("i" + std::to_string(i), i * 2000, 0, orients[i % 4]);
+      if (prev) {
+        dbNet* net = dbNet::create(block_, ("n" + std::to_string(i)).c_str());
+        prev->findITerm("Z")->connect(net);
+        inst->findITerm("A")->connect(net);
+      }
+      prev = inst;
+    }
+    dbNet::create(block_, "unconnected");
+  }
+
+  utl::Logger logger_;
+  dbDatabase* db_;
+  dbBlock* block_;
+  dbMaster* buf_;
+};
+
+TEST_F(OdbPlacementSnapshotTest, Capture)
+{
+  populate(10);
+  dbPlacementSnapshot snapshot;
+  snapshot.capture(block_);
+
+  ASSERT_EQ(snapshot.insts.size(), 10);
+  ASSERT_EQ(snapshot.inst_pin_begin.size(), 11);
+  EXPECT_EQ(snapshot.pins.size(), 20);
+  for (size_t i = 0; i < snapshot.insts.size(); ++i) {
+    dbInst* inst = snapshot.insts[i];
+    const Rect bbox = inst->getBBox()->getBox();
+    EXPECT_EQ(snapshot.inst_x[i], bbox.xMin());
+    EXPECT_EQ(snapshot.inst_y[i], bbox.yMin());
+    EXPECT_EQ(snapshot.inst_width[i], bbox.dx());
+    EXPECT_EQ(snapshot.inst_height[i], bbox.dy());
+    EXPECT_EQ(snapshot.inst_orient[i], inst->getOrient());
+
+    for (int pin = snapshot.inst_pin_begin[i];
+         pin < snapshot.inst_pin_begin[i + 1];
+         ++pin) {
+      dbITerm* iterm = snapshot.pins[pin];
+      EXPECT_EQ(iterm->getInst(), inst);
+      EXPECT_EQ(snapshot.pin_inst[pin], i);
+      const Rect pin_box = iterm->getBBox();
+      EXPECT_EQ(snapshot.inst_x[i] + snapshot.pin_offset_x[pin],
+                pin_box.xCenter());
+      EXPECT_EQ(snapshot.inst_y[i] + snapshot.pin_offset_y[pin],
+                pin_box.yCenter());
+      const int net = snapshot.pin_net[pin];
+      if (net < 0) {
+        EXPECT_EQ(iterm->getNet(), nullptr);
+      } else {
+        EXPECT_EQ(snapshot.nets[net], iterm->getNet());
+      }
+    }
+  }
+
+  // The unconnected net has no pins so it is left out.
+  ASSERT_EQ(snapshot.nets.size(), 9);
+  ASSERT_EQ(snapshot.net_pin_begin.size(), 10);
+  for (size_t n = 0; n < snapshot.nets.size(); ++n) {
+    EXPECT_EQ(snapshot.net_pin_begin[n + 1] - snapshot.net_pin_begin[n], 2);
+    for (int p = snapshot.net_pin_begin[n]; p < snapshot.net_pin_begin[n + 1];
+         ++p) {
+      EXPECT_EQ(snapshot.pins[snapshot.net_pins[p]]->getNet(),
+                snapshot.nets[n]);
+    }
+  }
+}
+
+TEST_F(OdbPlacementSnapshotTest, Commit)
+{
+  populate(10);
+  dbSpatialIndex* index = block_->getSpatialIndex();
+  EXPECT_EQ(index->findInsts(Rect(100000, 0, 110000, 1000)).size(), 0);
+
+  MoveCounter counter;
+  counter.addOwner(block_);
+
+  dbPlacementSnapshot snapshot;
+  snapshot.capture(block_);
+  EXPECT_EQ(snapshot.commit(), 0);
+
+  for (int i : {1, 2, 7}) {
+    snapshot.inst_x[i] = 100000 + i * 2000;
+    snapshot.inst_y[i] = 500;
+  }
+  EXPECT_EQ(snapshot.commit(), 3);
+  EXPECT_EQ(counter.bulk_moves, 1);
+  EXPECT_EQ(counter.pre_moves, 3);
+  EXPECT_EQ(counter.post_moves, 3);
+
+  for (int i : {1, 2, 7}) {
+    dbInst* inst = snapshot.insts[i];
+    EXPECT_EQ(inst->getLocation(), Point(100000 + i * 2000, 500));
+  }
+  EXPECT_EQ(index->findInsts(Rect(100000, 0, 120000, 1000)).size(), 3);
+
+  // Matches moving the instances one at a time.
+  dbPlacementSnapshot again;
+  again.capture(block_);
+  EXPECT_EQ(again.inst_x, snapshot.inst_x);
+  EXPECT_EQ(again.inst_y, snapshot.inst_y);
+  EXPECT_EQ(again.pin_offset_x, snapshot.pin_offset_x);
+  EXPECT_EQ(snapshot.commit(), 0);
+
+  snapshot.insts[0]->setPlacementStatus(dbPlacementStatus::FIRM);
+  snapshot.inst_x[0] += 10;
+  EXPECT_ANY_THROW(snapshot.commit());
+  counter.removeOwner();
+}
+
+}  // namespace
+}  // namespace odb
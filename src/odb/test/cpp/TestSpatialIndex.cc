@@ -0,0 +1,149 @@
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "helper.h"
+#include "odb/db.h"
+#include "odb/dbSpatialIndex.h"
+#include "odb/dbWireCodec.h"
+#include "utl/Logger.h"
+
+namespace odb {
+namespace {
+
+class OdbSpatialIndexTest : public ::testing::Test
+{
+ protected:
+  void SetUp() override
+  {
+    db_ = createSimpleDB();
+    db_->setLogger(&logger_);
+    block_ = db_->getChip()->getBlock();
+    m1_ = dbTechLayer::create(db_->getTech(), "M1", dbTechLayerType::ROUTING);
+    m1_->setWidth(100);
+    and2_ = db_->findLib("lib1")->findMaster("and2");
+  }
+
+  void TearDown() override { dbDatabase::destroy(db_); }
+
+  dbInst* place(const char* name, int x, int y)
+  {
+    dbInst* inst = dbInst::create(block_, and2_, name);
+    inst->setLocation(x, y);
+    inst->setPlacementStatus(dbPlacementStatus::PLACED);
+    return inst;
+  }
+
+  void route(dbNet* net, int x, int y0, int y1)
+  {
+    dbWire* wire = net->getWire();
+    if (wire == nullptr) {
+      wire = dbWire::create(net);
+    }
+    dbWireEncoder encoder;
+    encoder.begin(wire);
+    encoder.newPath(m1_, dbWireType::ROUTED);
+    encoder.addPoint(x, y0);
+    encoder.addPoint(x, y1);
+    encoder.end();
+  }
+
+  static bool contains(const std::vector<dbInst*>& insts, dbInst* inst)
+  {
+    return std::find(insts.begin(), insts.end(), inst) != insts.end();
+  }
+
+  utl::Logger logger_;
+  dbDatabase* db_;
+  dbBlock* block_;
+  dbTechLayer* m1_;
+  dbMaster* and2_;
+};
+
+TEST_F(OdbSpatialIndexTest, Insts)
+{
+  dbInst* i1 = place("i1", 0, 0);
+  dbInst* i2 = place("i2", 10000, 0);
+  dbInst::create(block_, and2_, "unplaced");
+
+  dbSpatialIndex* index = block_->getSpatialIndex();
+  EXPECT_EQ(index, block_->getSpatialIndex());
+
+  auto found = index->findInsts(Rect(0, 0, 20000, 20000));
+  EXPECT_EQ(found.size(), 2);
+
+  found = index->findInsts(Rect(9000, 0, 9500, 500));
+  EXPECT_TRUE(found.empty());
+
+  // Edits after the index is built are picked up from the callbacks.
+  i2->setLocation(9000, 0);
+  found = index->findInsts(Rect(9000, 0, 9500, 500));
+  ASSERT_EQ(found.size(), 1);
+  EXPECT_EQ(found[0], i2);
+
+  i1->setPlacementStatus(dbPlacementStatus::NONE);
+  EXPECT_FALSE(contains(index->findInsts(Rect(0, 0, 500, 500)), i1));
+  i1->setPlacementStatus(dbPlacementStatus::PLACED);
+  EXPECT_TRUE(contains(index->findInsts(Rect(0, 0, 500, 500)), i1));
+
+  dbInst* i3 = place("i3", 0, 5000);
+  EXPECT_TRUE(contains(index->findInsts(Rect(0, 5000, 500, 5500)), i3));
+
+  dbInst::destroy(i1);
+  EXPECT_TRUE(index->findInsts(Rect(0, 0, 500, 500)).empty());
+}
+
+TEST_F(OdbSpatialIndexTest, SBoxes)
+{
+  dbNet* vdd = dbNet::create(block_, "VDD");
+  dbSWire* swire = dbSWire::create(vdd, dbWireType::ROUTED);
+  dbSBox* stripe = dbSBox::create(
+      swire, m1_, 0, 0, 10000, 200, dbWireShapeType::STRIPE);
+
+  dbSpatialIndex* index = block_->getSpatialIndex();
+  auto found = index->findSBoxes(m1_, Rect(5000, 100, 5100, 150));
+  ASSERT_EQ(found.size(), 1);
+  EXPECT_EQ(found[0], stripe);
+  EXPECT_TRUE(
+      index->findSBoxes(db_->getTech()->findLayer("L1"), Rect(0, 0, 100, 100))
+          .empty());
+
+  dbSBox* rail = dbSBox::create(
+      swire, m1_, 0, 1000, 10000, 1100, dbWireShapeType::FOLLOWPIN);
+  found = index->findSBoxes(m1_, Rect(0, 0, 10000, 10000));
+  EXPECT_EQ(found.size(), 2);
+
+  dbSBox::destroy(rail);
+  found = index->findSBoxes(m1_, Rect(0, 0, 10000, 10000));
+  EXPECT_EQ(found.size(), 1);
+
+  dbSWire::destroy(swire);
+  EXPECT_TRUE(index->findSBoxes(m1_, Rect(0, 0, 10000, 10000)).empty());
+}
+
+TEST_F(OdbSpatialIndexTest, Wires)
+{
+  dbNet* n1 = dbNet::create(block_, "n1");
+  dbNet* n2 = dbNet::create(block_, "n2");
+  route(n1, 1000, 0, 5000);
+  route(n2, 3000, 0, 5000);
+
+  dbSpatialIndex* index = block_->getSpatialIndex();
+  auto found = index->findWireShapes(m1_, Rect(900, 2000, 1100, 2100));
+  ASSERT_EQ(found.size(), 1);
+  EXPECT_EQ(found[0].second, n1);
+
+  // Re-encoding a wire replaces its shapes.
+  route(n1, 2000, 0, 5000);
+  EXPECT_TRUE(index->findWireShapes(m1_, Rect(900, 2000, 1100, 2100)).empty());
+  found = index->findWireShapes(m1_, Rect(1900, 2000, 2100, 2100));
+  ASSERT_EQ(found.size(), 1);
+  EXPECT_EQ(found[0].second, n1);
+
+  dbWire::destroy(n2->getWire());
+  EXPECT_EQ(index->findWireShapes(m1_, Rect(0, 0, 5000, 5000)).size(), 1);
+}
+
+}  // namespace
+}  // namespace odb
@@ -0,0 +1,183 @@
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "helper.h"
+#include "odb/db.h"
+#include "odb/dbShape.h"
+#include "odb/dbWireCodec.h"
+#include "odb/dbWireShapes.h"
+#include "utl/Logger.h"
+
+namespace odb {
+namespace {
+
+class OdbWireShapesTest : public ::testing::Test
+{
+ protected:
+  void SetUp() override
+  {
+    db_ = createSimpleDB();
+    db_->setLogger(&logger_);
+    block_ = db_->getChip()->getBlock();
+    dbTech* tech = db_->getTech();
+    m1_ = dbTechLayer::create(tech, "M1", dbTechLayerType::ROUTING);
+    m1_->setWidth(100);
+    m1_->setDirection(dbTechLayerDir::HORIZONTAL);
+    dbTechLayer* v1 = dbTechLayer::create(tech, "V1", dbTechLayerType::CUT);
+    m2_ = dbTechLayer::create(tech, "M2", dbTechLayerType::ROUTING);
+    m2_->setWidth(140);
+    m2_->setWrongWayWidth(200);
+    m2_->setDirection(dbTechLayerDir::VERTICAL);
+
+    tech_via_ = dbTechVia::create(tech, "V12");
+    dbBox::create(tech_via_, m1_, -70, -50, 70, 50);
+    dbBox::create(tech_via_, v1, -50, -50, 50, 50);
+    dbBox::create(tech_via_, m2_, -70, -70, 70, 70);
+
+    block_via_ = dbVia::create(block_, "V12_block");
+    dbBox::create(block_via_, m1_, -100, -50, 100, 50);
+    dbBox::create(block_via_, v1, -50, -50, 50, 50);
+    dbBox::create(block_via_, m2_, -70, -100, 70, 100);
+  }
+
+  void TearDown() override { dbDatabase::destroy(db_); }
+
+  // A wire using every kind of opcode the shape iterator handles.
+  dbWire* createWire(const char* name, int offset)
+  {
+    dbNet* net = dbNet::create(block_, name);
+    dbWire* wire = dbWire::create(net);
+    dbWireEncoder encoder;
+    encoder.begin(wire);
+    encoder.newPath(m1_, dbWireType::ROUTED);
+    const int start = encoder.addPoint(offset, 0, 20);
+    encoder.addPoint(offset + 1000, 0);
+    encoder.addTechVia(tech_via_);
+    const int corner = encoder.addPoint(offset + 1000, 2000);
+    encoder.addPoint(offset + 1000, 2000, 0);
+    encoder.addPoint(offset + 1000, 3000);
+    encoder.addVia(block_via_);
+    encoder.addPoint(offset + 3000, 3000);
+    encoder.addRect(-10, -10, 10, 10);
+    encoder.newPath(start, dbWireType::ROUTED);
+    encoder.addPoint(offset, -500);
+    encoder.newPathExt(corner, 30, dbWireType::ROUTED);
+    encoder.addPoint(offset + 1500, 2000);
+    encoder.newPathShort(start, m2_, dbWireType::ROUTED);
+    encoder.addPoint(offset, 700);
+    encoder.end();
+    return wire;
+  }
+
+  static void iterate(dbWire* wire,
+                      std::vector<dbShape>& shapes,
+                      std::vector<int>& shape_ids)
+  {
+    dbWireShapeItr itr;
+    dbShape shape;
+    for (itr.begin(wire); itr.next(shape);) {
+      shapes.push_back(shape);
+      shape_ids.push_back(itr.getShapeId());
+    }
+  }
+
+  utl::Logger logger_;
+  dbDatabase* db_;
+  dbBlock* block_;
+  dbTechLayer* m1_;
+  dbTechLayer* m2_;
+  dbTechVia* tech_via_;
+  dbVia* block_via_;
+};
+
+TEST_F(OdbWireShapesTest, MatchesShapeItr)
+{
+  dbWire* wire = createWire("n1", 0);
+
+  std::vector<dbShape> expected;
+  std::vector<int> expected_ids;
+  iterate(wire, expected, expected_ids);
+  ASSERT_GT(expected.size(), 5);
+
+  std::vector<dbShape> shapes;
+  std::vector<int> shape_ids;
+  dbWireShapeDecoder decoder(block_);
+  decoder.decode(wire, shapes, &shape_ids);
+
+  ASSERT_EQ(shapes.size(), expected.size());
+  for (size_t i = 0; i < shapes.size(); ++i) {
+    EXPECT_TRUE(shapes[i] == expected[i]) << "shape " << i;
+  }
+  EXPECT_EQ(shape_ids, expected_ids);
+}
+
+// Decodes many wires in a batch and reports the speedup over the iterator.
+TEST_F(OdbWireShapesTest, BatchDecode)
+{
+  constexpr int num_nets = 20000;
+  std::vector<dbNet*> nets;
+  for (int i = 0; i < num_nets; ++i) {
+    const std::string name = "n" + std::to_string(i);
+    nets.push_back(createWire(name.c_str(), i * 10000)->getNet());
+  }
+  nets.push_back(dbNet::create(block_, "unrouted"));
+
+  using Clock = std::chrono::steady_clock;
+  auto start = Clock::now();
+  std::vector<std::vector<dbShape>> expected(nets.size());
+  std::vector<int> ids;
+  for (size_t i = 0; i < nets.size(); ++i) {
+    if (dbWire* wire = nets[i]->getWire()) {
+      iterate(wire, expected[i], ids);
+    }
+  }
+  const double itr_sec
+      = std::chrono::duration<double>(Clock::now() - start).count();
+
+  db_->setThreadCount(4);
+  start = Clock::now();
+  std::vector<std::vector<dbShape>> shapes;
+  dbWireShapeDecoder::decode(nets, shapes);
+  const double batch_sec
+      = std::chrono::duration<double>(Clock::now() - start).count();
+  logger_.report("dbWireShapeItr {:.3f}s, batch decode {:.3f}s",
+                 itr_sec,
+                 batch_sec);
+
+  ASSERT_EQ(shapes.size(), nets.size());
+  EXPECT_TRUE(shapes.back().empty());
+  for (size_t i = 0; i < nets.size(); ++i) {
+    ASSERT_EQ(shapes[i].size(), expected[i].size());
+    for (size_t j = 0; j < shapes[i].size(); ++j) {
+      EXPECT_TRUE(shapes[i][j] == expected[i][j]);
+    }
+  }
+}
+
+TEST_F(OdbWireShapesTest, CacheIsInvalidated)
+{
+  dbWire* wire = createWire("n1", 0);
+  dbWireShapeCache cache(block_);
+  const size_t count = cache.getShapes(wire).size();
+  EXPECT_EQ(&cache.getShapes(wire), &cache.getShapes(wire));
+
+  dbWire* other = createWire("n2", 0);
+  wire->append(other);
+  EXPECT_EQ(cache.getShapes(wire).size(), 2 * count);
+
+  dbWireEncoder encoder;
+  encoder.begin(wire);
+  encoder.newPath(m1_, dbWireType::ROUTED);
+  encoder.addPoint(0, 0);
+  encoder.addPoint(100, 0);
+  encoder.end();
+  EXPECT_EQ(cache.getShapes(wire).size(), 1);
+
+  cache.prefetch({other->getNet()});
+  EXPECT_EQ(cache.getShapes(other).size(), count);
+}
+
+}  // namespace
+}  // namespace odb